@@ -35,6 +35,8 @@ CXXFLAGS="-std=c++23 -Wall -Wextra -g -O0 -pthread"
 
 # 源文件
 SOURCES="../../zerocp_daemon/memory/source/mempool_manager.cpp \
+../../zerocp_daemon/memory/source/chunk_magazine.cpp \
+../../zerocp_daemon/memory/source/tlsf_heap.cpp \
 ../../zerocp_daemon/memory/source/mempool.cpp \
 ../../zerocp_daemon/memory/source/mempool_allocator.cpp \
 ../../zerocp_daemon/memory/source/posixshm_provider.cpp \
@@ -82,10 +82,10 @@ bool readAndVerifyChunkFromPool(MemPoolManager* manager, uint32_t poolId, uint32
     std::cout << "  - 引用计数: " << targetChunk->m_refCount.load() << std::endl;
     
     // 获取 ChunkHeader
-    ChunkHeader* header = targetChunk->m_chunkHeader.get();
+    ChunkHeader* header = manager->getChunkHeader(targetChunk);
     if (!header)
     {
-        std::cout << "  ✗ 无法获取 ChunkHeader（RelativePointer 解析失败）" << std::endl;
+        std::cout << "  ✗ 无法获取 ChunkHeader（索引解析失败）" << std::endl;
         return false;
     }
     
@@ -77,7 +77,7 @@ bool writeTestDataToPool(MemPoolManager* manager, uint32_t poolId, uint32_t sequ
     std::cout << "    ChunkManager 索引: " << chunk->m_chunkManagerIndex << std::endl;
     
     // 获取 ChunkHeader
-    ChunkHeader* header = chunk->m_chunkHeader.get();
+    ChunkHeader* header = manager->getChunkHeader(chunk);
     if (!header)
     {
         std::cout << "  ✗ 无法获取 ChunkHeader" << std::endl;
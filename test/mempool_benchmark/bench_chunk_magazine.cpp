@@ -0,0 +1,123 @@
+// 线程弹匣竞争基准
+// 多个线程并发 getChunk/releaseChunk，对比启用/禁用线程弹匣时的
+// 每次分配耗时（ns/alloc）和空闲链表栈顶上的 CAS 重试次数
+//
+// 用法: ./bench_chunk_magazine [线程数=16] [每线程迭代次数=200000]
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "mpmclockfreelist.hpp"
+#include "logging.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+
+constexpr uint64_t kBurstSize = 8U;      // 每轮持有的 chunk 数（模拟发布者的 in-flight 消息）
+constexpr uint64_t kChunkSize = 64U;
+
+struct RunResult
+{
+    double nsPerAlloc{0.0};
+    uint64_t casRetries{0U};
+    uint64_t failures{0U};
+};
+
+RunResult run(MemPoolManager& manager, uint64_t threadCount, uint64_t iterations, bool useMagazines)
+{
+    MemPoolManager::setThreadMagazinesEnabled(useMagazines);
+
+    std::atomic<bool> start{false};
+    std::atomic<uint64_t> totalRetries{0U};
+    std::atomic<uint64_t> totalFailures{0U};
+    std::vector<std::thread> threads;
+
+    for (uint64_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&]() {
+            ChunkManager* held[kBurstSize];
+            uint64_t failures = 0U;
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            const uint64_t retriesBefore = ZeroCP::Concurrent::MPMC_LockFree_List::casRetriesOfThisThread();
+            for (uint64_t i = 0; i < iterations; i += kBurstSize)
+            {
+                for (auto& chunk : held)
+                {
+                    chunk = manager.getChunk(kChunkSize);
+                    failures += (chunk == nullptr) ? 1U : 0U;
+                }
+                for (auto* chunk : held)
+                {
+                    if (chunk != nullptr)
+                    {
+                        manager.releaseChunk(chunk);
+                    }
+                }
+            }
+            manager.flushThreadMagazines();
+
+            totalRetries += ZeroCP::Concurrent::MPMC_LockFree_List::casRetriesOfThisThread() - retriesBefore;
+            totalFailures += failures;
+        });
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    RunResult result;
+    result.nsPerAlloc = elapsed / static_cast<double>(threadCount * iterations);
+    result.casRetries = totalRetries.load();
+    result.failures = totalFailures.load();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const uint64_t threadCount = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 16U;
+    const uint64_t iterations = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 200000U;
+
+    // 热路径上的 Info 日志会掩盖分配本身的开销
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+
+    MemPoolConfig config;
+    config.setdefaultPool();
+    if (!MemPoolManager::createSharedInstance(config))
+    {
+        std::fprintf(stderr, "Failed to create MemPoolManager\n");
+        return 1;
+    }
+    auto* manager = MemPoolManager::getInstanceIfInitialized();
+
+    std::printf("threads=%lu iterations/thread=%lu burst=%lu\n", threadCount, iterations, kBurstSize);
+    std::printf("%-12s %12s %14s %10s\n", "mode", "ns/alloc", "CAS retries", "failures");
+
+    const RunResult direct = run(*manager, threadCount, iterations, false);
+    std::printf("%-12s %12.1f %14lu %10lu\n", "direct", direct.nsPerAlloc, direct.casRetries, direct.failures);
+
+    const RunResult magazine = run(*manager, threadCount, iterations, true);
+    std::printf("%-12s %12.1f %14lu %10lu\n", "magazine", magazine.nsPerAlloc, magazine.casRetries, magazine.failures);
+
+    MemPoolManager::setThreadMagazinesEnabled(false);
+    manager->printAllPoolStats();
+    MemPoolManager::destroySharedInstance();
+    return 0;
+}
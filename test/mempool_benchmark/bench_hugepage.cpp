@@ -0,0 +1,210 @@
+// 数据区大页基准
+// 分别以普通页和大页创建数据区，先顺序首次访问所有 chunk（缺页开销），
+// 再以随机顺序读取每个 chunk 中的一个 cache line（TLB 开销），对比两种页类型
+//
+// 用法: ./bench_hugepage [大页类型 2m|1g|thp=2m] [数据区 MiB=256] [随机访问轮数=8]
+// 显式大页需要 hugetlbfs 挂载并预留大页，例如：
+//   echo 256 > /proc/sys/vm/nr_hugepages   (2 MiB 页挂载在 /dev/hugepages)
+// 不可用时 MemPoolManager 会回退到透明大页，报告中的 pages 一列给出实际结果
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "chunk_header.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+
+constexpr uint64_t kChunkSize = 64U * 1024U;
+constexpr uint64_t kCacheLine = 64U;
+
+const char* modeName(HugePageMode mode)
+{
+    switch (mode)
+    {
+    case HugePageMode::NONE:
+        return "4k";
+    case HugePageMode::TRANSPARENT:
+        return "thp";
+    case HugePageMode::EXPLICIT_2M:
+        return "2m";
+    case HugePageMode::EXPLICIT_1G:
+        return "1g";
+    }
+    return "?";
+}
+
+/// @brief 从 /proc/self/smaps 读取包含 address 的映射中以 PMD（大页）映射的 KiB 数
+uint64_t hugeMappedKiB(const void* address)
+{
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool inMapping = false;
+    uint64_t hugeKiB = 0U;
+    const auto target = reinterpret_cast<uintptr_t>(address);
+    while (std::getline(smaps, line))
+    {
+        uintptr_t begin = 0U;
+        uintptr_t end = 0U;
+        char dash = 0;
+        std::istringstream header(line);
+        if (header >> std::hex >> begin >> dash >> end && dash == '-')
+        {
+            inMapping = (target >= begin && target < end);
+            continue;
+        }
+        if (!inMapping)
+        {
+            continue;
+        }
+        uint64_t value = 0U;
+        if (std::sscanf(line.c_str(), "ShmemPmdMapped: %lu kB", &value) == 1
+            || std::sscanf(line.c_str(), "FilePmdMapped: %lu kB", &value) == 1
+            || std::sscanf(line.c_str(), "Private_Hugetlb: %lu kB", &value) == 1
+            || std::sscanf(line.c_str(), "Shared_Hugetlb: %lu kB", &value) == 1)
+        {
+            hugeKiB += value;
+        }
+    }
+    return hugeKiB;
+}
+
+struct RunResult
+{
+    HugePageMode mode{HugePageMode::NONE};
+    uint64_t pageSize{0U};
+    uint64_t hugeKiB{0U};
+    double firstTouchNsPerPage4k{0.0};
+    double nsPerAccess{0.0};
+};
+
+bool run(HugePageMode requested, uint64_t segmentMiB, uint64_t passes, RunResult& result)
+{
+    const uint32_t chunkCount = static_cast<uint32_t>(segmentMiB * 1024U * 1024U / kChunkSize);
+    MemPoolConfig config;
+    config.addMemPoolEntry(kChunkSize, chunkCount);
+    config.m_hugePageMode = requested;
+    if (!MemPoolManager::createSharedInstance(config))
+    {
+        std::fprintf(stderr, "Failed to create MemPoolManager (%s)\n", modeName(requested));
+        return false;
+    }
+    auto* manager = MemPoolManager::getInstanceIfInitialized();
+
+    // 分配所有 chunk，取得各自的 payload 地址
+    std::vector<ChunkManager*> chunks(chunkCount);
+    uint32_t allocated = 0U;
+    while (allocated < chunkCount)
+    {
+        const uint32_t got = manager->getChunks(kChunkSize - 64U, chunkCount - allocated, chunks.data() + allocated);
+        if (got == 0U)
+        {
+            break;
+        }
+        allocated += got;
+    }
+    chunks.resize(allocated);
+    std::vector<char*> payloads(allocated);
+    for (uint32_t i = 0U; i < allocated; ++i)
+    {
+        ChunkHeader* header = manager->getChunkHeader(chunks[i]);
+        payloads[i] = reinterpret_cast<char*>(header) + header->m_userPayloadOffset;
+    }
+
+    // 1. 顺序首次访问：每 4 KiB 写一个字节，触发缺页
+    auto begin = std::chrono::steady_clock::now();
+    for (char* payload : payloads)
+    {
+        for (uint64_t offset = 0U; offset + 64U < kChunkSize; offset += 4096U)
+        {
+            payload[offset] = 1;
+        }
+    }
+    const double touchNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    // 2. 随机访问：每次落在不同 chunk 的随机 cache line 上，工作集远大于 4 KiB 页的 TLB 覆盖范围
+    std::mt19937_64 rng(42U);
+    std::vector<uint32_t> order(allocated);
+    std::iota(order.begin(), order.end(), 0U);
+    std::vector<uint32_t> lines(allocated);
+    for (auto& line : lines)
+    {
+        line = static_cast<uint32_t>(rng() % ((kChunkSize - 64U) / kCacheLine));
+    }
+    uint64_t checksum = 0U;
+    begin = std::chrono::steady_clock::now();
+    for (uint64_t pass = 0U; pass < passes; ++pass)
+    {
+        std::shuffle(order.begin(), order.end(), rng);
+        for (uint32_t index : order)
+        {
+            checksum += static_cast<uint64_t>(payloads[index][lines[index] * kCacheLine]);
+        }
+    }
+    const double accessNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    result.mode = manager->getChunkHugePageMode();
+    result.pageSize = manager->getChunkPageSize();
+    result.hugeKiB = payloads.empty() ? 0U : hugeMappedKiB(payloads.front());
+    result.firstTouchNsPerPage4k = touchNs / static_cast<double>(allocated * (kChunkSize / 4096U));
+    result.nsPerAccess = accessNs / static_cast<double>(passes * allocated);
+    if (checksum == 0U)
+    {
+        std::printf("(checksum 0)\n");
+    }
+
+    manager->releaseChunks(chunks);
+    MemPoolManager::destroySharedInstance();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const char* requestedName = (argc > 1) ? argv[1] : "2m";
+    const uint64_t segmentMiB = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 256U;
+    const uint64_t passes = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 8U;
+
+    HugePageMode requested = HugePageMode::EXPLICIT_2M;
+    if (std::strcmp(requestedName, "1g") == 0)
+    {
+        requested = HugePageMode::EXPLICIT_1G;
+    }
+    else if (std::strcmp(requestedName, "thp") == 0)
+    {
+        requested = HugePageMode::TRANSPARENT;
+    }
+
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+
+    std::printf("segment=%lu MiB chunk=%lu KiB passes=%lu\n", segmentMiB, kChunkSize / 1024U, passes);
+    std::printf("%-10s %-6s %12s %12s %16s %12s\n",
+                "requested", "pages", "page size", "huge KiB", "touch ns/4KiB", "ns/access");
+
+    for (HugePageMode mode : {HugePageMode::NONE, requested})
+    {
+        RunResult result;
+        if (!run(mode, segmentMiB, passes, result))
+        {
+            return 1;
+        }
+        std::printf("%-10s %-6s %12lu %12lu %16.1f %12.1f\n", modeName(mode), modeName(result.mode),
+                    result.pageSize, result.hugeKiB, result.firstTouchNsPerPage4k, result.nsPerAccess);
+    }
+    return 0;
+}
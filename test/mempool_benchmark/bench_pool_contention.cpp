@@ -0,0 +1,143 @@
+// 池间竞争基准
+// N 个线程同时 getChunk/releaseChunk，每个线程固定使用一个尺寸级别（线程 t 使用池 t % 池数），
+// 关闭线程弹匣，直接测空闲链表和用量计数所在 cache line 的竞争：
+// 1. same-class：所有线程使用同一个池（真共享，作为参照）
+// 2. per-class：每个线程使用自己的池，维护已使用计数
+// 3. per-class derived：同上，已使用计数由按 CPU 分片的遥测计数推算（MemPoolConfig::m_deriveUsedCount）
+// 池的热字段各自独占 cache line 时，per-class 应接近单线程的耗时，且远低于 same-class
+//
+// 用法: ./bench_pool_contention [线程数=8] [每线程迭代次数=2000000]
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "mempool.hpp"
+#include "mpmclockfreelist.hpp"
+#include "logging.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+
+constexpr uint32_t kPoolCount = 8U;
+constexpr uint32_t kChunksPerPool = 4096U;
+constexpr uint64_t kBurstSize = 4U;      // 每轮持有的 chunk 数
+
+struct RunResult
+{
+    double nsPerAlloc{0.0};
+    uint64_t casRetries{0U};
+    uint64_t failures{0U};
+};
+
+/// @brief 8 个尺寸级别：64B, 128B, ..., 8KiB
+MemPoolConfig makeConfig(bool deriveUsedCount)
+{
+    MemPoolConfig config;
+    for (uint32_t i = 0U; i < kPoolCount; ++i)
+    {
+        config.addMemPoolEntry(uint64_t{64U} << i, kChunksPerPool);
+    }
+    config.m_deriveUsedCount = deriveUsedCount;
+    return config;
+}
+
+RunResult run(uint64_t threadCount, uint64_t iterations, bool sameClass, bool deriveUsedCount)
+{
+    if (!MemPoolManager::createSharedInstance(makeConfig(deriveUsedCount)))
+    {
+        std::fprintf(stderr, "Failed to create MemPoolManager\n");
+        std::exit(1);
+    }
+    MemPoolManager& manager = *MemPoolManager::getInstanceIfInitialized();
+
+    std::atomic<bool> start{false};
+    std::atomic<uint64_t> totalRetries{0U};
+    std::atomic<uint64_t> totalFailures{0U};
+    std::vector<std::thread> threads;
+
+    for (uint64_t t = 0; t < threadCount; ++t)
+    {
+        const uint64_t chunkSize = uint64_t{64U} << (sameClass ? 0U : t % kPoolCount);
+        threads.emplace_back([&, chunkSize]() {
+            ChunkManager* held[kBurstSize];
+            uint64_t failures = 0U;
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            const uint64_t retriesBefore = ZeroCP::Concurrent::MPMC_LockFree_List::casRetriesOfThisThread();
+            for (uint64_t i = 0; i < iterations; i += kBurstSize)
+            {
+                for (auto& chunk : held)
+                {
+                    chunk = manager.getChunk(chunkSize);
+                    failures += (chunk == nullptr) ? 1U : 0U;
+                }
+                for (auto* chunk : held)
+                {
+                    if (chunk != nullptr)
+                    {
+                        manager.releaseChunk(chunk);
+                    }
+                }
+            }
+
+            totalRetries += ZeroCP::Concurrent::MPMC_LockFree_List::casRetriesOfThisThread() - retriesBefore;
+            totalFailures += failures;
+        });
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    RunResult result;
+    result.nsPerAlloc = elapsed / static_cast<double>(threadCount * iterations);
+    result.casRetries = totalRetries.load();
+    result.failures = totalFailures.load();
+
+    MemPoolManager::destroySharedInstance();
+    return result;
+}
+
+void print(const char* mode, const RunResult& result)
+{
+    std::printf("%-20s %12.1f %14lu %10lu\n", mode, result.nsPerAlloc, result.casRetries, result.failures);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const uint64_t threadCount = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 8U;
+    const uint64_t iterations = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000000U;
+
+    // 热路径上的 Info 日志会掩盖分配本身的开销
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+    MemPoolManager::setThreadMagazinesEnabled(false);
+
+    std::printf("threads=%lu iterations/thread=%lu pools=%u burst=%lu hardware threads=%u\n",
+                threadCount, iterations, kPoolCount, kBurstSize, std::thread::hardware_concurrency());
+    std::printf("sizeof(MemPool)=%zu alignof(MemPool)=%zu sizeof(MPMC_LockFree_List)=%zu\n",
+                sizeof(MemPool), alignof(MemPool), sizeof(ZeroCP::Concurrent::MPMC_LockFree_List));
+    std::printf("%-20s %12s %14s %10s\n", "mode", "ns/alloc", "CAS retries", "failures");
+
+    print("single thread", run(1U, iterations, false, false));
+    print("same-class", run(threadCount, iterations, true, false));
+    print("per-class", run(threadCount, iterations, false, false));
+    print("per-class derived", run(threadCount, iterations, false, true));
+    return 0;
+}
@@ -0,0 +1,188 @@
+// RelativePointer 地址转换开销基准
+// 1. 指针追逐（最坏情况）：同一组节点分别用原生指针和 RelativePointer 串成环，按随机顺序追逐。
+//    每一步都依赖上一步的结果，RelativePointer 多出的一次注册表读取（L1 命中）无法与其他工作重叠
+// 2. 发布/接收循环：发布端 getChunk 写入 payload，把 payload 位置放进消息描述符，
+//    接收端从描述符取出 payload 读取后释放。描述符分别保存
+//    a) 原生指针（相当于要求所有进程把数据区映射到同一地址）
+//    b) RelativePointer（位置无关）
+//    两者只在转换上不同，对比每个循环的耗时
+//
+// 用法: ./bench_relative_pointer [节点数=65536] [追逐步数=20000000] [发布/接收循环数=2000000]
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "chunk_header.hpp"
+#include "relative_pointer.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+using ZeroCP::RelativePointer;
+using ZeroCP::CHUNK_POOL_ID;
+
+namespace
+{
+
+constexpr uint64_t kChunkSize = 128U;
+
+struct Node
+{
+    Node* m_rawNext{nullptr};
+    RelativePointer<Node> m_relativeNext;
+    uint64_t m_payload{0U};
+};
+
+constexpr int kRounds = 3;   // 两种变体交替运行，各取最小值，消除先后顺序和预热的影响
+
+template<typename Step>
+double nsPerStep(uint64_t steps, Step&& step)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    step(steps);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count()
+           / static_cast<double>(steps);
+}
+
+template<typename RawStep, typename RelativeStep>
+void measurePair(uint64_t steps, RawStep&& rawStep, RelativeStep&& relativeStep, double& rawNs, double& relativeNs)
+{
+    rawNs = 1e30;
+    relativeNs = 1e30;
+    for (int round = 0; round < kRounds; ++round)
+    {
+        rawNs = std::min(rawNs, nsPerStep(steps, rawStep));
+        relativeNs = std::min(relativeNs, nsPerStep(steps, relativeStep));
+    }
+}
+
+char* payloadOf(MemPoolManager& manager, const ChunkManager* chunk)
+{
+    ChunkHeader* header = manager.getChunkHeader(chunk);
+    return reinterpret_cast<char*>(header) + header->m_userPayloadOffset;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const uint32_t nodeCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 65536U;
+    const uint64_t chaseSteps = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 20000000U;
+    const uint64_t cycles = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 2000000U;
+
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kChunkSize, nodeCount + 1U);
+    if (!MemPoolManager::createSharedInstance(config))
+    {
+        std::fprintf(stderr, "Failed to create MemPoolManager\n");
+        return 1;
+    }
+    auto* manager = MemPoolManager::getInstanceIfInitialized();
+
+    // ==================== 1. 指针追逐 ====================
+    std::vector<ChunkManager*> chunks(nodeCount);
+    std::vector<Node*> nodes(nodeCount);
+    for (uint32_t i = 0U; i < nodeCount; ++i)
+    {
+        chunks[i] = manager->getChunk(sizeof(Node), alignof(Node));
+        nodes[i] = new (payloadOf(*manager, chunks[i])) Node();
+        nodes[i]->m_payload = i;
+    }
+    std::vector<uint32_t> order(nodeCount);
+    std::iota(order.begin(), order.end(), 0U);
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(42U));
+    for (uint32_t i = 0U; i < nodeCount; ++i)
+    {
+        Node* next = nodes[order[(i + 1U) % nodeCount]];
+        nodes[order[i]]->m_rawNext = next;
+        nodes[order[i]]->m_relativeNext = RelativePointer<Node>(next, CHUNK_POOL_ID);
+    }
+
+    uint64_t checksum = 0U;
+    double rawChase = 0.0;
+    double relativeChase = 0.0;
+    measurePair(chaseSteps, [&](uint64_t steps) {
+        const Node* node = nodes[order[0]];
+        for (uint64_t s = 0U; s < steps; ++s)
+        {
+            node = node->m_rawNext;
+        }
+        checksum += node->m_payload;
+    }, [&](uint64_t steps) {
+        const Node* node = nodes[order[0]];
+        for (uint64_t s = 0U; s < steps; ++s)
+        {
+            node = node->m_relativeNext.get();
+        }
+        checksum += node->m_payload;
+    }, rawChase, relativeChase);
+    for (ChunkManager* chunk : chunks)
+    {
+        manager->releaseChunk(chunk);
+    }
+
+    // ==================== 2. 发布/接收循环 ====================
+    struct RawDescriptor
+    {
+        ChunkManager* m_chunk;
+        char* m_payload;
+    };
+    struct RelativeDescriptor
+    {
+        ChunkManager* m_chunk;
+        RelativePointer<char> m_payload;
+    };
+    // 描述符经过一个 volatile 槽位，避免编译器把发布和接收合并掉
+    static volatile RawDescriptor* rawSlot = nullptr;
+    static volatile RelativeDescriptor* relativeSlot = nullptr;
+    RawDescriptor rawDescriptor{};
+    RelativeDescriptor relativeDescriptor{};
+
+    double rawCycle = 0.0;
+    double relativeCycle = 0.0;
+    measurePair(cycles, [&](uint64_t count) {
+        for (uint64_t c = 0U; c < count; ++c)
+        {
+            ChunkManager* chunk = manager->getChunk(64U);
+            char* published = payloadOf(*manager, chunk);
+            published[0] = static_cast<char>(c);
+            rawDescriptor = RawDescriptor{chunk, published};
+            rawSlot = &rawDescriptor;
+
+            const RawDescriptor* received = const_cast<const RawDescriptor*>(rawSlot);
+            checksum += static_cast<uint64_t>(received->m_payload[0]);
+            manager->releaseChunk(received->m_chunk);
+        }
+    }, [&](uint64_t count) {
+        for (uint64_t c = 0U; c < count; ++c)
+        {
+            ChunkManager* chunk = manager->getChunk(64U);
+            char* published = payloadOf(*manager, chunk);
+            published[0] = static_cast<char>(c);
+            relativeDescriptor = RelativeDescriptor{chunk, RelativePointer<char>(published, CHUNK_POOL_ID)};
+            relativeSlot = &relativeDescriptor;
+
+            const RelativeDescriptor* received = const_cast<const RelativeDescriptor*>(relativeSlot);
+            checksum += static_cast<uint64_t>(received->m_payload.get()[0]);
+            manager->releaseChunk(received->m_chunk);
+        }
+    }, rawCycle, relativeCycle);
+
+    std::printf("nodes=%u chase steps=%lu cycles=%lu (checksum %lu)\n", nodeCount, chaseSteps, cycles, checksum);
+    std::printf("%-22s %12s %12s %10s\n", "path", "raw ns", "relative ns", "delta");
+    std::printf("%-22s %12.2f %12.2f %9.1f%%\n", "pointer chase/step", rawChase, relativeChase,
+                (relativeChase - rawChase) / rawChase * 100.0);
+    std::printf("%-22s %12.2f %12.2f %9.1f%%\n", "publish+take/cycle", rawCycle, relativeCycle,
+                (relativeCycle - rawCycle) / rawCycle * 100.0);
+
+    MemPoolManager::destroySharedInstance();
+    return 0;
+}
@@ -0,0 +1,77 @@
+#ifndef ZEROCP_MEMPOOL_TEST_HELPERS_HPP
+#define ZEROCP_MEMPOOL_TEST_HELPERS_HPP
+
+/**
+ * @file mempool_test_helpers.hpp
+ * @brief 行为测试共用的夹具：创建共享实例、逐项校验、耗尽候选池
+ */
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "chunk_manager.hpp"
+#include <iostream>
+#include <vector>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+namespace Test
+{
+
+/// @brief 打印测试标题，按 config 创建共享实例并关闭线程弹匣（分配直接走共享空闲链表）
+/// @return 创建失败时打印原因并返回 nullptr
+inline MemPoolManager* setUpSharedInstance(const char* title, const MemPoolConfig& config)
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "  " << title << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    if (!MemPoolManager::createSharedInstance(config))
+    {
+        std::cout << "  ✗ 创建共享内存实例失败" << std::endl;
+        return nullptr;
+    }
+    MemPoolManager::setThreadMagazinesEnabled(false);
+    return MemPoolManager::getInstanceIfInitialized();
+}
+
+/// @brief 逐项校验：打印 ✓/✗ 并累计失败项
+class CheckList
+{
+public:
+    void operator()(bool condition, const char* message) noexcept
+    {
+        std::cout << (condition ? "  ✓ " : "  ✗ ") << message << std::endl;
+        m_failures += condition ? 0 : 1;
+    }
+
+    /// @brief 销毁共享实例并打印结论
+    /// @return 进程退出码（有失败项时非 0，由 ctest 判定）
+    int finish() const noexcept
+    {
+        MemPoolManager::destroySharedInstance();
+        std::cout << (m_failures == 0 ? "\n全部通过" : "\n存在失败项") << std::endl;
+        return m_failures == 0 ? 0 : 1;
+    }
+
+private:
+    int m_failures{0};
+};
+
+/// @brief 按 size 一直分配到失败为止（取决于当前回退策略，可能跨越多个候选池）
+inline std::vector<ChunkManager*> drain(MemPoolManager& manager, uint64_t size)
+{
+    std::vector<ChunkManager*> chunks;
+    while (ChunkManager* chunk = manager.getChunk(size))
+    {
+        chunks.push_back(chunk);
+    }
+    return chunks;
+}
+
+} // namespace Test
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_MEMPOOL_TEST_HELPERS_HPP
@@ -0,0 +1,109 @@
+/**
+ * @file test_blocking_get_chunk.cpp
+ * @brief 阻塞分配 getChunk(size, timeout) 的唤醒
+ * @details 验证：
+ *   1. 候选池全部耗尽且没有归还时按超时返回 nullptr
+ *   2. 归还到回退策略允许的更大池（不是目标尺寸级别）时等待者被唤醒并从该池分配
+ *   3. 启用线程弹匣时，其他线程把 chunk 归还到自己的弹匣也会唤醒等待者（弹匣被冲刷回空闲链表）
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint32_t kChunksPerPool = 64U;
+constexpr uint64_t kSmallSize = 128U;
+constexpr uint64_t kLargeSize = 1024U;
+constexpr auto kTimeout = std::chrono::seconds(2);
+constexpr auto kReleaseDelay = std::chrono::milliseconds(50);
+/// 被唤醒的等待者应在归还后很快返回，远早于超时
+constexpr auto kWakeBound = std::chrono::milliseconds(500);
+
+/// 在另一个线程中延迟归还一个 chunk，同时在本线程阻塞分配；返回分配结果和等待时长。
+/// 归还线程在等待者返回之前不退出：线程退出时会冲刷它的弹匣，不能让它替代归还路径本身的唤醒
+ChunkManager* waitWhileReleasing(MemPoolManager& manager, ChunkManager* toRelease, std::chrono::milliseconds& waited)
+{
+    std::atomic<bool> waiterDone{false};
+    std::thread releaser([&manager, &waiterDone, toRelease] {
+        std::this_thread::sleep_for(kReleaseDelay);
+        manager.releaseChunk(toRelease);
+        while (!waiterDone.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    const auto start = std::chrono::steady_clock::now();
+    ChunkManager* chunk = manager.getChunk(kSmallSize, kTimeout);
+    waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    waiterDone = true;
+    releaser.join();
+    return chunk;
+}
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kSmallSize, kChunksPerPool);
+    config.addMemPoolEntry(kLargeSize, kChunksPerPool);
+    MemPoolManager* instance = Test::setUpSharedInstance("阻塞分配唤醒测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    Test::CheckList check;
+
+    // 两个池分别耗尽后再允许回退：小请求的候选池是 128B（目标尺寸级别）和 1024B（回退）
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NONE);
+    std::vector<ChunkManager*> small = Test::drain(manager, kSmallSize);
+    std::vector<ChunkManager*> large = Test::drain(manager, kLargeSize);
+    check(small.size() == kChunksPerPool && large.size() == kChunksPerPool, "两个池均已耗尽");
+    manager.setFallbackPolicy(ChunkFallbackPolicy::ANY_LARGER);
+
+    // ==================== 1. 没有归还时超时 ====================
+    std::cout << "\n[1] 超时" << std::endl;
+    const auto timeoutStart = std::chrono::steady_clock::now();
+    ChunkManager* none = manager.getChunk(kSmallSize, std::chrono::milliseconds(100));
+    const auto timeoutWaited = std::chrono::steady_clock::now() - timeoutStart;
+    check(none == nullptr, "候选池耗尽时返回 nullptr");
+    check(timeoutWaited >= std::chrono::milliseconds(100), "等待了完整的超时时长");
+
+    // ==================== 2. 归还到回退池时唤醒 ====================
+    std::cout << "\n[2] 归还到回退池" << std::endl;
+    std::chrono::milliseconds waited{0};
+    ChunkManager* fromFallback = waitWhileReleasing(manager, large.back(), waited);
+    large.pop_back();
+    std::cout << "  等待 " << waited.count() << " ms" << std::endl;
+    check(fromFallback != nullptr && fromFallback->m_mempoolIndex == 1U, "等待者从回退池分配到 chunk");
+    check(waited < kWakeBound, "归还后立即被唤醒，没有睡到超时");
+    large.push_back(fromFallback);
+
+    // ==================== 3. 归还到其他线程的弹匣时唤醒 ====================
+    std::cout << "\n[3] 归还到线程弹匣" << std::endl;
+    MemPoolManager::setThreadMagazinesEnabled(true);
+    ChunkManager* fromMagazine = waitWhileReleasing(manager, small.back(), waited);
+    small.pop_back();
+    std::cout << "  等待 " << waited.count() << " ms" << std::endl;
+    check(fromMagazine != nullptr && fromMagazine->m_mempoolIndex == 0U, "等待者拿到了另一个线程归还的 chunk");
+    check(waited < kWakeBound, "弹匣归还唤醒了等待者");
+    small.push_back(fromMagazine);
+
+    manager.releaseChunks(small);
+    manager.releaseChunks(large);
+    MemPoolManager::setThreadMagazinesEnabled(false);
+    check(manager.getMemPools()[0].getUsedChunks() == 0U && manager.getMemPools()[1].getUsedChunks() == 0U,
+          "所有 chunk 都已归还");
+
+    return check.finish();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file test_chunk_chain.cpp
+ * @brief 超过任何池容量的负载使用链式多 chunk 消息
+ * @details 验证：
+ *   1. 放得进单个 chunk 的请求等同于 getChunk，没有后继段
+ *   2. 更大的负载按 getChainSegmentSize() 切段，iovec 覆盖整个负载且各段可写
+ *   3. 引用计数只在链头：增加引用后释放一次不归还，最后一次释放归还所有段；链中途分配失败时不泄漏已分配的段
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <cstring>
+#include <sys/uio.h>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kChunkSize = 1024U;
+constexpr uint32_t kPoolChunks = 8U;
+constexpr uint32_t kMaxSegments = 8U;
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Off);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kChunkSize, kPoolChunks);
+    MemPoolManager* instance = Test::setUpSharedInstance("链式消息测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    MemPool& pool = manager.getMemPools()[0];
+    Test::CheckList check;
+    const uint64_t segmentSize = manager.getChainSegmentSize();
+
+    // ==================== 1. 单段 ====================
+    std::cout << "\n[1] 单段" << std::endl;
+    ChunkManager* single = manager.getChunkChain(segmentSize);
+    check(single != nullptr && manager.getNextChunk(single) == nullptr, "放得进单个 chunk 的负载没有后继段");
+    manager.releaseChunk(single);
+
+    // ==================== 2. 多段 ====================
+    std::cout << "\n[2] 多段" << std::endl;
+    const uint64_t messageSize = 3U * segmentSize + 100U;
+    ChunkManager* head = manager.getChunkChain(messageSize);
+    check(head != nullptr, "分配超过最大尺寸级别的链式消息");
+    if (head == nullptr)
+    {
+        return check.finish();
+    }
+    uint32_t linked = 1U;
+    for (ChunkManager* segment = manager.getNextChunk(head); segment != nullptr; segment = manager.getNextChunk(segment))
+    {
+        ++linked;
+    }
+    iovec segments[kMaxSegments];
+    const uint32_t segmentCount = manager.getChunkSegments(head, segments);
+    uint64_t coveredBytes = 0U;
+    for (uint32_t i = 0U; i < segmentCount && i < kMaxSegments; ++i)
+    {
+        std::memset(segments[i].iov_base, 0x5a, segments[i].iov_len);
+        coveredBytes += segments[i].iov_len;
+    }
+    check(linked == 4U && segmentCount == 4U, "负载切成 4 段");
+    check(coveredBytes == messageSize, "各段合计覆盖整个负载");
+    check(pool.getUsedChunks() == 4U, "每段占用一个 chunk");
+
+    // ==================== 3. 引用计数与失败 ====================
+    std::cout << "\n[3] 引用计数" << std::endl;
+    manager.retainChunk(head);
+    manager.releaseChunk(head);
+    check(pool.getUsedChunks() == 4U, "还有引用时释放链头不归还任何段");
+    manager.releaseChunk(head);
+    check(pool.getUsedChunks() == 0U, "最后一次释放链头归还了所有段");
+
+    check(manager.getChunkChain((kPoolChunks + 1U) * segmentSize) == nullptr, "段数超过池容量时分配失败");
+    check(pool.getUsedChunks() == 0U, "失败时已分配的段全部归还");
+
+    return check.finish();
+}
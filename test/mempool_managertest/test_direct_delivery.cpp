@@ -0,0 +1,192 @@
+/**
+ * @file test_direct_delivery.cpp
+ * @brief 无代理数据面：发布者经 PublisherPort/ChunkDistributor 直接把 chunk 索引写入订阅者接收队列
+ * @details 验证：
+ *   1. 每个已匹配队列收到一个条目并持有一个引用，订阅者用 fromIndex 接管后释放，chunk 回到池中
+ *   2. 队列已满时撤销为该队列转交的引用，不泄漏
+ *   3. 摘除队列的握手：摘除后等到端口静默一次，此后并发投递再也不会写入该队列，清空后没有泄漏的引用
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "chunk_header.hpp"
+#include "publisher_port.hpp"
+#include "receive_queue_pool.hpp"
+#include "popo/chunk_distributor.hpp"
+#include "zerocp_daemon/mempool/shared_chunk.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+using zerocp::memory::ChunkQueueEntry;
+using zerocp::memory::PublisherPort;
+using zerocp::memory::ReceiveQueue;
+using zerocp::memory::ReceiveQueuePool;
+
+namespace
+{
+constexpr uint64_t kPayloadSize = 64U;
+constexpr uint32_t kPoolChunks = 1024U;
+constexpr uint32_t kPublisherSlot = 7U;
+constexpr uint32_t kPublisherThreads = 2U;
+constexpr uint32_t kRetireRounds = 20U;
+/// 端口静默后继续投递的时长：期间被摘除的队列必须保持为空
+constexpr auto kObservationWindow = std::chrono::milliseconds(5);
+
+/// 守护进程清空被回收队列的方式：逐个释放在途引用
+uint32_t drainQueue(MemPoolManager& manager, ReceiveQueue& queue)
+{
+    uint32_t drained = 0U;
+    ChunkQueueEntry entry;
+    while (queue.pop(entry))
+    {
+        manager.releaseChunk(manager.getChunkManagerByIndex(entry.m_chunkManagerIndex));
+        ++drained;
+    }
+    return drained;
+}
+
+SharedChunk loan(MemPoolManager& manager)
+{
+    return SharedChunk(manager.getChunk(kPayloadSize), &manager);
+}
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kPayloadSize, kPoolChunks);
+    MemPoolManager* instance = Test::setUpSharedInstance("无代理直接投递测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    MemPool& pool = manager.getMemPools()[0];
+
+    // 端口和队列池平时位于 DirouteComponents 共享内存中；这里在进程内构造，协议相同
+    auto queuePool = std::make_unique<ReceiveQueuePool>();
+    auto port = std::make_unique<PublisherPort>(kPublisherSlot);
+    ZeroCP::Popo::ChunkDistributor distributor(port.get(), queuePool.get());
+    auto first = queuePool->emplace();
+    auto second = queuePool->emplace();
+    const uint64_t firstIndex = first.to_index();
+    const uint64_t secondIndex = second.to_index();
+    port->addQueue(firstIndex);
+    port->addQueue(secondIndex);
+
+    Test::CheckList check;
+
+    // ==================== 1. 投递到每个已匹配的队列 ====================
+    std::cout << "\n[1] 直接投递" << std::endl;
+    {
+        SharedChunk sample = loan(manager);
+        const uint32_t chunkIndex = sample.getChunkManagerIndex();
+        check(distributor.deliver(sample) == 2U, "两个已匹配的队列都收到了条目");
+        check(sample.useCount() == 3U, "每个队列持有一个转交的引用");
+        check(sample.getChunkheader()->m_originId == kPublisherSlot, "chunk 头记录了来源发布者");
+
+        ChunkQueueEntry entries[2];
+        const bool popped = first->pop(entries[0]) && second->pop(entries[1]);
+        check(popped && entries[0].m_chunkManagerIndex == chunkIndex && entries[1].m_chunkManagerIndex == chunkIndex
+                  && entries[0].m_publisherSlot == kPublisherSlot,
+              "条目携带 chunk 索引和发布者槽位");
+        check(popped && entries[0].m_sequenceNumber == entries[1].m_sequenceNumber
+                  && sample.getChunkheader()->m_sequenceNumber == entries[0].m_sequenceNumber,
+              "同一次投递的条目共用一个序列号");
+
+        // 订阅者接管在途引用并释放，发布者随后释放自己的引用
+        for (const ChunkQueueEntry& entry : entries)
+        {
+            SharedChunk received = SharedChunk::fromIndex(entry.m_chunkManagerIndex, &manager);
+            check(received.getUserPayload() == sample.getUserPayload(), "订阅者看到的是同一块 payload（零拷贝）");
+        }
+        check(sample.useCount() == 1U, "订阅者释放后只剩发布者的引用");
+    }
+    check(pool.getUsedChunks() == 0U, "所有引用释放后 chunk 回到池中");
+
+    // ==================== 2. 队列已满 ====================
+    std::cout << "\n[2] 队列已满" << std::endl;
+    port->removeQueue(secondIndex);
+    for (uint64_t i = 0U; i < ReceiveQueue::capacity(); ++i)
+    {
+        SharedChunk sample = loan(manager);
+        distributor.deliver(sample);
+    }
+    check(first->size() == ReceiveQueue::capacity(), "队列被填满，队列中的条目是 chunk 仅剩的引用");
+    {
+        SharedChunk overflow = loan(manager);
+        check(distributor.deliver(overflow) == 0U, "满队列拒绝新的条目");
+        check(overflow.useCount() == 1U, "被拒绝的转交已撤销");
+    }
+    check(drainQueue(manager, *first) == ReceiveQueue::capacity(), "清空队列时释放了全部在途引用");
+    check(pool.getUsedChunks() == 0U, "队列满时没有泄漏引用");
+
+    // ==================== 3. 并发投递时摘除队列 ====================
+    std::cout << "\n[3] 摘除队列的握手" << std::endl;
+    port->addQueue(secondIndex);
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> deliveries{0};
+    std::vector<std::thread> publishers;
+    for (uint32_t i = 0U; i < kPublisherThreads; ++i)
+    {
+        publishers.emplace_back([&] {
+            while (running.load(std::memory_order_relaxed))
+            {
+                SharedChunk sample = loan(manager);
+                if (sample)
+                {
+                    deliveries.fetch_add(distributor.deliver(sample), std::memory_order_relaxed);
+                }
+                // 另一个队列由订阅者消费，避免写满后投递退化为立即撤销
+                ChunkQueueEntry entry;
+                while (second->pop(entry))
+                {
+                    SharedChunk::fromIndex(entry.m_chunkManagerIndex, &manager);
+                }
+            }
+        });
+    }
+
+    bool removeReportedBit = true;
+    bool secondRemoveIsNoop = true;
+    bool retiredQueueStayedEmpty = true;
+    for (uint32_t round = 0U; round < kRetireRounds; ++round)
+    {
+        port->addQueue(firstIndex);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        removeReportedBit = port->removeQueue(firstIndex) && removeReportedBit;
+        secondRemoveIsNoop = !port->removeQueue(firstIndex) && secondRemoveIsNoop;
+        while (!port->isQuiescent())
+        {
+            std::this_thread::yield();
+        }
+        // 端口静默过一次：此后开始的投递都看得到新的掩码，这时清空的队列不会再有新条目
+        drainQueue(manager, *first);
+        std::this_thread::sleep_for(kObservationWindow);
+        retiredQueueStayedEmpty = first->empty() && retiredQueueStayedEmpty;
+    }
+    running = false;
+    for (auto& publisher : publishers)
+    {
+        publisher.join();
+    }
+    drainQueue(manager, *second);
+    std::cout << "  投递 " << deliveries.load() << " 次，摘除 " << kRetireRounds << " 次" << std::endl;
+
+    check(removeReportedBit, "摘除时报告端口中有该队列（需要等待该端口）");
+    check(secondRemoveIsNoop, "重复摘除报告端口中已没有该队列");
+    check(retiredQueueStayedEmpty, "端口静默后再也没有投递写入被摘除的队列");
+    check(pool.getUsedChunks() == 0U, "清空后没有泄漏的引用");
+    queuePool->release(first);
+    queuePool->release(second);
+
+    return check.finish();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_external_region.cpp
+ * @brief 使用者提供的内存区域登记为 chunk 池
+ * @details 验证：
+ *   1. 登记区域之前外部池没有可用的 chunk，每个外部池只能登记一次
+ *   2. 登记后分配到的 chunk 位于使用者的区域中（写入 chunk 的数据在使用者自己的映射中可见）
+ *   3. 按大小选池时不会选中外部池
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "chunk_header.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kChunkSize = 256U;
+constexpr uint32_t kRegularChunks = 8U;
+constexpr uint32_t kExternalChunks = 16U;
+constexpr uint32_t kExternalPool = 1U;
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Off);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kChunkSize, kRegularChunks);
+    config.addExternalPoolEntry(kChunkSize, kExternalChunks);
+    MemPoolManager* instance = Test::setUpSharedInstance("外部区域测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    MemPool& externalPool = manager.getMemPools()[kExternalPool];
+    Test::CheckList check;
+
+    const uint64_t stride = externalPool.getChunkSetting().getChunkSize();
+    const uint64_t regionSize = stride * kExternalChunks;
+    const int fd = memfd_create("zerocp_external_test", 0);
+    void* region = (fd >= 0 && ftruncate(fd, static_cast<off_t>(regionSize)) == 0)
+                       ? mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                       : MAP_FAILED;
+    if (region == MAP_FAILED)
+    {
+        std::cout << "  ✗ 创建外部区域失败" << std::endl;
+        return check.finish() + 1;
+    }
+
+    // ==================== 1. 登记 ====================
+    std::cout << "\n[1] 登记" << std::endl;
+    check(manager.isExternalPool(kExternalPool) && manager.getChunkFromPool(kExternalPool, 64U) == nullptr,
+          "登记区域之前外部池没有可用的 chunk");
+    check(manager.registerExternalRegion(kExternalPool, fd), "登记 memfd 区域");
+    check(!manager.registerExternalRegion(kExternalPool, fd), "每个外部池只能登记一次");
+
+    // ==================== 2. chunk 位于区域中 ====================
+    std::cout << "\n[2] 分配" << std::endl;
+    ChunkManager* external = manager.getChunkFromPool(kExternalPool, 64U);
+    check(external != nullptr && external->m_mempoolIndex == kExternalPool, "从外部池分配");
+    if (external != nullptr)
+    {
+        ChunkHeader* header = manager.getChunkHeader(external);
+        std::memcpy(reinterpret_cast<char*>(header) + header->m_userPayloadOffset, "zerocp", 7U);
+        const char* mine = static_cast<const char*>(region) + external->m_chunkIndex * stride
+                           + header->m_userPayloadOffset;
+        check(std::memcmp(mine, "zerocp", 7U) == 0, "chunk 的用户数据就在使用者的区域中");
+        manager.releaseChunk(external);
+    }
+    std::vector<ChunkManager*> all;
+    while (ChunkManager* chunk = manager.getChunkFromPool(kExternalPool, 64U))
+    {
+        all.push_back(chunk);
+    }
+    check(all.size() == kExternalChunks, "区域中的每个 chunk 都可以分配");
+    manager.releaseChunks(all);
+
+    // ==================== 3. 按大小选池 ====================
+    std::cout << "\n[3] 按大小选池" << std::endl;
+    std::vector<ChunkManager*> regular = Test::drain(manager, kChunkSize);
+    check(regular.size() == kRegularChunks && externalPool.getUsedChunks() == 0U,
+          "普通池耗尽后也不会选中同尺寸的外部池");
+    manager.releaseChunks(regular);
+
+    const int result = check.finish();
+    munmap(region, regionSize);
+    close(fd);
+    return result;
+}
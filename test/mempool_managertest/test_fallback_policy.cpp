@@ -0,0 +1,103 @@
+/**
+ * @file test_fallback_policy.cpp
+ * @brief 尺寸级别查找与目标池耗尽时的回退策略
+ * @details 验证：
+ *   1. 请求落到能容纳它的最小尺寸级别，超过最大尺寸级别的请求失败
+ *   2. NONE 不回退，NEXT_LARGER 只回退一级，ANY_LARGER 依次尝试所有更大的池
+ *   3. 失败的请求计入目标尺寸级别的池，回退分配计入实际分配的池
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kPoolSizes[] = {64U, 256U, 1024U};
+constexpr uint32_t kPoolChunks = 8U;
+constexpr uint32_t kLargestPool = 2U;
+
+bool allFromPool(const std::vector<ChunkManager*>& chunks, uint32_t poolIndex)
+{
+    for (const ChunkManager* chunk : chunks)
+    {
+        if (chunk->m_mempoolIndex != poolIndex)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// 分配一个 chunk 并返回它所在的池（失败时返回 UINT32_MAX）
+uint32_t poolOfAllocation(MemPoolManager& manager, uint64_t size)
+{
+    ChunkManager* chunk = manager.getChunk(size);
+    if (chunk == nullptr)
+    {
+        return UINT32_MAX;
+    }
+    const uint32_t poolIndex = chunk->m_mempoolIndex;
+    manager.releaseChunk(chunk);
+    return poolIndex;
+}
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Off);
+
+    MemPoolConfig config;
+    for (uint64_t size : kPoolSizes)
+    {
+        config.addMemPoolEntry(size, kPoolChunks);
+    }
+    MemPoolManager* instance = Test::setUpSharedInstance("尺寸级别回退测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    auto& pools = manager.getMemPools();
+    Test::CheckList check;
+
+    // ==================== 1. 尺寸级别查找 ====================
+    std::cout << "\n[1] 尺寸级别" << std::endl;
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NONE);
+    check(poolOfAllocation(manager, 1U) == 0U && poolOfAllocation(manager, kPoolSizes[0]) == 0U,
+          "不超过最小尺寸级别的请求落到最小的池");
+    check(poolOfAllocation(manager, kPoolSizes[0] + 1U) == 1U && poolOfAllocation(manager, kPoolSizes[1]) == 1U,
+          "请求落到能容纳它的最小尺寸级别");
+    check(poolOfAllocation(manager, kPoolSizes[kLargestPool] + 1U) == UINT32_MAX, "超过最大尺寸级别的请求失败");
+
+    // ==================== 2. 回退策略 ====================
+    std::cout << "\n[2] 回退策略" << std::endl;
+    const uint64_t failedBefore = pools[0].getTelemetry().snapshot().m_failedAllocations;
+    std::vector<ChunkManager*> smallest = Test::drain(manager, kPoolSizes[0]);
+    check(smallest.size() == kPoolChunks && allFromPool(smallest, 0U), "NONE：目标池耗尽即失败");
+
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NEXT_LARGER);
+    std::vector<ChunkManager*> next = Test::drain(manager, kPoolSizes[0]);
+    check(next.size() == kPoolChunks && allFromPool(next, 1U), "NEXT_LARGER：回退到下一级");
+    check(manager.getChunk(kPoolSizes[0]) == nullptr, "NEXT_LARGER：不跨过两级");
+
+    manager.setFallbackPolicy(ChunkFallbackPolicy::ANY_LARGER);
+    std::vector<ChunkManager*> any = Test::drain(manager, kPoolSizes[0]);
+    check(any.size() == kPoolChunks && allFromPool(any, kLargestPool), "ANY_LARGER：依次尝试所有更大的池");
+
+    // ==================== 3. 计数 ====================
+    std::cout << "\n[3] 计数" << std::endl;
+    // 三次耗尽各有一个失败的请求，加上 NEXT_LARGER 下单独的一次
+    check(pools[0].getTelemetry().snapshot().m_failedAllocations - failedBefore == 4U, "失败计入目标尺寸级别的池");
+    check(pools[kLargestPool].getUsedChunks() == kPoolChunks, "回退分配计入实际分配的池");
+    manager.releaseChunks(smallest);
+    manager.releaseChunks(next);
+    manager.releaseChunks(any);
+    check(pools[0].getUsedChunks() == 0U && pools[1].getUsedChunks() == 0U && pools[kLargestPool].getUsedChunks() == 0U,
+          "所有 chunk 都已归还");
+
+    return check.finish();
+}
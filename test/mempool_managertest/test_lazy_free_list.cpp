@@ -0,0 +1,159 @@
+/**
+ * @file test_lazy_free_list.cpp
+ * @brief 空闲链表和控制块的惰性初始化
+ * @details 验证：
+ *   1. 创建共享实例时不写空闲链表的索引数组和控制块表：这两段内存在首次分配前没有物理页
+ *   2. 回收栈优先（LIFO 复用），为空时才推进从未使用的水位；批量分配跨越两者的边界
+ *   3. 整池分配时每个控制块都由分配路径初始化，索引互不重复，释放后可以再次整池分配
+ *   4. 扩容只提高上限，新段的 chunk 在被分配时才初始化
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kLazyChunkSize = 64U;
+constexpr uint32_t kLazyPoolChunks = 1U << 18U;
+constexpr uint64_t kGrowingChunkSize = 512U;
+constexpr uint32_t kGrowingSegmentChunks = 256U;
+constexpr uint32_t kBatchSize = 8U;
+
+/// 区域内（不含首尾可能与其他数据共用的页）已有物理页的页数
+uint64_t residentInteriorPages(const void* begin, uint64_t length)
+{
+    const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t first = (reinterpret_cast<uintptr_t>(begin) + pageSize - 1U) & ~(pageSize - 1U);
+    const uintptr_t last = (reinterpret_cast<uintptr_t>(begin) + length) & ~(pageSize - 1U);
+    if (last <= first)
+    {
+        return 0U;
+    }
+    std::vector<unsigned char> residency((last - first) / pageSize);
+    if (mincore(reinterpret_cast<void*>(first), last - first, residency.data()) != 0)
+    {
+        return UINT64_MAX;
+    }
+    uint64_t resident = 0U;
+    for (unsigned char page : residency)
+    {
+        resident += page & 1U;
+    }
+    return resident;
+}
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kLazyChunkSize, kLazyPoolChunks);
+    config.addMemPoolEntry(kGrowingChunkSize, kGrowingSegmentChunks, 0U, 1U);
+    const auto createStart = std::chrono::steady_clock::now();
+    MemPoolManager* instance = Test::setUpSharedInstance("空闲链表惰性初始化测试", config);
+    const auto createTime = std::chrono::steady_clock::now() - createStart;
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NONE);
+    MemPool& pool = manager.getMemPools()[0];
+    MemPool& growingPool = manager.getMemPools()[1];
+
+    Test::CheckList check;
+
+    // ==================== 1. 创建时不写索引数组和控制块 ====================
+    std::cout << "\n[1] 创建（" << std::chrono::duration_cast<std::chrono::microseconds>(createTime).count()
+              << " us，" << kLazyPoolChunks << " 个 chunk）" << std::endl;
+    check(pool.getTouchedChunks() == 0U && pool.getFreeChunks() == kLazyPoolChunks, "所有 chunk 空闲且从未被分配");
+    check(residentInteriorPages(pool.getFreeListMemory(), kLazyPoolChunks * sizeof(uint32_t)) == 0U,
+          "空闲链表的索引数组没有被写入");
+    check(residentInteriorPages(manager.getChunkManagerByIndex(0U), kLazyPoolChunks * sizeof(ChunkManager)) == 0U,
+          "控制块表没有被写入");
+
+    // ==================== 2. LIFO 复用与批量分配 ====================
+    std::cout << "\n[2] 复用顺序" << std::endl;
+    ChunkManager* firstChunk = manager.getChunk(kLazyChunkSize);
+    check(firstChunk != nullptr && firstChunk->m_chunkIndex == 0U && pool.getTouchedChunks() == 1U,
+          "首次分配从水位取出 0 号 chunk");
+    manager.releaseChunk(firstChunk);
+    ChunkManager* reused = manager.getChunk(kLazyChunkSize);
+    check(reused == firstChunk && pool.getTouchedChunks() == 1U, "归还的 chunk 先被复用，水位不动");
+    manager.releaseChunk(reused);
+
+    // 回收栈只有一个 chunk：批量分配先取它，再从水位取一段连续索引
+    ChunkManager* batch[kBatchSize] = {};
+    const uint32_t batchCount = manager.getChunks(kLazyChunkSize, kBatchSize, batch);
+    bool batchDistinct = batchCount == kBatchSize && batch[0] == firstChunk;
+    for (uint32_t i = 1U; i < batchCount; ++i)
+    {
+        batchDistinct = batchDistinct && batch[i]->m_chunkIndex == i && batch[i]->m_refCount.load() == 1U;
+    }
+    check(batchDistinct, "批量分配先取回收栈，再取水位以上的连续索引");
+    check(pool.getTouchedChunks() == kBatchSize, "水位只推进了回收栈不够的部分");
+    manager.releaseChunks(std::span<ChunkManager* const>(batch, batchCount));
+
+    // ==================== 3. 整池分配 ====================
+    std::cout << "\n[3] 整池分配" << std::endl;
+    std::vector<ChunkManager*> all = Test::drain(manager, kLazyChunkSize);
+    std::vector<bool> seen(kLazyPoolChunks, false);
+    bool controlBlocksInitialized = all.size() == kLazyPoolChunks;
+    for (ChunkManager* chunk : all)
+    {
+        controlBlocksInitialized = controlBlocksInitialized && chunk->m_mempoolIndex == 0U
+                                   && chunk->m_chunkIndex < kLazyPoolChunks && !seen[chunk->m_chunkIndex]
+                                   && manager.getChunkManagerByIndex(chunk->m_chunkManagerIndex) == chunk;
+        if (chunk->m_chunkIndex < kLazyPoolChunks)
+        {
+            seen[chunk->m_chunkIndex] = true;
+        }
+    }
+    check(controlBlocksInitialized, "每个 chunk 恰好分配一次，控制块索引自洽");
+    check(pool.getTouchedChunks() == kLazyPoolChunks && pool.getFreeChunks() == 0U, "水位到达池的末尾");
+    manager.releaseChunks(all);
+    all = Test::drain(manager, kLazyChunkSize);
+    check(all.size() == kLazyPoolChunks, "全部归还后可以再次整池分配（全部来自回收栈）");
+    manager.releaseChunks(all);
+
+    // ==================== 4. 扩容 ====================
+    std::cout << "\n[4] 扩容" << std::endl;
+    std::vector<ChunkManager*> grown;
+    for (uint32_t i = 0U; i < kGrowingSegmentChunks; ++i)
+    {
+        grown.push_back(manager.getChunk(kGrowingChunkSize));
+    }
+    check(grown.back() != nullptr && growingPool.getFreeChunks() == 0U
+              && growingPool.getTotalChunks() == kGrowingSegmentChunks,
+          "初始段耗尽");
+    // 创建者进程在候选池耗尽时按需扩容
+    ChunkManager* firstGrown = manager.getChunk(kGrowingChunkSize);
+    check(firstGrown != nullptr && growingPool.getTotalChunks() == 2U * kGrowingSegmentChunks, "耗尽后按需扩容，上限翻倍");
+    check(firstGrown != nullptr && firstGrown->m_chunkIndex == kGrowingSegmentChunks
+              && growingPool.getTouchedChunks() == kGrowingSegmentChunks + 1U,
+          "扩容不初始化新段的 chunk，只有被分配的那个");
+    grown.push_back(firstGrown);
+    std::vector<ChunkManager*> extra = Test::drain(manager, kGrowingChunkSize);
+    bool extraFromNewSegment = extra.size() == kGrowingSegmentChunks - 1U;
+    for (ChunkManager* chunk : extra)
+    {
+        extraFromNewSegment = extraFromNewSegment && chunk->m_chunkIndex > kGrowingSegmentChunks;
+    }
+    check(extraFromNewSegment, "新段的其余 chunk 全部可用");
+    check(!manager.growPool(1U), "达到扩容上限后拒绝扩容");
+    manager.releaseChunks(grown);
+    manager.releaseChunks(extra);
+    check(pool.getUsedChunks() == 0U && growingPool.getUsedChunks() == 0U, "所有 chunk 都已归还");
+
+    return check.finish();
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_ledger_reclaim.cpp
+ * @brief 按引用持有账本回收死亡进程的 chunk（reclaimChunksOfProcess）
+ * @details 验证：
+ *   1. 进程仍存在（例如被 SIGSTOP 暂停、心跳超时）时不回收，它持有的 chunk 保持被引用
+ *   2. 进程退出后回收它分配和额外持有的全部引用，以及它的预留
+ *   3. 重复回收不会重复扣除，回收后整池可以重新分配
+ */
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "chunk_manager.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint32_t kPoolChunks = 100U;
+constexpr uint32_t kHeldChunks = 30U;
+constexpr uint32_t kRetainedChunks = 5U;
+constexpr uint32_t kReservedChunks = 5U;
+
+/// 子进程：分配并持有 chunk，对其中几个增加引用，再预留几个，通知父进程后等待被杀死
+int runVictim(int notifyFd)
+{
+    if (!MemPoolManager::attachToSharedInstance())
+    {
+        return 2;
+    }
+    MemPoolManager& manager = *MemPoolManager::getInstanceIfInitialized();
+    for (uint32_t i = 0; i < kHeldChunks; ++i)
+    {
+        ChunkManager* chunk = manager.getChunk(64U);
+        if (chunk == nullptr)
+        {
+            return 3;
+        }
+        if (i < kRetainedChunks)
+        {
+            manager.retainChunk(chunk);
+        }
+    }
+    if (!manager.reserveChunks(64U, kReservedChunks))
+    {
+        return 4;
+    }
+    const char ready = 'x';
+    if (write(notifyFd, &ready, 1) != 1)
+    {
+        return 5;
+    }
+    pause();
+    return 0;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Error);
+    if (argc > 2 && std::strcmp(argv[1], "victim") == 0)
+    {
+        return runVictim(std::atoi(argv[2]));
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  死亡进程 chunk 回收测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(128, kPoolChunks);
+    if (!MemPoolManager::createSharedInstance(config))
+    {
+        std::cout << "  ✗ 创建共享内存实例失败" << std::endl;
+        return 1;
+    }
+    MemPoolManager& manager = *MemPoolManager::getInstanceIfInitialized();
+    MemPool& pool = manager.getMemPools()[0];
+
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        return 1;
+    }
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        execl(argv[0], argv[0], "victim", std::to_string(fds[1]).c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    close(fds[1]);
+    char ready = 0;
+    const bool victimReady = read(fds[0], &ready, 1) == 1;
+
+    int failures = 0;
+    const auto check = [&](bool condition, const char* message) {
+        std::cout << (condition ? "  ✓ " : "  ✗ ") << message << std::endl;
+        failures += condition ? 0 : 1;
+    };
+    check(victimReady, "子进程已分配、持有并预留 chunk");
+    const uint32_t usedByVictim = pool.getUsedChunks();
+    check(usedByVictim == kHeldChunks + kReservedChunks, "已使用 = 持有 + 预留");
+
+    // ==================== 1. 暂停的进程（心跳会超时，但仍存在）不回收 ====================
+    kill(pid, SIGSTOP);
+    check(MemPoolManager::isProcessAlive(static_cast<uint32_t>(pid)), "暂停的进程仍视为存在");
+    check(manager.reclaimChunksOfProcess(static_cast<uint32_t>(pid)) == 0U, "进程存在时不扣除引用");
+    check(pool.getUsedChunks() == usedByVictim, "进程存在时 chunk 保持被持有");
+
+    // ==================== 2. 进程退出后回收 ====================
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+    check(!MemPoolManager::isProcessAlive(static_cast<uint32_t>(pid)), "被回收（waitpid）的进程视为已退出");
+    const uint64_t reclaimed = manager.reclaimChunksOfProcess(static_cast<uint32_t>(pid));
+    check(reclaimed == kHeldChunks + kRetainedChunks, "扣除了分配的引用和额外持有的引用");
+    check(pool.getUsedChunks() == 0U, "持有和预留的 chunk 全部归还");
+    check(manager.reclaimChunksOfProcess(static_cast<uint32_t>(pid)) == 0U, "重复回收不重复扣除");
+
+    // ==================== 3. 整池可重新分配 ====================
+    std::vector<ChunkManager*> all;
+    while (ChunkManager* chunk = manager.getChunk(64U))
+    {
+        all.push_back(chunk);
+    }
+    check(all.size() == kPoolChunks, "回收后整池可以重新分配");
+    manager.releaseChunks(all);
+
+    MemPoolManager::destroySharedInstance();
+    std::cout << (failures == 0 ? "\n全部通过" : "\n存在失败项") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_owner_quota.cpp
+ * @brief 每个进程的 chunk 预留与配额
+ * @details 验证：
+ *   1. 预留的 chunk 离开共享空闲链表并记在账户上，本进程的分配先用预留，释放后回到预留
+ *   2. 取消预留后 chunk 回到共享空闲链表
+ *   3. 配额限制单个进程的持有量（单个和批量分配都受限，含预留），超出配额的分配被计数
+ *   4. 超过一批（kMaxBatchSize）的预留分批完成；空闲 chunk 不足时已摘下的部分全部放回
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "chunk_owner_account.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kChunkSize = 1024U;
+constexpr uint32_t kPoolChunks = 8U;
+constexpr uint32_t kReservedChunks = 3U;
+constexpr uint32_t kQuota = 4U;
+constexpr uint64_t kLargeChunkSize = 4096U;
+constexpr uint32_t kLargePoolChunks = 160U;
+constexpr uint32_t kLargeReserved = 150U;
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Off);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kChunkSize, kPoolChunks);
+    config.addMemPoolEntry(kLargeChunkSize, kLargePoolChunks);
+    MemPoolManager* instance = Test::setUpSharedInstance("预留与配额测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NONE);
+    MemPool& pool = manager.getMemPools()[0];
+    Test::CheckList check;
+
+    const uint32_t ownerSlot = MemPoolManager::getOwnerSlot();
+    const ChunkOwnerAccount& account = manager.getOwnerAccount(ownerSlot);
+    check(ownerSlot != MemPoolManager::kNoChunkOwner, "创建进程登记了所有者槽位");
+
+    // ==================== 1. 预留 ====================
+    std::cout << "\n[1] 预留" << std::endl;
+    check(manager.reserveChunks(kChunkSize, kReservedChunks), "预留成功");
+    check(pool.getUsedChunks() == kReservedChunks && account.m_reservedChunks[0] == kReservedChunks,
+          "预留的 chunk 离开共享空闲链表并记在账户上");
+    std::vector<ChunkManager*> held = Test::drain(manager, kChunkSize);
+    uint32_t fromReservation = 0U;
+    for (const ChunkManager* chunk : held)
+    {
+        fromReservation += chunk->m_fromReservation ? 1U : 0U;
+    }
+    check(held.size() == kPoolChunks && fromReservation == kReservedChunks, "本进程的分配用掉了预留和共享的 chunk");
+    manager.releaseChunks(held);
+    check(pool.getUsedChunks() == kReservedChunks, "释放后预留的 chunk 回到私有链表");
+
+    // ==================== 2. 取消预留 ====================
+    std::cout << "\n[2] 取消预留" << std::endl;
+    manager.cancelReservation(kChunkSize, kReservedChunks);
+    check(pool.getUsedChunks() == 0U && account.m_reservedChunks[0] == 0U, "取消预留后 chunk 回到共享空闲链表");
+
+    // ==================== 3. 配额 ====================
+    std::cout << "\n[3] 配额" << std::endl;
+    check(manager.setOwnerQuota(ownerSlot, 0U, kQuota), "设置配额");
+    const uint64_t rejectionsBefore = account.m_quotaRejections.load();
+    held = Test::drain(manager, kChunkSize);
+    check(held.size() == kQuota, "配额限制了持有量");
+    check(account.m_quotaRejections.load() > rejectionsBefore, "超出配额的分配被计数");
+    ChunkManager* batch[kPoolChunks] = {};
+    check(manager.getChunks(kChunkSize, kPoolChunks, batch) == 0U, "批量分配同样受配额限制");
+    manager.releaseChunks(held);
+    check(manager.reserveChunks(kChunkSize, kQuota) && !manager.reserveChunks(kChunkSize, 1U), "预留计入配额");
+    manager.cancelReservation(kChunkSize, kQuota);
+    manager.setOwnerQuota(ownerSlot, 0U, 0U);
+    check(pool.getUsedChunks() == 0U, "所有 chunk 都已归还");
+
+    // ==================== 4. 分批预留 ====================
+    std::cout << "\n[4] 分批预留" << std::endl;
+    MemPool& largePool = manager.getMemPools()[1];
+    check(manager.reserveChunks(kLargeChunkSize, kLargeReserved)
+              && largePool.getUsedChunks() == kLargeReserved && account.m_reservedChunks[1] == kLargeReserved,
+          "超过一批的预留分批完成");
+    check(!manager.reserveChunks(kLargeChunkSize, kLargePoolChunks - kLargeReserved + 1U)
+              && largePool.getUsedChunks() == kLargeReserved && account.m_reservedChunks[1] == kLargeReserved,
+          "空闲 chunk 不足时预留失败，已摘下的部分全部放回");
+    manager.cancelReservation(kLargeChunkSize, kLargeReserved);
+    check(largePool.getUsedChunks() == 0U && account.m_reservedChunks[1] == 0U, "取消后全部回到共享空闲链表");
+
+    return check.finish();
+}
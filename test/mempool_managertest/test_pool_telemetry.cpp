@@ -0,0 +1,97 @@
+/**
+ * @file test_pool_telemetry.cpp
+ * @brief 每个池的分配遥测：高水位、失败和 CAS 重试计数
+ * @details 验证：
+ *   1. 单个和批量分配/归还的计数与实际操作一致，失败的请求被计数
+ *   2. 高水位保留已使用数的峰值，归还后不回落
+ *   3. 多线程并发分配/归还后各 CPU 分片相加的总数准确
+ */
+
+#include "mempool_test_helpers.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <span>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kChunkSize = 256U;
+constexpr uint32_t kPoolChunks = 64U;
+constexpr uint32_t kBatchSize = 16U;
+constexpr uint32_t kThreadCount = 4U;
+constexpr uint32_t kRoundsPerThread = 20000U;
+} // namespace
+
+int main()
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Off);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kChunkSize, kPoolChunks);
+    MemPoolManager* instance = Test::setUpSharedInstance("池遥测测试", config);
+    if (instance == nullptr)
+    {
+        return 1;
+    }
+    MemPoolManager& manager = *instance;
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NONE);
+    MemPool& pool = manager.getMemPools()[0];
+    const PoolTelemetry& telemetry = pool.getTelemetry();
+    Test::CheckList check;
+
+    // ==================== 1. 计数 ====================
+    std::cout << "\n[1] 计数" << std::endl;
+    ChunkManager* single = manager.getChunk(kChunkSize);
+    ChunkManager* batch[kBatchSize] = {};
+    const uint32_t batchCount = manager.getChunks(kChunkSize, kBatchSize, batch);
+    PoolTelemetry::Snapshot snapshot = telemetry.snapshot();
+    check(single != nullptr && batchCount == kBatchSize && snapshot.m_allocations == 1U + kBatchSize,
+          "单个和批量分配都被计数");
+    manager.releaseChunk(single);
+    manager.releaseChunks(std::span<ChunkManager* const>(batch, batchCount));
+    snapshot = telemetry.snapshot();
+    check(snapshot.m_frees == 1U + kBatchSize, "单个和批量归还都被计数");
+
+    std::vector<ChunkManager*> all = Test::drain(manager, kChunkSize);
+    snapshot = telemetry.snapshot();
+    check(all.size() == kPoolChunks && snapshot.m_failedAllocations == 1U, "池耗尽时失败的请求被计数");
+
+    // ==================== 2. 高水位 ====================
+    std::cout << "\n[2] 高水位" << std::endl;
+    manager.releaseChunks(all);
+    check(pool.getHighWaterMark() == kPoolChunks && pool.getUsedChunks() == 0U, "归还后高水位保留峰值");
+
+    // ==================== 3. 并发 ====================
+    std::cout << "\n[3] 并发" << std::endl;
+    const PoolTelemetry::Snapshot before = telemetry.snapshot();
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0U; i < kThreadCount; ++i)
+    {
+        workers.emplace_back([&manager] {
+            for (uint32_t round = 0U; round < kRoundsPerThread; ++round)
+            {
+                ChunkManager* chunk = manager.getChunk(kChunkSize);
+                if (chunk != nullptr)
+                {
+                    manager.releaseChunk(chunk);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    const PoolTelemetry::Snapshot after = telemetry.snapshot();
+    std::cout << "  CAS 重试 " << (after.m_casRetries - before.m_casRetries) << " 次" << std::endl;
+    check(after.m_allocations - before.m_allocations == uint64_t{kThreadCount} * kRoundsPerThread
+              && after.m_failedAllocations == before.m_failedAllocations,
+          "并发分配的计数准确");
+    check(after.m_frees - before.m_frees == uint64_t{kThreadCount} * kRoundsPerThread, "并发归还的计数准确");
+    check(pool.getUsedChunks() == 0U, "所有 chunk 都已归还");
+
+    return check.finish();
+}
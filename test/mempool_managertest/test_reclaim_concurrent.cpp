@@ -0,0 +1,172 @@
+/**
+ * @file test_reclaim_concurrent.cpp
+ * @brief 空闲 chunk 回收（--reclaim）与并发分配同时进行
+ * @details 验证：
+ *   1. 回收期间回收栈的热部分留在原位：并发分配不会失败，也不会推进从未使用的水位（不触碰新页）
+ *   2. 被 madvise 的冷 chunk 不会同时被分配出去：分配者写入的数据不会被清零
+ *   3. 冷 chunk 放入冷链表后仍可复用，所有 chunk 最终都能归还
+ */
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "chunk_manager.hpp"
+#include "chunk_header.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <cstring>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kPayloadSize = 4000U;
+constexpr uint32_t kPoolChunks = 65536U;
+constexpr uint32_t kWarmChunks = 32768U;
+constexpr uint32_t kWorkerCount = 3U;
+constexpr uint32_t kChunksPerRound = 4U;
+
+std::atomic<bool> g_running{true};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_failedAllocations{0};
+std::atomic<uint64_t> g_corruptedChunks{0};
+
+char* payloadOf(MemPoolManager& manager, ChunkManager* chunk)
+{
+    ChunkHeader* header = manager.getChunkHeader(chunk);
+    return reinterpret_cast<char*>(header) + header->m_userPayloadOffset;
+}
+
+void allocatorLoop(MemPoolManager& manager, uint32_t workerId)
+{
+    ChunkManager* chunks[kChunksPerRound];
+    const char pattern = static_cast<char>(0x40 + workerId);
+    while (g_running.load(std::memory_order_relaxed))
+    {
+        uint32_t count = 0U;
+        for (; count < kChunksPerRound; ++count)
+        {
+            chunks[count] = manager.getChunk(kPayloadSize);
+            if (chunks[count] == nullptr)
+            {
+                g_failedAllocations.fetch_add(1U, std::memory_order_relaxed);
+                break;
+            }
+            std::memset(payloadOf(manager, chunks[count]), pattern, kPayloadSize);
+        }
+        g_allocations.fetch_add(count, std::memory_order_relaxed);
+
+        // 持有期间让出 CPU，给回收线程机会在这些 chunk 上 madvise（如果它们被错误地当成冷 chunk）
+        std::this_thread::yield();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const char* payload = payloadOf(manager, chunks[i]);
+            if (payload[0] != pattern || payload[kPayloadSize - 1U] != pattern)
+            {
+                g_corruptedChunks.fetch_add(1U, std::memory_order_relaxed);
+            }
+            manager.releaseChunk(chunks[i]);
+        }
+    }
+}
+} // namespace
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "  空闲 chunk 回收 + 并发分配测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Warn);
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kPayloadSize, kPoolChunks);
+    if (!MemPoolManager::createSharedInstance(config))
+    {
+        std::cout << "  ✗ 创建共享内存实例失败" << std::endl;
+        return 1;
+    }
+    MemPoolManager& manager = *MemPoolManager::getInstanceIfInitialized();
+    // 直接在空闲链表上分配，不经过线程弹匣
+    MemPoolManager::setThreadMagazinesEnabled(false);
+    manager.setFallbackPolicy(ChunkFallbackPolicy::NONE);
+    MemPool& pool = manager.getMemPools()[0];
+
+    // ==================== 1. 一次突发后全部归还：回收栈深 kWarmChunks ====================
+    std::vector<ChunkManager*> burst;
+    for (uint32_t i = 0; i < kWarmChunks; ++i)
+    {
+        ChunkManager* chunk = manager.getChunk(kPayloadSize);
+        if (chunk == nullptr)
+        {
+            std::cout << "  ✗ 预热分配失败" << std::endl;
+            return 1;
+        }
+        std::memset(payloadOf(manager, chunk), 0x5a, kPayloadSize);
+        burst.push_back(chunk);
+    }
+    manager.releaseChunks(burst);
+    burst.clear();
+    manager.sampleChunkUsage();
+    manager.reclaimIdleChunks();  // 重置峰值：此后只有并发线程的少量 chunk 是热的
+    const uint32_t touchedBefore = pool.getTouchedChunks();
+    std::cout << "\n[1] 预热完成，已触碰 chunk: " << touchedBefore << std::endl;
+
+    // ==================== 2. 并发分配的同时反复回收 ====================
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < kWorkerCount; ++i)
+    {
+        workers.emplace_back(allocatorLoop, std::ref(manager), i);
+    }
+
+    // 每一轮都摘下除少量热 chunk 外的整个回收栈并 madvise，与分配线程交错
+    uint64_t reclaimedBytes = 0U;
+    uint32_t rounds = 0U;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        manager.sampleChunkUsage();
+        reclaimedBytes += manager.reclaimIdleChunks();
+        ++rounds;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    g_running = false;
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    std::cout << "[2] 回收 " << rounds << " 轮，释放 " << (reclaimedBytes >> 10) << " KiB；分配 "
+              << g_allocations.load() << " 次" << std::endl;
+
+    // ==================== 3. 校验 ====================
+    int failures = 0;
+    const auto check = [&](bool condition, const char* message) {
+        std::cout << (condition ? "  ✓ " : "  ✗ ") << message << std::endl;
+        failures += condition ? 0 : 1;
+    };
+    check(g_failedAllocations.load() == 0U, "回收期间并发分配没有失败");
+    check(pool.getTouchedChunks() == touchedBefore, "回收期间没有推进从未使用的水位");
+    check(g_corruptedChunks.load() == 0U, "分配出去的 chunk 没有被 madvise 清零");
+    check(manager.getReclaimedBytes() > 0U, "冷 chunk 的物理页被释放");
+    check(pool.getUsedChunks() == 0U, "所有 chunk 都已归还");
+
+    // 冷 chunk 在冷链表中：整池仍可全部分配
+    for (uint32_t i = 0; i < kWarmChunks; ++i)
+    {
+        ChunkManager* chunk = manager.getChunk(kPayloadSize);
+        if (chunk == nullptr)
+        {
+            break;
+        }
+        burst.push_back(chunk);
+    }
+    check(burst.size() == kWarmChunks && pool.getTouchedChunks() == touchedBefore, "回收过的 chunk 可以重新分配");
+    manager.releaseChunks(burst);
+
+    MemPoolManager::destroySharedInstance();
+    std::cout << (failures == 0 ? "\n全部通过" : "\n存在失败项") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
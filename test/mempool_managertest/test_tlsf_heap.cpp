@@ -0,0 +1,212 @@
+/**
+ * @file test_tlsf_heap.cpp
+ * @brief 大块段（TLSF 堆）的分配、合并与持锁进程死亡后的恢复
+ * @details 验证：
+ *   1. 超过最大尺寸级别的请求从 TLSF 堆按实际大小分配，payload 按要求对齐，释放后相邻块完全合并
+ *   2. 持锁进程在堆操作中途被杀死后，下一个加锁者重建空闲链表并接管锁，堆结构保持一致
+ *   3. 物理块链损坏时不恢复锁：堆被标记为不可用，大块分配和释放失败，普通池不受影响
+ */
+
+#include "mempool_manager.hpp"
+#include "mempool_config.hpp"
+#include "chunk_manager.hpp"
+#include "chunk_header.hpp"
+#include "tlsf_heap.hpp"
+#include "logging.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ZeroCP::Memory;
+
+namespace
+{
+constexpr uint64_t kSmallChunkSize = 1024U;
+constexpr uint64_t kArenaSize = 32U << 20U;
+constexpr uint32_t kMaxLargeChunks = 4096U;
+constexpr uint64_t kChurnSize = 20000U;
+constexpr uint32_t kMaxKillRounds = 300U;
+
+/// 子进程：不停地分配和释放大块，直到被杀死
+int runChurn(int notifyFd)
+{
+    if (!MemPoolManager::attachToSharedInstance())
+    {
+        return 2;
+    }
+    MemPoolManager& manager = *MemPoolManager::getInstanceIfInitialized();
+    const char ready = 'x';
+    if (write(notifyFd, &ready, 1) != 1)
+    {
+        return 3;
+    }
+    for (uint64_t round = 0U;; ++round)
+    {
+        ChunkManager* first = manager.getChunk(kChurnSize + (round % 7U) * 4096U);
+        ChunkManager* second = manager.getChunk(kChurnSize);
+        if (first != nullptr)
+        {
+            manager.releaseChunk(first);
+        }
+        if (second != nullptr)
+        {
+            manager.releaseChunk(second);
+        }
+    }
+}
+
+/// 启动一个 churn 子进程，等它开始分配后在随机时刻 SIGKILL，再按账本回收它持有的 chunk
+void killChurnAtRandomPoint(MemPoolManager& manager, const char* self, std::mt19937& rng)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        return;
+    }
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        execl(self, self, "churn", std::to_string(fds[1]).c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    close(fds[1]);
+    char ready = 0;
+    (void)read(fds[0], &ready, 1);
+    close(fds[0]);
+    std::this_thread::sleep_for(std::chrono::microseconds(rng() % 2000U));
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+    manager.reclaimChunksOfProcess(static_cast<uint32_t>(pid));
+}
+
+/// 用固定大小的大块填满堆再全部释放：返回分配到的块数
+uint32_t fillAndDrain(MemPoolManager& manager, uint64_t size)
+{
+    std::vector<ChunkManager*> chunks;
+    while (ChunkManager* chunk = manager.getChunk(size))
+    {
+        chunks.push_back(chunk);
+    }
+    manager.releaseChunks(chunks);
+    return static_cast<uint32_t>(chunks.size());
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ZeroCP::Log::Log_Manager::getInstance().setLogLevel(ZeroCP::Log::LogLevel::Off);
+    if (argc > 2 && std::strcmp(argv[1], "churn") == 0)
+    {
+        return runChurn(std::atoi(argv[2]));
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  TLSF 大块段测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    MemPoolConfig config;
+    config.addMemPoolEntry(kSmallChunkSize, 64U);
+    if (!config.setLargeChunkSegment(kArenaSize, kMaxLargeChunks) || !MemPoolManager::createSharedInstance(config))
+    {
+        std::cout << "  ✗ 创建共享内存实例失败" << std::endl;
+        return 1;
+    }
+    MemPoolManager& manager = *MemPoolManager::getInstanceIfInitialized();
+    const TlsfHeap& heap = manager.getLargeChunkHeap();
+
+    int failures = 0;
+    const auto check = [&](bool condition, const char* message) {
+        std::cout << (condition ? "  ✓ " : "  ✗ ") << message << std::endl;
+        failures += condition ? 0 : 1;
+    };
+
+    // ==================== 1. 分配、对齐与合并 ====================
+    std::cout << "\n[1] 分配与合并" << std::endl;
+    const uint64_t initialLargest = manager.getLargestFreeLargeChunk();
+    ChunkManager* aligned = manager.getChunk(100000U, 256U);
+    check(aligned != nullptr && aligned->m_mempoolIndex == MemPoolManager::kLargeChunkPool, "超出尺寸级别的请求进入大块段");
+    if (aligned != nullptr)
+    {
+        ChunkHeader* header = manager.getChunkHeader(aligned);
+        const auto payload = reinterpret_cast<std::uintptr_t>(header) + header->m_userPayloadOffset;
+        check(payload % 256U == 0U && header->m_userPayloadOffset + 100000U <= header->m_chunkSize, "payload 按要求对齐且放得下");
+    }
+    std::vector<ChunkManager*> blocks{aligned};
+    for (uint64_t size : {30000U, 250000U, 70000U})
+    {
+        blocks.push_back(manager.getChunk(size));
+    }
+    // 先释放中间的块，再释放两侧：每次释放都要与前后空闲块合并
+    manager.releaseChunk(blocks[1]);
+    manager.releaseChunk(blocks[3]);
+    manager.releaseChunk(blocks[0]);
+    manager.releaseChunk(blocks[2]);
+    check(heap.getUsedBytes() == 0U && heap.getAllocatedBlocks() == 0U, "全部释放后已用字节归零");
+    check(manager.getLargestFreeLargeChunk() == initialLargest, "释放后相邻空闲块合并回一个块");
+
+    // ==================== 2. 持锁进程死亡后恢复 ====================
+    std::cout << "\n[2] 持锁进程死亡后恢复" << std::endl;
+    std::mt19937 rng(20261016U);
+    const uint32_t baselineFill = fillAndDrain(manager, kChurnSize);
+    uint32_t rounds = 0U;
+    bool allocationsKeptWorking = true;
+    while (rounds < kMaxKillRounds && heap.getLockRecoveries() < 3U)
+    {
+        killChurnAtRandomPoint(manager, argv[0], rng);
+        ++rounds;
+        ChunkManager* probe = manager.getChunk(kChurnSize);
+        allocationsKeptWorking = allocationsKeptWorking && probe != nullptr && manager.releaseChunk(probe);
+    }
+    std::cout << "  杀死 " << rounds << " 个子进程，恢复 " << heap.getLockRecoveries() << " 次" << std::endl;
+    check(heap.getLockRecoveries() > 0U, "子进程死在堆锁内时下一个加锁者接管了锁");
+    check(!heap.isCorrupted(), "重建后堆可用");
+    check(allocationsKeptWorking, "每次杀死子进程后仍可分配和释放");
+    // 死在分配或释放的两步之间（块已切出但尚未记账、已销账但尚未归还）的块会泄漏，其余全部经账本回收
+    const uint32_t leakedBlocks = heap.getAllocatedBlocks();
+    std::cout << "  泄漏 " << leakedBlocks << " 个块" << std::endl;
+    check(leakedBlocks <= 2U * rounds, "泄漏不超过被杀死进程同时持有的块数");
+    const uint64_t usedBeforeFill = heap.getUsedBytes();
+    const uint64_t largestBeforeFill = manager.getLargestFreeLargeChunk();
+    const uint32_t fill = fillAndDrain(manager, kChurnSize);
+    check(fill + 2U * leakedBlocks >= baselineFill, "重建后的空闲链表覆盖全部空闲空间");
+    check(heap.getUsedBytes() == usedBeforeFill && manager.getLargestFreeLargeChunk() == largestBeforeFill,
+          "填满再释放后恢复到相同的空闲结构");
+
+    // ==================== 3. 物理块链损坏 ====================
+    std::cout << "\n[3] 物理块链损坏" << std::endl;
+    ChunkManager* victim = manager.getChunk(kChurnSize);
+    if (victim == nullptr)
+    {
+        std::cout << "  ✗ 分配大块失败" << std::endl;
+        return 1;
+    }
+    // TLSF 块头位于 ChunkHeader 之前一个粒度，其中第二个字是块大小和空闲标志：
+    // 写入一个小于最小块的大小（仍标记为已分配，其他进程的合并不会把它当成空闲块）
+    auto* blockHeader = reinterpret_cast<uint64_t*>(reinterpret_cast<char*>(manager.getChunkHeader(victim))
+                                                    - TlsfHeap::kBlockHeaderSize);
+    blockHeader[1] = 2U;
+    rounds = 0U;
+    while (rounds < kMaxKillRounds && !heap.isCorrupted())
+    {
+        killChurnAtRandomPoint(manager, argv[0], rng);
+        ++rounds;
+    }
+    check(heap.isCorrupted(), "持锁者死亡后发现块链损坏，堆被标记为不可用");
+    check(manager.getChunk(kChurnSize) == nullptr, "不可用的堆拒绝分配");
+    check(heap.getFailedAllocations() > 0U, "失败的分配被计数");
+    ChunkManager* small = manager.getChunk(kSmallChunkSize);
+    check(small != nullptr && manager.releaseChunk(small), "普通池不受影响");
+
+    MemPoolManager::destroySharedInstance();
+    std::cout << (failures == 0 ? "\n全部通过" : "\n存在失败项") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -2,9 +2,12 @@
 #include <cstdlib>
 #include <csignal>
 #include <atomic>
+#include <cstring>
 
 #include "zerocp_daemon/diroute/diroute_memory_manager.hpp"
 #include "zerocp_daemon/communication/include/diroute.hpp"
+#include "zerocp_daemon/memory/include/mempool_config.hpp"
+#include "zerocp_daemon/memory/include/mempool_manager.hpp"
 
 // 全局运行标志，用于信号处理
 static std::atomic<bool> g_keepRunning{true};
@@ -26,8 +29,49 @@ void signalHandler(int signal)
 
 int main(int argc, char *argv[])
 {
-    (void)argc;
-    (void)argv;
+    // 可选启动参数：
+    //   --prefault[=线程数]  启动时预取共享内存段的所有页（默认使用硬件并发数个线程）
+    //   --mlock             启动时锁定共享内存段
+    //   --numa=节点数        为每个 NUMA 节点复制一套默认内存池并绑定到该节点
+    //   --grow=段数          每个池运行时最多追加的段数（空闲 chunk 低于水位时由主循环追加）
+    //   --reclaim=秒         每隔若干秒把冷的空闲 chunk 的物理页还给内核
+    bool prefaultSegments = false;
+    uint32_t prefaultThreads = 0;
+    bool lockSegments = false;
+    uint32_t numaNodes = 1;
+    uint32_t growthSegments = 0;
+    uint32_t reclaimIntervalSeconds = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--prefault", 10) == 0)
+        {
+            prefaultSegments = true;
+            if (argv[i][10] == '=')
+            {
+                prefaultThreads = static_cast<uint32_t>(std::strtoul(argv[i] + 11, nullptr, 10));
+            }
+        }
+        else if (std::strcmp(argv[i], "--mlock") == 0)
+        {
+            lockSegments = true;
+        }
+        else if (std::strncmp(argv[i], "--numa=", 7) == 0)
+        {
+            numaNodes = static_cast<uint32_t>(std::strtoul(argv[i] + 7, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--grow=", 7) == 0)
+        {
+            growthSegments = static_cast<uint32_t>(std::strtoul(argv[i] + 7, nullptr, 10));
+        }
+        else if (std::strncmp(argv[i], "--reclaim=", 10) == 0)
+        {
+            reclaimIntervalSeconds = static_cast<uint32_t>(std::strtoul(argv[i] + 10, nullptr, 10));
+        }
+        else
+        {
+            std::cerr << "[Main Warn] Unknown argument: " << argv[i] << "\n";
+        }
+    }
 
     std::cout << "=== Diroute Daemon: Starting ===\n\n";
 
@@ -52,6 +96,29 @@ int main(int argc, char *argv[])
     std::cout << "[Main] Memory pool initialized: " 
               << (memoryManager.isInitialized() ? "YES" : "NO") << "\n\n";
 
+    // 创建数据面 chunk 内存池（守护进程持有所有权，应用进程通过 attachToSharedInstance 连接）
+    // 路由时守护进程需要通过 ChunkManager 索引调整 chunk 的引用计数
+    std::cout << "[Main] Creating chunk memory pools...\n";
+    ZeroCP::Memory::MemPoolConfig memPoolConfig;
+    memPoolConfig.setdefaultPool();
+    for (auto& entry : memPoolConfig.m_memPoolEntries)
+    {
+        entry.m_maxGrowthSegments = growthSegments;
+    }
+    if (numaNodes > 1 && !memPoolConfig.replicatePoolsForNumaNodes(numaNodes))
+    {
+        std::cerr << "[Main Warn] Cannot replicate pools for " << numaNodes << " NUMA nodes, using a single node\n";
+    }
+    memPoolConfig.m_prefaultSegments = prefaultSegments;
+    memPoolConfig.m_prefaultThreads = prefaultThreads;
+    memPoolConfig.m_lockSegments = lockSegments;
+    if (!ZeroCP::Memory::MemPoolManager::createSharedInstance(memPoolConfig))
+    {
+        std::cerr << "[Main Error] Failed to create chunk memory pools\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "[Main] Chunk memory pools initialized\n\n";
+
     // 为守护进程注册心跳槽位（守护进程持有此槽位证明自己存活）
     auto& heartbeatPool = memoryManager.getHeartbeatPool();
     auto daemonSlot = heartbeatPool.emplace();
@@ -82,7 +149,10 @@ int main(int argc, char *argv[])
     std::cout << "[Daemon] Press Ctrl+C to shutdown gracefully\n\n";
 
     constexpr int HEARTBEAT_INTERVAL_MS = 1000;  // 每 1 秒更新一次心跳
+    constexpr uint32_t GROWTH_FREE_PERCENT = 10;  // 池的空闲 chunk 低于 10% 时追加一个段
     int loopCount = 0;
+    uint32_t reclaimLoopCount = 0;
+    auto* chunkPools = ZeroCP::Memory::MemPoolManager::getInstanceIfInitialized();
 
     while (g_keepRunning.load(std::memory_order_acquire))
     {
@@ -96,6 +166,27 @@ int main(int argc, char *argv[])
             loopCount = 0;
         }
 
+        // 应用进程不能自己扩容：由守护进程在池快要耗尽前追加段，应用进程第一次用到新段时自动映射
+        if (growthSegments > 0 && chunkPools != nullptr)
+        {
+            chunkPools->growPoolsBelowWatermark(GROWTH_FREE_PERCENT);
+        }
+
+        // 每次循环采样已使用峰值（据此判断 LIFO 复用深度），按周期回收冷 chunk 的物理页
+        if (reclaimIntervalSeconds > 0 && chunkPools != nullptr)
+        {
+            chunkPools->sampleChunkUsage();
+            if (++reclaimLoopCount >= reclaimIntervalSeconds * 10)
+            {
+                const uint64_t releasedBytes = chunkPools->reclaimIdleChunks();
+                if (releasedBytes > 0)
+                {
+                    std::cout << "[Daemon] Reclaimed " << (releasedBytes >> 10) << " KiB of idle chunk memory\n";
+                }
+                reclaimLoopCount = 0;
+            }
+        }
+
         if (g_manualDumpRequested.exchange(false, std::memory_order_acq_rel))
         {
             std::cout << "[Signal] Manual dump requested (SIGUSR1)\n";
@@ -116,6 +207,10 @@ int main(int argc, char *argv[])
     heartbeatPool.release(daemonSlot);
     std::cout << "[Daemon] Daemon heartbeat slot released\n";
 
+    // 销毁数据面 chunk 内存池
+    std::cout << "[Daemon] Destroying chunk memory pools...\n";
+    ZeroCP::Memory::MemPoolManager::destroySharedInstance();
+
     // 通过 RAII 自动清理资源
     std::cout << "[Daemon] Cleaning up resources:\n";
     std::cout << "[Daemon]   - Destroying HeartbeatPool\n";
@@ -7,6 +7,8 @@
 #include "runtime/process_manager.hpp"
 #include "runtime/message_runtime.hpp"
 #include "service_description.hpp"
+#include "zerocp_daemon/memory/include/receive_queue.hpp"
+#include "zerocp_daemon/memory/include/publisher_port.hpp"
 #include <thread>
 #include <atomic>
 #include <memory>
@@ -16,6 +18,11 @@
 #include <set>
 namespace ZeroCP
 {
+namespace Memory
+{
+struct ChunkManager;
+}
+
 // RuntimeName_t 已在 process_manager.hpp 中定义为 string<108>
 namespace Diroute
 {
@@ -60,11 +67,14 @@ private:
         RuntimeName_t processName;      // 发布者进程名称
         ServiceDescription serviceDesc; // 服务描述（service, instance, event）
         uint64_t slotIndex;              // 心跳槽位索引
+        uint64_t publisherPortIndex;     // 发布者端口在 PublisherPortPool 中的索引
+        uint64_t publisherPortOffset;    // 发布者端口相对于 DirouteComponents 的偏移量
         uint32_t pid;                   // 进程 ID
         
         PublisherInfo(const RuntimeName_t& name, const ServiceDescription& desc, 
-                     uint64_t slot, uint32_t processId) noexcept
-            : processName(name), serviceDesc(desc), slotIndex(slot), pid(processId)
+                     uint64_t slot, uint64_t portIndex, uint64_t portOffset, uint32_t processId) noexcept
+            : processName(name), serviceDesc(desc), slotIndex(slot),
+              publisherPortIndex(portIndex), publisherPortOffset(portOffset), pid(processId)
         {
         }
     };
@@ -75,13 +85,14 @@ private:
         RuntimeName_t processName;      // 订阅者进程名称
         ServiceDescription serviceDesc; // 服务描述（service, instance, event）
         uint64_t slotIndex;              // 心跳槽位索引
-        uint64_t receiveQueueOffset;     // 接收队列在共享内存中的偏移量
+        uint64_t receiveQueueIndex;      // 接收队列在 ReceiveQueuePool 中的索引
+        uint64_t receiveQueueOffset;     // 接收队列相对于 DirouteComponents 的偏移量
         uint32_t pid;                   // 进程 ID
         
         SubscriberInfo(const RuntimeName_t& name, const ServiceDescription& desc,
-                      uint64_t slot, uint64_t queueOffset, uint32_t processId) noexcept
+                      uint64_t slot, uint64_t queueIndex, uint64_t queueOffset, uint32_t processId) noexcept
             : processName(name), serviceDesc(desc), slotIndex(slot), 
-              receiveQueueOffset(queueOffset), pid(processId)
+              receiveQueueIndex(queueIndex), receiveQueueOffset(queueOffset), pid(processId)
         {
         }
     };
@@ -89,36 +100,80 @@ private:
     void handleProcessRegistration(const ZeroCP::Runtime::RuntimeMessage& message,
                                     ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept;
     
-    /// @brief 处理 Publisher 注册
+    /// @brief 处理 Publisher 注册（为发布者分配共享内存端口，并填入已匹配的接收队列）
     /// @param message 格式: "PUBLISHER:<processName>:<pid>:<service>:<instance>:<event>"
+    /// @note 响应格式: "OK:PUBLISHER_REGISTERED:PORT_OFFSET:<offset>"，
+    ///       之后发布者直接向端口中列出的接收队列投递，不再经过守护进程
     void handlePublisherRegistration(const ZeroCP::Runtime::RuntimeMessage& message,
                                      ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept;
     
-    /// @brief 处理 Subscriber 注册
+    /// @brief 处理 Subscriber 注册（为订阅者分配共享内存接收队列）
     /// @param message 格式: "SUBSCRIBER:<processName>:<pid>:<service>:<instance>:<event>"
+    /// @note 响应格式: "OK:SUBSCRIBER_REGISTERED:QUEUE_OFFSET:<offset>"，
+    ///       offset 为接收队列相对于 DirouteComponents 共享内存起始地址的字节偏移
     void handleSubscriberRegistration(const ZeroCP::Runtime::RuntimeMessage& message,
                                       ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept;
     
-    /// @brief 处理消息路由（从 Publisher 到 Subscriber）
-    /// @param message 格式: "ROUTE:<publisherName>:<service>:<instance>:<event>:<chunkOffset>:<chunkSize>:<payloadSize>"
+    /// @brief 处理 Publisher 注销（Publisher 析构时发送），回收其端口
+    /// @param message 格式: "UNPUBLISH:<processName>:<pid>:<portOffset>"
+    /// @note 响应格式: "OK:UNPUBLISHED"
+    void handlePublisherUnregistration(const ZeroCP::Runtime::RuntimeMessage& message,
+                                       ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept;
+    
+    /// @brief 处理 Subscriber 注销（Subscriber 析构时发送）：队列从端口摘除，投递结束后清空并回收
+    /// @param message 格式: "UNSUBSCRIBE:<processName>:<pid>:<queueOffset>"
+    /// @note 响应格式: "OK:UNSUBSCRIBED"
+    void handleSubscriberUnregistration(const ZeroCP::Runtime::RuntimeMessage& message,
+                                        ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept;
+    
+    /// @brief 解析注销消息 "<command>:<processName>:<pid>:<offset>"
+    static bool parseUnregistration(const ZeroCP::Runtime::RuntimeMessage& message, const char* expectedCommand,
+                                    RuntimeName_t& processName, uint32_t& pid, uint64_t& offset) noexcept;
+    
+    /// @brief 处理消息路由（从 Publisher 到 Subscriber，经守护进程转发的兼容路径）
+    /// @param message 格式: "ROUTE:<publisherName>:<service>:<instance>:<event>:<chunkManagerIndex>:<chunkSize>:<payloadSize>"
+    /// @note 发布者须先调用 SharedChunk::prepareForTransfer() 把一个引用转交给守护进程，
+    ///       守护进程为每个成功入队的订阅者增加一个引用，最后归还发布者转交的引用
     void handleMessageRouting(const ZeroCP::Runtime::RuntimeMessage& message,
                               ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept;
     
     /// @brief 匹配 Publisher 和 Subscriber
     /// @param serviceDesc 服务描述
     /// @return 匹配的 Subscriber 列表
+    /// @note 调用者必须持有 m_pubSubMutex
     std::vector<SubscriberInfo*> matchSubscribers(const ServiceDescription& serviceDesc) noexcept;
     
-    /// @brief 将消息路由到订阅者的接收队列
+    /// @brief 将 chunk 引用写入订阅者的接收队列
     /// @param subscriber 订阅者信息
-    /// @param chunkOffset chunk 在共享内存中的偏移量
-    /// @param chunkSize chunk 大小
-    /// @param payloadSize 用户数据大小
-    /// @param publisherName 发布者名称
-    /// @return 成功返回 true
+    /// @param chunkManager 要投递的 chunk（入队成功时为订阅者增加一个引用）
+    /// @param publisherSlot 发布者的心跳槽位索引
+    /// @return 成功返回 true，接收队列满或不存在返回 false
     bool routeMessageToSubscriber(const SubscriberInfo& subscriber,
-                                  uint64_t chunkOffset, uint64_t chunkSize, uint64_t payloadSize,
-                                  const RuntimeName_t& publisherName) noexcept;
+                                  Memory::ChunkManager* chunkManager,
+                                  uint64_t publisherSlot) noexcept;
+    
+    /// @brief 取出接收队列中所有未消费的条目并释放其 chunk 引用
+    void drainReceiveQueue(zerocp::memory::ReceiveQueue& queue) noexcept;
+    
+    /// @brief 已从发布者端口摘除、等待回收的接收队列
+    struct RetiredReceiveQueue
+    {
+        uint64_t receiveQueueIndex;                                   // 接收队列在 ReceiveQueuePool 中的索引
+        std::vector<const zerocp::memory::PublisherPort*> pendingPorts; // 摘除时含有该队列、尚未观察到静默的端口
+    };
+    
+    /// @brief 把接收队列从所有发布者端口摘除，记入待回收列表
+    /// @note 调用者必须持有 m_pubSubMutex；队列在 releaseQuiescentReceiveQueues 中回收
+    void retireReceiveQueue(uint64_t receiveQueueIndex) noexcept;
+    
+    /// @brief 回收发布者端口，并不再等待它上面的投递
+    /// @note 调用者必须持有 m_pubSubMutex；只用于发布者已不再投递（已注销或已死亡）之后
+    void releasePublisherPort(uint64_t publisherPortIndex) noexcept;
+    
+    /// @brief 回收所有相关端口都已静默的待回收接收队列（清空未消费的条目后归还队列池）
+    /// @note 不得持有 m_pubSubMutex 或 m_processesMutex：端口状态在锁外检查，
+    ///       仍有投递进行中的队列留到下一次心跳检查，绝不提前回收
+    void releaseQuiescentReceiveQueues() noexcept;
     
     void startHeartbeatMonitorThread() noexcept;
     void heartbeatMonitorThreadFunc() noexcept;
@@ -135,10 +190,13 @@ private:
     // 进程注册信息
     std::unordered_map<uint64_t, ProcessInfo> m_registeredProcesses;
     mutable std::mutex m_processesMutex;
+    // 心跳超时但仍存在的进程：退出后再回收它持有的 chunk（只由心跳线程访问）
+    std::vector<uint32_t> m_pendingChunkReclaims;
     
     // Publisher/Subscriber 注册信息
     std::vector<PublisherInfo> m_publishers;
     std::vector<SubscriberInfo> m_subscribers;
+    std::vector<RetiredReceiveQueue> m_retiredReceiveQueues;
     mutable std::mutex m_pubSubMutex;
     
     // 序列号生成器（用于消息去重）
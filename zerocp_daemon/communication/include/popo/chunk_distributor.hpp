@@ -0,0 +1,43 @@
+#ifndef ZEROCP_CHUNK_DISTRIBUTOR_HPP
+#define ZEROCP_CHUNK_DISTRIBUTOR_HPP
+
+#include "zerocp_daemon/memory/include/publisher_port.hpp"
+#include "zerocp_daemon/memory/include/receive_queue_pool.hpp"
+#include "zerocp_daemon/mempool/shared_chunk.hpp"
+#include <cstdint>
+
+namespace ZeroCP
+{
+namespace Popo
+{
+
+/// @brief 发布者侧的 chunk 分发器（无代理数据面）
+/// @details 守护进程只负责服务发现，把匹配订阅者的接收队列登记到 PublisherPort；
+///          发布者读取端口中的队列集合，为每个队列调用 SharedChunk::prepareForTransfer()
+///          转交一个引用，然后直接把 ChunkManager 索引写入队列。
+///          整个过程只有几次原子操作，不经过守护进程，也没有系统调用。
+class ChunkDistributor
+{
+public:
+    /// @param port 发布者端口（位于 DirouteComponents 共享内存中）
+    /// @param queuePool 接收队列池（位于 DirouteComponents 共享内存中）
+    ChunkDistributor(zerocp::memory::PublisherPort* port,
+                     zerocp::memory::ReceiveQueuePool* queuePool) noexcept;
+
+    /// @brief 把 chunk 投递到所有已匹配的接收队列
+    /// @param chunk 要投递的 chunk（调用者保留自己的引用）
+    /// @return 成功入队的订阅者数量
+    uint64_t deliver(Memory::SharedChunk& chunk) noexcept;
+
+    /// @brief 检查分发器是否已连接到端口
+    bool isValid() const noexcept { return m_port != nullptr && m_queuePool != nullptr; }
+
+private:
+    zerocp::memory::PublisherPort* m_port{nullptr};
+    zerocp::memory::ReceiveQueuePool* m_queuePool{nullptr};
+};
+
+} // namespace Popo
+} // namespace ZeroCP
+
+#endif // ZEROCP_CHUNK_DISTRIBUTOR_HPP
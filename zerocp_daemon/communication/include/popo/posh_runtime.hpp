@@ -5,6 +5,10 @@
 #include "runtime/ipc_interface_creator.hpp"
 #include "zerocp_foundationLib/posix/memory/include/posix_sharedmemory_object.hpp"
 #include "zerocp_daemon/memory/include/heartbeat.hpp"
+#include "zerocp_daemon/memory/include/receive_queue_pool.hpp"
+#include "zerocp_daemon/memory/include/publisher_port.hpp"
+#include "zerocp_daemon/memory/include/mempool_manager.hpp"
+#include "service_description.hpp"
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -54,6 +58,48 @@ public:
     bool sendMessage(const std::string& message) noexcept;
     bool isConnected() const noexcept;
     
+    /**
+     * @brief 向守护进程注册订阅者，并定位其在共享内存中的接收队列
+     * @param serviceDesc 订阅的服务描述
+     * @return 接收队列指针（位于 DirouteComponents 共享内存中），失败返回 nullptr
+     * @note 注册完成后，订阅者直接对返回的队列 pop()，不再经过任何系统调用
+     */
+    zerocp::memory::ReceiveQueue* registerSubscriber(const ServiceDescription& serviceDesc) noexcept;
+    
+    /**
+     * @brief 向守护进程注册发布者，并定位其在共享内存中的端口
+     * @param serviceDesc 发布的服务描述
+     * @return 发布者端口指针（位于 DirouteComponents 共享内存中），失败返回 nullptr
+     * @note 端口中列出了已匹配订阅者的接收队列，由守护进程随订阅者上下线更新
+     */
+    zerocp::memory::PublisherPort* registerPublisher(const ServiceDescription& serviceDesc) noexcept;
+    
+    /**
+     * @brief 注销订阅者：守护进程把接收队列从发布者端口摘除，投递结束后清空未消费的条目并回收队列
+     * @param receiveQueue registerSubscriber 返回的接收队列（注销后不得再访问）
+     * @return 守护进程确认注销返回 true
+     */
+    bool unregisterSubscriber(const zerocp::memory::ReceiveQueue* receiveQueue) noexcept;
+    
+    /**
+     * @brief 注销发布者：守护进程回收端口，不再向其中登记接收队列
+     * @param publisherPort registerPublisher 返回的端口（注销后不得再投递）
+     * @return 守护进程确认注销返回 true
+     */
+    bool unregisterPublisher(const zerocp::memory::PublisherPort* publisherPort) noexcept;
+    
+    /**
+     * @brief 获取共享内存中的接收队列池（发布者据此定位端口中列出的队列）
+     * @return 接收队列池指针，共享内存未打开时返回 nullptr
+     */
+    zerocp::memory::ReceiveQueuePool* getReceiveQueuePool() noexcept;
+    
+    /**
+     * @brief 获取数据面 chunk 内存池（首次调用时连接守护进程创建的共享内存）
+     * @return MemPoolManager 指针，守护进程未创建内存池时返回 nullptr
+     */
+    Memory::MemPoolManager* getMemPoolManager() noexcept;
+    
     // 心跳相关
     void startHeartbeat() noexcept;
     void stopHeartbeat() noexcept;
@@ -66,6 +112,18 @@ private:
     bool registerToRouteD() noexcept;
     bool receiveRouteDAck() noexcept;
     
+    /// @brief 发送一条控制消息并等待守护进程的响应
+    bool requestResponse(const std::string& request, std::string& response) noexcept;
+    
+    /// @brief 发送注册请求并解析响应中的偏移量
+    /// @param request 注册请求
+    /// @param expectedPrefix 成功响应的前缀（后接十进制偏移量）
+    /// @param offset 输出参数，解析出的偏移量
+    bool requestOffset(const std::string& request, const std::string& expectedPrefix, uint64_t& offset) noexcept;
+    
+    /// @brief 发送注销请求（"<command>:<processName>:<pid>:<offset>"），等待以 "OK:" 开头的响应
+    bool requestUnregister(const char* command, uint64_t offset) noexcept;
+    
     // 心跳相关私有方法
     bool openHeartbeatSharedMemory() noexcept;
     bool registerHeartbeatSlot(uint64_t slotIndex) noexcept;
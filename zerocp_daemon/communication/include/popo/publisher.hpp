@@ -2,20 +2,88 @@
 #define PUBLISHER_HPP
 
 #include "service_description.hpp"
+#include "popo/sample.hpp"
+#include "popo/chunk_distributor.hpp"
+#include "zerocp_daemon/memory/include/mempool_manager.hpp"
+#include <cstdint>
+#include <expected>
+#include <type_traits>
 
 namespace ZeroCP
 {
-   
+
+/// @brief Publisher 错误类型
+enum class PublisherError
+{
+    NOT_OFFERED,            ///< 注册失败，端口不可用
+    MEMPOOL_NOT_AVAILABLE,  ///< 数据面内存池未连接
+    OUT_OF_CHUNKS,          ///< 没有满足大小/对齐要求的空闲 chunk
+    INVALID_SAMPLE          ///< 发布了空的 Sample
+};
+
+/// @brief 类型化零拷贝发布者
+/// @tparam T 消息类型
+/// @details 使用方式：
+/// @code
+/// ZeroCP::Publisher<RadarObject> publisher(serviceDesc);
+/// auto sample = publisher.loan(1.0, 2.0);   // 在 chunk 中原地构造 T
+/// sample.value()->x = 3.0;
+/// publisher.publish(std::move(sample.value()));  // 只转交 chunk 索引，无拷贝
+/// @endcode
+/// @note 订阅进程不会调用 T 的析构函数，且各进程映射地址不同，
+///       因此 T 必须可平凡析构，且不能包含指向进程本地内存的指针
 template<typename T>
 class Publisher
 {
+    static_assert(std::is_trivially_destructible_v<T>, "T must be trivially destructible to be shared across processes");
 
 public:
-    explicit Publisher(ServiceDescription& serviceDescription) noexcept;
+    /// @brief chunk 中为 T 预留的大小与对齐（编译期确定）
+    static constexpr uint64_t kPayloadSize = sizeof(T);
+    static constexpr uint32_t kPayloadAlignment = alignof(T);
+
+    /// @brief 向守护进程注册并获取发布者端口（每个 Publisher 独占一个端口）
+    /// @param serviceDescription 发布的服务描述
+    /// @param reservedChunks 为本发布者预留的 chunk 数：同时借出不超过该数量时 loan() 不会因共享池耗尽而失败
+    /// @note 需要先调用 PoshRuntime::initRuntime()；预留失败（池不足或超出进程配额）时只告警，发布者仍可使用共享池
+    explicit Publisher(const ServiceDescription& serviceDescription, uint32_t reservedChunks = 0U) noexcept;
+
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+    Publisher(Publisher&&) = delete;
+    Publisher& operator=(Publisher&&) = delete;
+    /// @brief 向守护进程注销端口，并取消预留
+    ~Publisher() noexcept;
+
+    /// @brief 借出一个 chunk，并在其中原地构造 T
+    /// @param args 传给 T 构造函数的参数
+    /// @return 指向 chunk 中 T 的 Sample，失败返回错误
+    template<typename... Args>
+    std::expected<Sample<T>, PublisherError> loan(Args&&... args) noexcept;
+
+    /// @brief 发布 Sample：把 chunk 索引直接写入所有匹配订阅者的接收队列
+    /// @param sample 通过 loan() 得到的 Sample（发布后被消费）
+    /// @return 成功入队的订阅者数量
+    std::expected<uint64_t, PublisherError> publish(Sample<T>&& sample) noexcept;
+
+    /// @brief 检查发布者是否已在守护进程注册成功
+    bool isOffered() const noexcept { return m_distributor.isValid(); }
+
+    /// @brief 实际预留成功的 chunk 数
+    uint32_t getReservedChunks() const noexcept { return m_reservedChunks; }
+
+    const ServiceDescription& getServiceDescription() const noexcept { return m_serviceDescription; }
 
 private:
+    ServiceDescription m_serviceDescription;
+    Memory::MemPoolManager* m_memPoolManager{nullptr};
+    uint32_t m_reservedChunks{0U};
+    zerocp::memory::PublisherPort* m_port{nullptr};
+    Popo::ChunkDistributor m_distributor;
 };
 
-}
+} // namespace ZeroCP
+
+#include "popo/publisher.inl"
 
-#endif
\ No newline at end of file
+#endif // PUBLISHER_HPP
@@ -0,0 +1,102 @@
+// publisher.inl - Publisher 模板类实现
+// 此文件由 publisher.hpp 包含
+
+#include "popo/posh_runtime.hpp"
+#include "zerocp_foundationLib/report/include/logging.hpp"
+#include <new>
+#include <utility>
+
+namespace ZeroCP
+{
+
+template<typename T>
+Publisher<T>::Publisher(const ServiceDescription& serviceDescription, uint32_t reservedChunks) noexcept
+    : m_serviceDescription(serviceDescription)
+    , m_distributor(nullptr, nullptr)
+{
+    auto& runtime = Runtime::PoshRuntime::getInstance();
+
+    m_memPoolManager = runtime.getMemPoolManager();
+    if (m_memPoolManager == nullptr)
+    {
+        ZEROCP_LOG(Error, "Publisher: chunk memory pool is not available");
+        return;
+    }
+
+    m_port = runtime.registerPublisher(m_serviceDescription);
+    if (m_port == nullptr)
+    {
+        ZEROCP_LOG(Error, "Publisher: registration failed for "
+                   << m_serviceDescription.getService().c_str() << "/"
+                   << m_serviceDescription.getInstance().c_str() << "/"
+                   << m_serviceDescription.getEvent().c_str());
+        return;
+    }
+
+    m_distributor = Popo::ChunkDistributor(m_port, runtime.getReceiveQueuePool());
+
+    if (reservedChunks > 0U)
+    {
+        if (m_memPoolManager->reserveChunks(kPayloadSize, reservedChunks, kPayloadAlignment))
+        {
+            m_reservedChunks = reservedChunks;
+        }
+        else
+        {
+            ZEROCP_LOG(Warn, "Publisher: could not reserve " << reservedChunks << " chunk(s), using the shared pool");
+        }
+    }
+}
+
+template<typename T>
+Publisher<T>::~Publisher() noexcept
+{
+    if (m_port != nullptr)
+    {
+        Runtime::PoshRuntime::getInstance().unregisterPublisher(m_port);
+        m_port = nullptr;
+    }
+    if (m_reservedChunks > 0U && m_memPoolManager != nullptr)
+    {
+        m_memPoolManager->cancelReservation(kPayloadSize, m_reservedChunks, kPayloadAlignment);
+    }
+}
+
+template<typename T>
+template<typename... Args>
+std::expected<Sample<T>, PublisherError> Publisher<T>::loan(Args&&... args) noexcept
+{
+    if (m_memPoolManager == nullptr)
+    {
+        return std::unexpected(PublisherError::MEMPOOL_NOT_AVAILABLE);
+    }
+
+    Memory::SharedChunk chunk(m_memPoolManager->getChunk(kPayloadSize, kPayloadAlignment), m_memPoolManager);
+    if (!chunk)
+    {
+        return std::unexpected(PublisherError::OUT_OF_CHUNKS);
+    }
+
+    // 在共享内存中的用户数据区原地构造 T
+    T* payload = new (chunk.getUserPayload()) T(std::forward<Args>(args)...);
+    return Sample<T>(std::move(chunk), payload);
+}
+
+template<typename T>
+std::expected<uint64_t, PublisherError> Publisher<T>::publish(Sample<T>&& sample) noexcept
+{
+    if (!sample)
+    {
+        return std::unexpected(PublisherError::INVALID_SAMPLE);
+    }
+    if (!isOffered())
+    {
+        return std::unexpected(PublisherError::NOT_OFFERED);
+    }
+
+    // 订阅者各自持有转交的引用；发布者的引用随 chunk 析构归还
+    Memory::SharedChunk chunk = sample.releaseChunk();
+    return m_distributor.deliver(chunk);
+}
+
+} // namespace ZeroCP
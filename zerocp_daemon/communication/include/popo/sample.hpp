@@ -0,0 +1,78 @@
+#ifndef ZEROCP_SAMPLE_HPP
+#define ZEROCP_SAMPLE_HPP
+
+#include "zerocp_daemon/mempool/shared_chunk.hpp"
+#include "zerocp_daemon/memory/include/chunk_header.hpp"
+#include <utility>
+
+namespace ZeroCP
+{
+
+/// @brief 指向共享内存 chunk 中用户数据的句柄（零拷贝）
+/// @tparam T 用户数据类型（订阅端使用 const T）
+/// @details Sample 持有 chunk 的一个引用，析构时归还；
+///          payload 指针指向 chunk 内部，访问数据不涉及任何拷贝
+/// @note 只能移动不能拷贝：发布端的 loan 在 publish() 时被消费
+template<typename T>
+class Sample
+{
+public:
+    Sample() noexcept = default;
+
+    /// @param chunk 接管的 chunk 引用
+    /// @param payload chunk 中用户数据的地址（本进程地址空间）
+    Sample(Memory::SharedChunk&& chunk, T* payload) noexcept
+        : m_chunk(std::move(chunk))
+        , m_payload(payload)
+    {
+    }
+
+    Sample(const Sample&) = delete;
+    Sample& operator=(const Sample&) = delete;
+
+    Sample(Sample&& other) noexcept
+        : m_chunk(std::move(other.m_chunk))
+        , m_payload(std::exchange(other.m_payload, nullptr))
+    {
+    }
+
+    Sample& operator=(Sample&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_chunk = std::move(other.m_chunk);
+            m_payload = std::exchange(other.m_payload, nullptr);
+        }
+        return *this;
+    }
+
+    ~Sample() noexcept = default;
+
+    T* operator->() const noexcept { return m_payload; }
+    T& operator*() const noexcept { return *m_payload; }
+    T* get() const noexcept { return m_payload; }
+
+    /// @brief 检查 Sample 是否持有数据
+    explicit operator bool() const noexcept { return m_payload != nullptr; }
+
+    /// @brief 获取 chunk 头（包含发布者槽位、序列号等元数据）
+    const Memory::ChunkHeader* getChunkHeader() const noexcept { return m_chunk.getChunkheader(); }
+
+    /// @brief 获取用户头（池配置了用户头时有效，否则返回 nullptr）
+    void* getUserHeader() const noexcept { return m_chunk.getUserHeader(); }
+
+    /// @brief 交出底层 chunk 引用（Sample 随后变为空）
+    Memory::SharedChunk releaseChunk() noexcept
+    {
+        m_payload = nullptr;
+        return std::move(m_chunk);
+    }
+
+private:
+    Memory::SharedChunk m_chunk;
+    T* m_payload{nullptr};
+};
+
+} // namespace ZeroCP
+
+#endif // ZEROCP_SAMPLE_HPP
@@ -0,0 +1,89 @@
+#ifndef SUBSCRIBER_HPP
+#define SUBSCRIBER_HPP
+
+#include "service_description.hpp"
+#include "popo/sample.hpp"
+#include "zerocp_daemon/memory/include/receive_queue.hpp"
+#include "zerocp_daemon/memory/include/mempool_manager.hpp"
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <type_traits>
+
+namespace ZeroCP
+{
+
+/// @brief Subscriber 错误类型
+enum class SubscriberError
+{
+    NOT_SUBSCRIBED,         ///< 注册失败，接收队列不可用
+    MEMPOOL_NOT_AVAILABLE,  ///< 数据面内存池未连接
+    NO_DATA,                ///< 接收队列为空
+    INVALID_CHUNK           ///< 队列条目无法解析为 T（索引越界或数据过小）
+};
+
+/// @brief 类型化零拷贝订阅者
+/// @tparam T 消息类型（与 Publisher<T> 一致）
+/// @details 使用方式：
+/// @code
+/// ZeroCP::Subscriber<RadarObject> subscriber(serviceDesc);
+/// if (auto sample = subscriber.take())
+/// {
+///     process(sample.value()->x);
+/// }   // Sample 析构时通过 MemPoolManager::releaseChunk 归还引用
+/// @endcode
+template<typename T>
+class Subscriber
+{
+    static_assert(std::is_trivially_destructible_v<T>, "T must be trivially destructible to be shared across processes");
+
+public:
+    /// @brief takeBatch() 单次最多取出的条目数
+    static constexpr uint64_t kMaxBatchSize = 32U;
+
+    /// @brief 向守护进程注册并获取接收队列（每个 Subscriber 独占一个队列）
+    /// @param serviceDescription 订阅的服务描述
+    /// @note 需要先调用 PoshRuntime::initRuntime()
+    explicit Subscriber(const ServiceDescription& serviceDescription) noexcept;
+
+    Subscriber(const Subscriber&) = delete;
+    Subscriber& operator=(const Subscriber&) = delete;
+    Subscriber(Subscriber&&) = delete;
+    Subscriber& operator=(Subscriber&&) = delete;
+    /// @brief 向守护进程注销：接收队列从发布者端口摘除，其中未取出的条目由守护进程释放
+    ~Subscriber() noexcept;
+
+    /// @brief 取出一个 Sample
+    /// @return 指向 chunk 中 T 的只读 Sample，队列为空时返回 NO_DATA
+    std::expected<Sample<const T>, SubscriberError> take() noexcept;
+
+    /// @brief 批量取出 Sample：一次认领多个队列条目，并预取下一个 payload
+    /// @param samples 输出数组，最多填充 min(samples.size(), kMaxBatchSize) 个
+    /// @return 实际填充的 Sample 数量（无法解析的条目会被丢弃并释放）
+    uint64_t takeBatch(std::span<Sample<const T>> samples) noexcept;
+
+    /// @brief 检查接收队列中是否有数据（近似值）
+    bool hasData() const noexcept { return m_receiveQueue != nullptr && !m_receiveQueue->empty(); }
+
+    /// @brief 检查订阅者是否已在守护进程注册成功
+    bool isSubscribed() const noexcept { return m_receiveQueue != nullptr && m_memPoolManager != nullptr; }
+
+    const ServiceDescription& getServiceDescription() const noexcept { return m_serviceDescription; }
+
+private:
+    /// @brief 把队列条目转换为 Sample（接管发布者转交的引用）
+    Sample<const T> toSample(const zerocp::memory::ChunkQueueEntry& entry) noexcept;
+
+    /// @brief 预取条目对应 chunk 的 payload（header + m_userPayloadOffset）所在的 cache line
+    void prefetch(const zerocp::memory::ChunkQueueEntry& entry) const noexcept;
+
+    ServiceDescription m_serviceDescription;
+    Memory::MemPoolManager* m_memPoolManager{nullptr};
+    zerocp::memory::ReceiveQueue* m_receiveQueue{nullptr};
+};
+
+} // namespace ZeroCP
+
+#include "popo/subscriber.inl"
+
+#endif // SUBSCRIBER_HPP
@@ -0,0 +1,147 @@
+// subscriber.inl - Subscriber 模板类实现
+// 此文件由 subscriber.hpp 包含
+
+#include "popo/posh_runtime.hpp"
+#include "zerocp_daemon/memory/include/chunk_header.hpp"
+#include "zerocp_foundationLib/report/include/logging.hpp"
+#include <algorithm>
+
+namespace ZeroCP
+{
+
+template<typename T>
+Subscriber<T>::Subscriber(const ServiceDescription& serviceDescription) noexcept
+    : m_serviceDescription(serviceDescription)
+{
+    auto& runtime = Runtime::PoshRuntime::getInstance();
+
+    m_memPoolManager = runtime.getMemPoolManager();
+    if (m_memPoolManager == nullptr)
+    {
+        ZEROCP_LOG(Error, "Subscriber: chunk memory pool is not available");
+        return;
+    }
+
+    m_receiveQueue = runtime.registerSubscriber(m_serviceDescription);
+    if (m_receiveQueue == nullptr)
+    {
+        ZEROCP_LOG(Error, "Subscriber: registration failed for "
+                   << m_serviceDescription.getService().c_str() << "/"
+                   << m_serviceDescription.getInstance().c_str() << "/"
+                   << m_serviceDescription.getEvent().c_str());
+    }
+}
+
+template<typename T>
+Subscriber<T>::~Subscriber() noexcept
+{
+    if (m_receiveQueue != nullptr)
+    {
+        Runtime::PoshRuntime::getInstance().unregisterSubscriber(m_receiveQueue);
+        m_receiveQueue = nullptr;
+    }
+}
+
+template<typename T>
+std::expected<Sample<const T>, SubscriberError> Subscriber<T>::take() noexcept
+{
+    if (m_receiveQueue == nullptr)
+    {
+        return std::unexpected(SubscriberError::NOT_SUBSCRIBED);
+    }
+    if (m_memPoolManager == nullptr)
+    {
+        return std::unexpected(SubscriberError::MEMPOOL_NOT_AVAILABLE);
+    }
+
+    zerocp::memory::ChunkQueueEntry entry;
+    if (!m_receiveQueue->pop(entry))
+    {
+        return std::unexpected(SubscriberError::NO_DATA);
+    }
+
+    auto sample = toSample(entry);
+    if (!sample)
+    {
+        return std::unexpected(SubscriberError::INVALID_CHUNK);
+    }
+    return sample;
+}
+
+template<typename T>
+uint64_t Subscriber<T>::takeBatch(std::span<Sample<const T>> samples) noexcept
+{
+    if (!isSubscribed() || samples.empty())
+    {
+        return 0U;
+    }
+
+    zerocp::memory::ChunkQueueEntry entries[kMaxBatchSize];
+    const uint64_t maxCount = std::min<uint64_t>(samples.size(), kMaxBatchSize);
+    const uint64_t popped = m_receiveQueue->popBatch(entries, maxCount);
+
+    if (popped > 0U)
+    {
+        prefetch(entries[0]);
+    }
+
+    uint64_t taken = 0U;
+    for (uint64_t i = 0U; i < popped; ++i)
+    {
+        // 处理当前条目时，下一个 payload 的 cache line 已经在加载途中
+        if (i + 1U < popped)
+        {
+            prefetch(entries[i + 1U]);
+        }
+
+        auto sample = toSample(entries[i]);
+        if (sample)
+        {
+            samples[taken++] = std::move(sample);
+        }
+    }
+    return taken;
+}
+
+template<typename T>
+Sample<const T> Subscriber<T>::toSample(const zerocp::memory::ChunkQueueEntry& entry) noexcept
+{
+    // 发布者已经为本订阅者调用过 prepareForTransfer()，这里直接接管该引用
+    auto chunk = Memory::SharedChunk::fromIndex(entry.m_chunkManagerIndex, m_memPoolManager);
+    if (!chunk)
+    {
+        return Sample<const T>();
+    }
+
+    if (chunk.getSize() < sizeof(T))
+    {
+        ZEROCP_LOG(Error, "Subscriber: chunk " << entry.m_chunkManagerIndex << " payload too small ("
+                   << chunk.getSize() << " < " << sizeof(T) << "), dropping");
+        return Sample<const T>();
+    }
+
+    const T* payload = static_cast<const T*>(chunk.getUserPayload());
+    return Sample<const T>(std::move(chunk), payload);
+}
+
+template<typename T>
+void Subscriber<T>::prefetch(const zerocp::memory::ChunkQueueEntry& entry) const noexcept
+{
+    const auto* chunkManager = m_memPoolManager->getChunkManagerByIndex(entry.m_chunkManagerIndex);
+    const auto* header = m_memPoolManager->getChunkHeader(chunkManager);
+    if (header == nullptr)
+    {
+        return;
+    }
+
+    // payload 的位置由头中的 m_userPayloadOffset 决定（对齐后可能与头相隔多行），
+    // 读取偏移量本身已经把头所在行带入缓存，这里预取 payload 的起始行
+    const char* payload = reinterpret_cast<const char*>(header) + header->m_userPayloadOffset;
+    __builtin_prefetch(payload, 0, 3);
+    if constexpr (sizeof(T) > 64U)
+    {
+        __builtin_prefetch(payload + 64, 0, 3);
+    }
+}
+
+} // namespace ZeroCP
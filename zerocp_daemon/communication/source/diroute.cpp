@@ -3,8 +3,8 @@
 #include "zerocp_daemon/diroute/diroute_memory_manager.hpp"
 #include "runtime/ipc_interface_creator.hpp"
 #include "runtime/message_runtime.hpp"
-#include "popo/message_header.hpp"
-#include "zerocp_foundationLib/report/include/lockfree_ringbuffer.hpp"
+#include "zerocp_daemon/memory/include/mempool_manager.hpp"
+#include "zerocp_daemon/memory/include/chunk_manager.hpp"
 #include <thread>
 #include <sstream>
 #include <unistd.h>
@@ -116,6 +116,16 @@ void Diroute::processRuntimeMessagesThread() noexcept
                 // 处理 Subscriber 注册
                 handleSubscriberRegistration(message, creator);
             }
+            else if (command == "UNPUBLISH")
+            {
+                // 处理 Publisher 注销
+                handlePublisherUnregistration(message, creator);
+            }
+            else if (command == "UNSUBSCRIBE")
+            {
+                // 处理 Subscriber 注销
+                handleSubscriberUnregistration(message, creator);
+            }
             else if (command == "ROUTE")
             {
                 // 处理消息路由
@@ -302,6 +312,7 @@ void Diroute::printRegisteredProcesses() const noexcept
 //   2. 获取当前绝对时间，与共享内存中的心跳时间对比
 //   3. 如果时间差超过3秒，则判定为超时
 //   4. 删除超时应用进程的注册信息，释放心跳槽位
+//   5. 清理其 Publisher/Subscriber 注册后，回收它持有的 chunk 引用
 // ============================================================================
 void Diroute::checkHeartbeatTimeouts() noexcept
 {
@@ -321,10 +332,12 @@ void Diroute::checkHeartbeatTimeouts() noexcept
     // 参考 heartbeatPool_test/README.md：守护进程需在 3 秒内回收死进程的槽位
     const uint64_t TIMEOUT_NS = 3'000'000'000ULL;  // 3 秒超时阈值
     
-    std::lock_guard<std::mutex> lock(m_processesMutex);
+    std::unique_lock<std::mutex> lock(m_processesMutex);
     
     // 存储超时的进程offset
     std::vector<uint64_t> timeoutProcesses;
+    // 超时进程的 pid，清理注册后据此回收它持有的 chunk
+    std::vector<uint32_t> timeoutPids;
     
     // ===== 步骤3: 遍历所有注册的应用进程，检查心跳时间 =====
     for (const auto& [slotIndex, processInfo] : m_registeredProcesses)
@@ -380,6 +393,7 @@ void Diroute::checkHeartbeatTimeouts() noexcept
             const auto removedProcess = processIt->second;
             ZEROCP_LOG(Info, "🗑️  Releasing slot for dead process: " << removedProcess.name
                        << " (slotIndex: " << slotIndex << ")");
+            timeoutPids.push_back(removedProcess.pid);
             
             // 5.1 释放心跳槽位（共享内存）
             auto slotIt = heartbeatPool.iteratorFromIndex(slotIndex);
@@ -399,12 +413,31 @@ void Diroute::checkHeartbeatTimeouts() noexcept
     {
         ZEROCP_LOG(Info, "✓ Cleanup completed. Remaining registered processes: " 
                    << m_registeredProcesses.size());
-        
-        // 清理已死亡进程的 Publisher/Subscriber 注册
-        for (uint64_t slotIndex : timeoutProcesses)
-        {
-            cleanupDeadProcessRegistrations(slotIndex);
-        }
+    }
+    lock.unlock();
+    
+    // 清理已死亡进程的 Publisher/Subscriber 注册
+    for (uint64_t slotIndex : timeoutProcesses)
+    {
+        cleanupDeadProcessRegistrations(slotIndex);
+    }
+    // 回收端口已静默的接收队列：包括本次摘除的，以及以前因投递未结束而推迟的
+    releaseQuiescentReceiveQueues();
+    
+    // 接收队列已清空，剩下的是死亡进程自己持有的引用：按所有者账本扣除并归还 chunk。
+    // 心跳超时的进程可能只是被暂停，恢复后仍会访问它持有的 chunk：确认进程已退出后才回收，否则留到以后的检查
+    auto* memPoolManager = Memory::MemPoolManager::getInstanceIfInitialized();
+    if (memPoolManager != nullptr)
+    {
+        m_pendingChunkReclaims.insert(m_pendingChunkReclaims.end(), timeoutPids.begin(), timeoutPids.end());
+        std::erase_if(m_pendingChunkReclaims, [memPoolManager](uint32_t pid) {
+            if (Memory::MemPoolManager::isProcessAlive(pid))
+            {
+                return false;
+            }
+            memPoolManager->reclaimChunksOfProcess(pid);
+            return true;
+        });
     }
 }
 
@@ -493,37 +526,47 @@ void Diroute::handlePublisherRegistration(const ZeroCP::Runtime::RuntimeMessage&
     eventStr.insert(0, event.c_str());
     ServiceDescription serviceDesc(serviceStr, instanceStr, eventStr);
     
-    // 注册 Publisher
+    // 注册 Publisher，并在 DirouteComponents 中为其分配端口
+    uint64_t publisherPortOffset = 0;
     {
         std::lock_guard<std::mutex> lock(m_pubSubMutex);
         RuntimeName_t runtimeName;
         runtimeName.insert(0, processName.c_str());
         
-        // 检查是否已注册
-        bool alreadyRegistered = false;
-        for (const auto& pub : m_publishers)
+        // 每个 Publisher 独占一个端口：同一进程的多个发布者各自注销，互不影响
+        auto& publisherPortPool = m_memoryManager->getPublisherPortPool();
+        auto portIt = publisherPortPool.emplace(static_cast<uint32_t>(slotIndex));
+        if (portIt == publisherPortPool.end())
         {
-            if (pub.processName == runtimeName && pub.serviceDesc == serviceDesc)
-            {
-                alreadyRegistered = true;
-                break;
-            }
+            ZEROCP_LOG(Error, "Publisher port pool is full, cannot register publisher: " << processName);
+            ZeroCP::Runtime::RuntimeMessage response = "ERROR:PORT_POOL_FULL";
+            creator.sendMessage(response);
+            return;
         }
         
-        if (!alreadyRegistered)
-        {
-            m_publishers.emplace_back(runtimeName, serviceDesc, slotIndex, pid);
-            ZEROCP_LOG(Info, "✓ Registered Publisher: " << processName 
-                      << " -> " << service << "/" << instance << "/" << event);
-        }
-        else
+        // 服务发现：把已存在的匹配订阅者的接收队列填入端口
+        for (const auto& sub : m_subscribers)
         {
-            ZEROCP_LOG(Warn, "Publisher already registered: " << processName);
+            if (sub.serviceDesc == serviceDesc)
+            {
+                portIt->addQueue(sub.receiveQueueIndex);
+            }
         }
+        
+        const uint64_t publisherPortIndex = portIt.to_index();
+        publisherPortOffset = m_memoryManager->getComponents()->publisherPortOffset(&(*portIt));
+        
+        m_publishers.emplace_back(runtimeName, serviceDesc, slotIndex, publisherPortIndex, publisherPortOffset, pid);
+        ZEROCP_LOG(Info, "✓ Registered Publisher: " << processName 
+                  << " -> " << service << "/" << instance << "/" << event
+                  << " (portIndex: " << publisherPortIndex
+                  << ", portOffset: " << publisherPortOffset << ")");
     }
     
-    // 发送成功响应
-    ZeroCP::Runtime::RuntimeMessage response = "OK:PUBLISHER_REGISTERED";
+    // 发送成功响应（包含端口偏移量）
+    std::ostringstream responseStream;
+    responseStream << "OK:PUBLISHER_REGISTERED:PORT_OFFSET:" << publisherPortOffset;
+    ZeroCP::Runtime::RuntimeMessage response = responseStream.str();
     creator.sendMessage(response);
 }
 
@@ -608,39 +651,46 @@ void Diroute::handleSubscriberRegistration(const ZeroCP::Runtime::RuntimeMessage
     eventStr.insert(0, event.c_str());
     ServiceDescription serviceDesc(serviceStr, instanceStr, eventStr);
     
-    // TODO: 在共享内存中为 Subscriber 分配接收队列
-    // 这里暂时使用 slotIndex 作为队列偏移量的占位符
-    // 实际实现中，应该在 DirouteComponents 中管理接收队列
-    uint64_t receiveQueueOffset = slotIndex * 1024; // 临时方案：每个槽位分配 1KB 队列空间
-    
-    // 注册 Subscriber
+    // 注册 Subscriber，并在 DirouteComponents 中为其分配接收队列
+    uint64_t receiveQueueOffset = 0;
     {
         std::lock_guard<std::mutex> lock(m_pubSubMutex);
         RuntimeName_t runtimeName;
         runtimeName.insert(0, processName.c_str());
         
-        // 检查是否已注册
-        bool alreadyRegistered = false;
-        for (const auto& sub : m_subscribers)
+        // 每个 Subscriber 独占一个接收队列：同一进程对同一服务的多个订阅者各自收到每条消息，各自注销
+        auto& receiveQueuePool = m_memoryManager->getReceiveQueuePool();
+        auto queueIt = receiveQueuePool.emplace();
+        if (queueIt == receiveQueuePool.end())
         {
-            if (sub.processName == runtimeName && sub.serviceDesc == serviceDesc)
-            {
-                alreadyRegistered = true;
-                break;
-            }
+            ZEROCP_LOG(Error, "Receive queue pool is full, cannot register subscriber: " << processName);
+            ZeroCP::Runtime::RuntimeMessage response = "ERROR:QUEUE_POOL_FULL";
+            creator.sendMessage(response);
+            return;
         }
         
-        if (!alreadyRegistered)
-        {
-            m_subscribers.emplace_back(runtimeName, serviceDesc, slotIndex, receiveQueueOffset, pid);
-            ZEROCP_LOG(Info, "✓ Registered Subscriber: " << processName 
-                      << " -> " << service << "/" << instance << "/" << event
-                      << " (queueOffset: " << receiveQueueOffset << ")");
-        }
-        else
+        const uint64_t receiveQueueIndex = queueIt.to_index();
+        receiveQueueOffset = m_memoryManager->getComponents()->receiveQueueOffset(&(*queueIt));
+        
+        m_subscribers.emplace_back(runtimeName, serviceDesc, slotIndex, receiveQueueIndex, receiveQueueOffset, pid);
+        
+        // 服务发现：把新队列加入所有匹配发布者的端口，发布者下一次投递即可看到
+        auto& publisherPortPool = m_memoryManager->getPublisherPortPool();
+        for (const auto& pub : m_publishers)
         {
-            ZEROCP_LOG(Warn, "Subscriber already registered: " << processName);
+            if (pub.serviceDesc == serviceDesc)
+            {
+                auto portIt = publisherPortPool.iteratorFromIndex(pub.publisherPortIndex);
+                if (portIt != publisherPortPool.end())
+                {
+                    portIt->addQueue(receiveQueueIndex);
+                }
+            }
         }
+        ZEROCP_LOG(Info, "✓ Registered Subscriber: " << processName 
+                  << " -> " << service << "/" << instance << "/" << event
+                  << " (queueIndex: " << receiveQueueIndex
+                  << ", queueOffset: " << receiveQueueOffset << ")");
     }
     
     // 发送成功响应（包含队列偏移量）
@@ -650,13 +700,125 @@ void Diroute::handleSubscriberRegistration(const ZeroCP::Runtime::RuntimeMessage
     creator.sendMessage(response);
 }
 
+/// 解析注销消息 "<command>:<processName>:<pid>:<offset>"
+bool Diroute::parseUnregistration(const ZeroCP::Runtime::RuntimeMessage& message, const char* expectedCommand,
+                                  RuntimeName_t& processName, uint32_t& pid, uint64_t& offset) noexcept
+{
+    std::istringstream iss(message);
+    std::string command, name, pidStr, offsetStr;
+    if (!std::getline(iss, command, ':') || command != expectedCommand ||
+        !std::getline(iss, name, ':') ||
+        !std::getline(iss, pidStr, ':') ||
+        !std::getline(iss, offsetStr))
+    {
+        ZEROCP_LOG(Error, "Failed to parse " << expectedCommand << " message: " << message);
+        return false;
+    }
+    try
+    {
+        pid = static_cast<uint32_t>(std::stoul(pidStr));
+        offset = std::stoull(offsetStr);
+    }
+    catch (const std::exception& e)
+    {
+        ZEROCP_LOG(Error, "Invalid numeric values in " << expectedCommand << " message: " << message);
+        return false;
+    }
+    processName.insert(0, name.c_str());
+    return true;
+}
+
+/// 处理 Publisher 注销
+/// 消息格式: "UNPUBLISH:<processName>:<pid>:<portOffset>"
+void Diroute::handlePublisherUnregistration(const ZeroCP::Runtime::RuntimeMessage& message,
+                                            ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept
+{
+    RuntimeName_t processName;
+    uint32_t pid = 0;
+    uint64_t portOffset = 0;
+    if (!m_memoryManager || !parseUnregistration(message, "UNPUBLISH", processName, pid, portOffset))
+    {
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:PARSE_FAILED";
+        creator.sendMessage(response);
+        return;
+    }
+
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pubSubMutex);
+        auto pubIt = std::find_if(m_publishers.begin(), m_publishers.end(), [&](const PublisherInfo& pub) {
+            return pub.pid == pid && pub.processName == processName && pub.publisherPortOffset == portOffset;
+        });
+        if (pubIt != m_publishers.end())
+        {
+            // 发布者在析构中注销，之后不会再投递：端口可以立即回收
+            releasePublisherPort(pubIt->publisherPortIndex);
+            m_publishers.erase(pubIt);
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        ZEROCP_LOG(Warn, "UNPUBLISH for unknown publisher port " << portOffset << " of " << processName.c_str());
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:PUBLISHER_NOT_REGISTERED";
+        creator.sendMessage(response);
+        return;
+    }
+    ZEROCP_LOG(Info, "✓ Unregistered Publisher: " << processName.c_str() << " (portOffset: " << portOffset << ")");
+    ZeroCP::Runtime::RuntimeMessage response = "OK:UNPUBLISHED";
+    creator.sendMessage(response);
+}
+
+/// 处理 Subscriber 注销
+/// 消息格式: "UNSUBSCRIBE:<processName>:<pid>:<queueOffset>"
+void Diroute::handleSubscriberUnregistration(const ZeroCP::Runtime::RuntimeMessage& message,
+                                             ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept
+{
+    RuntimeName_t processName;
+    uint32_t pid = 0;
+    uint64_t queueOffset = 0;
+    if (!m_memoryManager || !parseUnregistration(message, "UNSUBSCRIBE", processName, pid, queueOffset))
+    {
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:PARSE_FAILED";
+        creator.sendMessage(response);
+        return;
+    }
+
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pubSubMutex);
+        auto subIt = std::find_if(m_subscribers.begin(), m_subscribers.end(), [&](const SubscriberInfo& sub) {
+            return sub.pid == pid && sub.processName == processName && sub.receiveQueueOffset == queueOffset;
+        });
+        if (subIt != m_subscribers.end())
+        {
+            retireReceiveQueue(subIt->receiveQueueIndex);
+            m_subscribers.erase(subIt);
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        ZEROCP_LOG(Warn, "UNSUBSCRIBE for unknown receive queue " << queueOffset << " of " << processName.c_str());
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:SUBSCRIBER_NOT_REGISTERED";
+        creator.sendMessage(response);
+        return;
+    }
+    ZEROCP_LOG(Info, "✓ Unregistered Subscriber: " << processName.c_str() << " (queueOffset: " << queueOffset << ")");
+    ZeroCP::Runtime::RuntimeMessage response = "OK:UNSUBSCRIBED";
+    creator.sendMessage(response);
+
+    // 通常端口此时已经静默，队列立即回收；否则留给心跳线程
+    releaseQuiescentReceiveQueues();
+}
+
 /// 匹配 Publisher 和 Subscriber
 std::vector<Diroute::SubscriberInfo*> Diroute::matchSubscribers(const ServiceDescription& serviceDesc) noexcept
 {
     std::vector<SubscriberInfo*> matched;
     
-    std::lock_guard<std::mutex> lock(m_pubSubMutex);
-    
     for (auto& subscriber : m_subscribers)
     {
         // 精确匹配：service, instance, event 必须完全一致
@@ -669,55 +831,44 @@ std::vector<Diroute::SubscriberInfo*> Diroute::matchSubscribers(const ServiceDes
     return matched;
 }
 
-/// 将消息路由到订阅者的接收队列
+/// 将 chunk 引用写入订阅者的接收队列
 bool Diroute::routeMessageToSubscriber(const SubscriberInfo& subscriber,
-                                       uint64_t chunkOffset, uint64_t chunkSize, uint64_t payloadSize,
-                                       const RuntimeName_t& publisherName) noexcept
+                                       Memory::ChunkManager* chunkManager,
+                                       uint64_t publisherSlot) noexcept
 {
-    // TODO: 从共享内存中获取接收队列
-    // 这里需要访问 DirouteComponents 中的接收队列
-    // 暂时使用日志记录，实际实现需要：
-    // 1. 获取共享内存基地址
-    // 2. 根据 receiveQueueOffset 定位接收队列
-    // 3. 创建 MessageHeader 并写入队列
-    
-    ZEROCP_LOG(Info, "Routing message to Subscriber: " << subscriber.processName.c_str()
-               << " (chunkOffset: " << chunkOffset 
-               << ", chunkSize: " << chunkSize
-               << ", payloadSize: " << payloadSize << ")");
-    
-    // 创建消息头
-    Popo::MessageHeader msgHeader(subscriber.serviceDesc);
-    msgHeader.chunkOffset = chunkOffset;
-    msgHeader.chunkSize = chunkSize;
-    msgHeader.payloadSize = payloadSize;
-    msgHeader.sequenceNumber = m_sequenceNumber.fetch_add(1, std::memory_order_relaxed);
-    
-    auto now = std::chrono::steady_clock::now();
-    msgHeader.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        now.time_since_epoch()).count();
-    
-    msgHeader.publisherName = publisherName;
-    
-    // TODO: 实际实现中，需要将 msgHeader 写入共享内存中的接收队列
-    // 使用 LockFreeRingBuffer<MessageHeader> 的 tryPush 方法
-    // 例如：
-    // auto* receiveQueue = reinterpret_cast<LockFreeRingBuffer<MessageHeader, 1024>*>(
-    //     static_cast<char*>(sharedMemoryBase) + subscriber.receiveQueueOffset);
-    // if (!receiveQueue->tryPush(msgHeader))
-    // {
-    //     ZEROCP_LOG(Warn, "Subscriber receive queue is full: " << subscriber.processName.c_str());
-    //     return false;
-    // }
-    
-    ZEROCP_LOG(Info, "✓ Message routed successfully to: " << subscriber.processName.c_str()
-               << " (seq: " << msgHeader.sequenceNumber << ")");
-    
+    auto& receiveQueuePool = m_memoryManager->getReceiveQueuePool();
+    auto queueIt = receiveQueuePool.iteratorFromIndex(subscriber.receiveQueueIndex);
+    if (queueIt == receiveQueuePool.end())
+    {
+        ZEROCP_LOG(Error, "Receive queue not found for Subscriber: " << subscriber.processName.c_str()
+                   << " (queueIndex: " << subscriber.receiveQueueIndex << ")");
+        return false;
+    }
+
+    zerocp::memory::ChunkQueueEntry entry;
+    entry.m_chunkManagerIndex = chunkManager->m_chunkManagerIndex;
+    entry.m_publisherSlot = static_cast<uint32_t>(publisherSlot);
+    entry.m_sequenceNumber = m_sequenceNumber.fetch_add(1, std::memory_order_relaxed);
+
+    // 先为订阅者增加引用再入队：订阅者一旦 pop 到条目就可能立即释放
+    chunkManager->m_refCount.fetch_add(1, std::memory_order_acq_rel);
+    if (!queueIt->push(entry))
+    {
+        ZEROCP_LOG(Warn, "Subscriber receive queue is full: " << subscriber.processName.c_str());
+        // 回滚：入队失败，撤销刚刚增加的引用
+        chunkManager->m_refCount.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+
+    ZEROCP_LOG(Debug, "✓ Message routed to: " << subscriber.processName.c_str()
+               << " (chunkMgrIdx: " << entry.m_chunkManagerIndex
+               << ", seq: " << entry.m_sequenceNumber << ")");
+
     return true;
 }
 
 /// 处理消息路由
-/// 消息格式: "ROUTE:<publisherName>:<service>:<instance>:<event>:<chunkOffset>:<chunkSize>:<payloadSize>"
+/// 消息格式: "ROUTE:<publisherName>:<service>:<instance>:<event>:<chunkManagerIndex>:<chunkSize>:<payloadSize>"
 void Diroute::handleMessageRouting(const ZeroCP::Runtime::RuntimeMessage& message,
                                     ZeroCP::Runtime::IpcInterfaceCreator& creator) noexcept
 {
@@ -728,12 +879,21 @@ void Diroute::handleMessageRouting(const ZeroCP::Runtime::RuntimeMessage& messag
         creator.sendMessage(response);
         return;
     }
-    
+
+    auto* memPoolManager = Memory::MemPoolManager::getInstanceIfInitialized();
+    if (memPoolManager == nullptr)
+    {
+        ZEROCP_LOG(Error, "MemPoolManager not initialized, cannot route chunks");
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:MEMPOOL_NOT_INITIALIZED";
+        creator.sendMessage(response);
+        return;
+    }
+
     // 解析消息
     std::istringstream iss(message);
     std::string command, publisherName, service, instance, event;
-    std::string chunkOffsetStr, chunkSizeStr, payloadSizeStr;
-    
+    std::string chunkManagerIndexStr, chunkSizeStr, payloadSizeStr;
+
     if (!std::getline(iss, command, ':') || command != "ROUTE")
     {
         ZEROCP_LOG(Warn, "Invalid ROUTE message format: " << message);
@@ -741,12 +901,12 @@ void Diroute::handleMessageRouting(const ZeroCP::Runtime::RuntimeMessage& messag
         creator.sendMessage(response);
         return;
     }
-    
+
     if (!std::getline(iss, publisherName, ':') ||
         !std::getline(iss, service, ':') ||
         !std::getline(iss, instance, ':') ||
         !std::getline(iss, event, ':') ||
-        !std::getline(iss, chunkOffsetStr, ':') ||
+        !std::getline(iss, chunkManagerIndexStr, ':') ||
         !std::getline(iss, chunkSizeStr, ':') ||
         !std::getline(iss, payloadSizeStr))
     {
@@ -755,12 +915,12 @@ void Diroute::handleMessageRouting(const ZeroCP::Runtime::RuntimeMessage& messag
         creator.sendMessage(response);
         return;
     }
-    
+
     // 转换数值
-    uint64_t chunkOffset = 0, chunkSize = 0, payloadSize = 0;
+    uint64_t chunkManagerIndex = 0, chunkSize = 0, payloadSize = 0;
     try
     {
-        chunkOffset = std::stoull(chunkOffsetStr);
+        chunkManagerIndex = std::stoull(chunkManagerIndexStr);
         chunkSize = std::stoull(chunkSizeStr);
         payloadSize = std::stoull(payloadSizeStr);
     }
@@ -771,102 +931,251 @@ void Diroute::handleMessageRouting(const ZeroCP::Runtime::RuntimeMessage& messag
         creator.sendMessage(response);
         return;
     }
-    
+
+    // 定位发布者转交过来的 chunk（守护进程现在持有发布者 prepareForTransfer 的那个引用）
+    Memory::ChunkManager* chunkManager =
+        memPoolManager->getChunkManagerByIndex(static_cast<uint32_t>(chunkManagerIndex));
+    if (chunkManager == nullptr)
+    {
+        ZEROCP_LOG(Error, "Invalid ChunkManager index in ROUTE message: " << chunkManagerIndex);
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:INVALID_CHUNK";
+        creator.sendMessage(response);
+        return;
+    }
+
+    ZEROCP_LOG(Debug, "Routing chunk " << chunkManagerIndex << " (chunkSize: " << chunkSize
+               << ", payloadSize: " << payloadSize << ") from " << publisherName);
+
     // 创建 ServiceDescription
     ZeroCP::id_string serviceStr, instanceStr, eventStr;
     serviceStr.insert(0, service.c_str());
     instanceStr.insert(0, instance.c_str());
     eventStr.insert(0, event.c_str());
     ServiceDescription serviceDesc(serviceStr, instanceStr, eventStr);
-    
-    // 匹配订阅者
-    auto matchedSubscribers = matchSubscribers(serviceDesc);
-    
-    if (matchedSubscribers.empty())
-    {
-        ZEROCP_LOG(Warn, "No subscribers found for: " << service << "/" << instance << "/" << event);
-        ZeroCP::Runtime::RuntimeMessage response = "WARN:NO_SUBSCRIBERS";
-        creator.sendMessage(response);
-        return;
-    }
-    
-    // 路由消息到所有匹配的订阅者
+
     RuntimeName_t pubName;
     pubName.insert(0, publisherName.c_str());
-    
-    bool allSuccess = true;
-    for (auto* subscriber : matchedSubscribers)
+
+    uint64_t routedCount = 0;
+    uint64_t matchedCount = 0;
+    bool publisherFound = false;
     {
-        if (!routeMessageToSubscriber(*subscriber, chunkOffset, chunkSize, payloadSize, pubName))
+        // 持锁期间订阅者及其接收队列不会被心跳线程回收
+        std::lock_guard<std::mutex> lock(m_pubSubMutex);
+
+        uint64_t publisherSlot = 0;
+        for (const auto& pub : m_publishers)
         {
-            allSuccess = false;
+            if (pub.processName == pubName && pub.serviceDesc == serviceDesc)
+            {
+                publisherSlot = pub.slotIndex;
+                publisherFound = true;
+                break;
+            }
+        }
+
+        if (publisherFound)
+        {
+            // 匹配订阅者并路由到所有匹配的接收队列
+            auto matchedSubscribers = matchSubscribers(serviceDesc);
+            matchedCount = matchedSubscribers.size();
+            for (auto* subscriber : matchedSubscribers)
+            {
+                if (routeMessageToSubscriber(*subscriber, chunkManager, publisherSlot))
+                {
+                    ++routedCount;
+                }
+            }
         }
     }
-    
+
+    // 归还发布者转交的引用：若没有任何订阅者入队成功，chunk 在这里被真正释放
+    memPoolManager->releaseChunk(chunkManager);
+
     // 发送响应
-    if (allSuccess)
+    if (!publisherFound)
+    {
+        ZEROCP_LOG(Error, "Publisher not registered: " << publisherName);
+        ZeroCP::Runtime::RuntimeMessage response = "ERROR:PUBLISHER_NOT_REGISTERED";
+        creator.sendMessage(response);
+    }
+    else if (matchedCount == 0)
+    {
+        ZEROCP_LOG(Warn, "No subscribers found for: " << service << "/" << instance << "/" << event);
+        ZeroCP::Runtime::RuntimeMessage response = "WARN:NO_SUBSCRIBERS";
+        creator.sendMessage(response);
+    }
+    else if (routedCount == matchedCount)
     {
         std::ostringstream responseStream;
-        responseStream << "OK:ROUTED:" << matchedSubscribers.size();
+        responseStream << "OK:ROUTED:" << routedCount;
         ZeroCP::Runtime::RuntimeMessage response = responseStream.str();
         creator.sendMessage(response);
-        ZEROCP_LOG(Info, "✓ Routed message to " << matchedSubscribers.size() << " subscriber(s)");
+        ZEROCP_LOG(Debug, "✓ Routed message to " << routedCount << " subscriber(s)");
     }
     else
     {
         ZeroCP::Runtime::RuntimeMessage response = "WARN:PARTIAL_ROUTE";
         creator.sendMessage(response);
-        ZEROCP_LOG(Warn, "⚠️  Partial routing success (some subscribers failed)");
+        ZEROCP_LOG(Warn, "⚠️  Partial routing success (" << routedCount << "/" << matchedCount << ")");
     }
 }
 
-/// 清理已死亡进程的 Publisher/Subscriber 注册
-void Diroute::cleanupDeadProcessRegistrations(uint64_t slotIndex) noexcept
+/// 取出接收队列中所有未消费的条目并释放其 chunk 引用
+void Diroute::drainReceiveQueue(zerocp::memory::ReceiveQueue& queue) noexcept
 {
-    std::lock_guard<std::mutex> lock(m_pubSubMutex);
-    
-    // 查找对应的进程名称
-    std::string processName;
+    auto* memPoolManager = Memory::MemPoolManager::getInstanceIfInitialized();
+
+    zerocp::memory::ChunkQueueEntry entry;
+    uint64_t drained = 0;
+    while (queue.pop(entry))
     {
-        std::lock_guard<std::mutex> procLock(m_processesMutex);
-        auto it = m_registeredProcesses.find(slotIndex);
-        if (it != m_registeredProcesses.end())
+        ++drained;
+        if (memPoolManager == nullptr)
         {
-            processName = it->second.name;
+            continue;
         }
-        else
+        Memory::ChunkManager* chunkManager = memPoolManager->getChunkManagerByIndex(entry.m_chunkManagerIndex);
+        if (chunkManager != nullptr)
         {
-            return; // 进程信息已不存在
+            memPoolManager->releaseChunk(chunkManager);
         }
     }
-    
-    if (processName.empty())
+
+    if (drained > 0)
+    {
+        ZEROCP_LOG(Info, "Released " << drained << " undelivered chunk(s) from receive queue");
+    }
+}
+
+/// 把接收队列从所有发布者端口摘除，记入待回收列表
+void Diroute::retireReceiveQueue(uint64_t receiveQueueIndex) noexcept
+{
+    auto& publisherPortPool = m_memoryManager->getPublisherPortPool();
+
+    // 只需要等待摘除前含有该队列的端口：其他端口上的投递看不到这个队列
+    RetiredReceiveQueue retired{receiveQueueIndex, {}};
+    for (const auto& pub : m_publishers)
+    {
+        auto portIt = publisherPortPool.iteratorFromIndex(pub.publisherPortIndex);
+        if (portIt != publisherPortPool.end() && portIt->removeQueue(receiveQueueIndex))
+        {
+            retired.pendingPorts.push_back(&(*portIt));
+        }
+    }
+    m_retiredReceiveQueues.push_back(std::move(retired));
+}
+
+/// 回收发布者端口
+void Diroute::releasePublisherPort(uint64_t publisherPortIndex) noexcept
+{
+    auto& publisherPortPool = m_memoryManager->getPublisherPortPool();
+    auto portIt = publisherPortPool.iteratorFromIndex(publisherPortIndex);
+    if (portIt == publisherPortPool.end())
     {
         return;
     }
-    
-    RuntimeName_t runtimeName;
-    runtimeName.insert(0, processName.c_str());
-    
-    // 清理 Publisher 注册
+
+    // 发布者不会再投递：等待中的队列不再需要这个端口静默（端口稍后可能被新发布者复用）
+    const zerocp::memory::PublisherPort* port = &(*portIt);
+    for (auto& retired : m_retiredReceiveQueues)
+    {
+        std::erase(retired.pendingPorts, port);
+    }
+    publisherPortPool.release(portIt);
+}
+
+/// 回收所有相关端口都已静默的待回收接收队列
+void Diroute::releaseQuiescentReceiveQueues() noexcept
+{
+    // 1. 持锁取出尚未静默的端口
+    std::vector<const zerocp::memory::PublisherPort*> pendingPorts;
+    {
+        std::lock_guard<std::mutex> lock(m_pubSubMutex);
+        if (m_retiredReceiveQueues.empty())
+        {
+            return;
+        }
+        for (const auto& retired : m_retiredReceiveQueues)
+        {
+            pendingPorts.insert(pendingPorts.end(), retired.pendingPorts.begin(), retired.pendingPorts.end());
+        }
+    }
+
+    // 2. 不持锁检查：端口在共享内存中，读取投递计数不需要守护进程的锁。
+    //    端口在摘除队列之后静默过一次，此后开始的投递就再也看不到这个队列
+    std::vector<const zerocp::memory::PublisherPort*> quiescentPorts;
+    for (const auto* port : pendingPorts)
+    {
+        if (port->isQuiescent())
+        {
+            quiescentPorts.push_back(port);
+        }
+    }
+
+    // 3. 持锁回收：所有相关端口都静默过的队列清空未消费的条目并归还队列池，其余留到下一次检查
+    std::lock_guard<std::mutex> lock(m_pubSubMutex);
+    auto& receiveQueuePool = m_memoryManager->getReceiveQueuePool();
+    std::erase_if(m_retiredReceiveQueues, [&](RetiredReceiveQueue& retired) {
+        std::erase_if(retired.pendingPorts, [&](const zerocp::memory::PublisherPort* port) {
+            return std::find(quiescentPorts.begin(), quiescentPorts.end(), port) != quiescentPorts.end();
+        });
+        if (!retired.pendingPorts.empty())
+        {
+            ZEROCP_LOG(Debug, "Receive queue " << retired.receiveQueueIndex << " deferred: "
+                       << retired.pendingPorts.size() << " publisher port(s) still delivering");
+            return false;
+        }
+        auto queueIt = receiveQueuePool.iteratorFromIndex(retired.receiveQueueIndex);
+        if (queueIt != receiveQueuePool.end())
+        {
+            drainReceiveQueue(*queueIt);
+            receiveQueuePool.release(queueIt);
+        }
+        return true;
+    });
+}
+
+/// 清理已死亡进程的 Publisher/Subscriber 注册
+/// 注意：按心跳槽位匹配，调用时该进程可能已经从 m_registeredProcesses 中删除
+void Diroute::cleanupDeadProcessRegistrations(uint64_t slotIndex) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_pubSubMutex);
+
+    // 清理 Publisher 注册，并回收其端口
+    for (const auto& pub : m_publishers)
+    {
+        if (pub.slotIndex == slotIndex)
+        {
+            releasePublisherPort(pub.publisherPortIndex);
+        }
+    }
     m_publishers.erase(
         std::remove_if(m_publishers.begin(), m_publishers.end(),
-            [&runtimeName](const PublisherInfo& pub) {
-                return pub.processName == runtimeName;
+            [slotIndex](const PublisherInfo& pub) {
+                return pub.slotIndex == slotIndex;
             }),
         m_publishers.end()
     );
-    
-    // 清理 Subscriber 注册
+
+    // 清理 Subscriber 注册：先把其接收队列从发布者端口中摘除；
+    // 进行中的投递结束后，由 releaseQuiescentReceiveQueues 释放未消费的 chunk 引用并回收队列
+    for (const auto& sub : m_subscribers)
+    {
+        if (sub.slotIndex == slotIndex)
+        {
+            retireReceiveQueue(sub.receiveQueueIndex);
+        }
+    }
     m_subscribers.erase(
         std::remove_if(m_subscribers.begin(), m_subscribers.end(),
-            [&runtimeName](const SubscriberInfo& sub) {
-                return sub.processName == runtimeName;
+            [slotIndex](const SubscriberInfo& sub) {
+                return sub.slotIndex == slotIndex;
             }),
         m_subscribers.end()
     );
-    
-    ZEROCP_LOG(Info, "✓ Cleaned up Publisher/Subscriber registrations for: " << processName);
+
+    ZEROCP_LOG(Info, "✓ Cleaned up Publisher/Subscriber registrations for slot: " << slotIndex);
 }
 
 }
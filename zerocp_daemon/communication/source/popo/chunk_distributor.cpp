@@ -0,0 +1,71 @@
+#include "popo/chunk_distributor.hpp"
+#include "zerocp_daemon/memory/include/chunk_header.hpp"
+#include "zerocp_foundationLib/report/include/logging.hpp"
+#include <bit>
+
+namespace ZeroCP
+{
+namespace Popo
+{
+
+ChunkDistributor::ChunkDistributor(zerocp::memory::PublisherPort* port,
+                                   zerocp::memory::ReceiveQueuePool* queuePool) noexcept
+    : m_port(port)
+    , m_queuePool(queuePool)
+{
+}
+
+uint64_t ChunkDistributor::deliver(Memory::SharedChunk& chunk) noexcept
+{
+    if (!isValid() || !chunk)
+    {
+        return 0;
+    }
+
+    // 投递期间守护进程不会回收端口中列出的接收队列
+    auto matchedQueues = m_port->beginDelivery();
+
+    zerocp::memory::ChunkQueueEntry entry;
+    entry.m_chunkManagerIndex = chunk.getChunkManagerIndex();
+    entry.m_publisherSlot = m_port->publisherSlot();
+    entry.m_sequenceNumber = m_port->nextSequenceNumber();
+
+    // 在入队前写入来源和序列号：订阅者 pop 到条目后即可读取
+    if (auto* header = chunk.getChunkheader())
+    {
+        header->m_originId = entry.m_publisherSlot;
+        header->m_sequenceNumber = entry.m_sequenceNumber;
+    }
+
+    uint64_t delivered = 0;
+    while (matchedQueues != 0)
+    {
+        const auto queueIndex = static_cast<uint64_t>(std::countr_zero(matchedQueues));
+        matchedQueues &= matchedQueues - 1;
+
+        auto queueIt = m_queuePool->iteratorFromIndex(queueIndex);
+        if (queueIt == m_queuePool->end())
+        {
+            continue;
+        }
+
+        // 先为订阅者转交引用再入队：订阅者一旦 pop 到条目就可能立即释放
+        chunk.prepareForTransfer();
+        if (queueIt->push(entry))
+        {
+            ++delivered;
+        }
+        else
+        {
+            chunk.cancelTransfer();
+            ZEROCP_LOG(Warn, "Receive queue " << queueIndex << " is full, dropping chunk "
+                       << entry.m_chunkManagerIndex);
+        }
+    }
+
+    m_port->endDelivery();
+    return delivered;
+}
+
+} // namespace Popo
+} // namespace ZeroCP
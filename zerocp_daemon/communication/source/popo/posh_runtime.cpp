@@ -151,6 +151,184 @@ bool PoshRuntime::registerToRouteD() noexcept
     return true;
 }
 
+bool PoshRuntime::requestResponse(const std::string& request, std::string& response) noexcept
+{
+    if (!sendMessage(request))
+    {
+        return false;
+    }
+    
+    RuntimeMessage reply;
+    if (!m_ipcCreator->receiveMessage(reply))
+    {
+        ZEROCP_LOG(Error, "Failed to receive response for: " << request);
+        return false;
+    }
+    
+    response = reply.c_str();
+    return true;
+}
+
+bool PoshRuntime::requestOffset(const std::string& request, const std::string& expectedPrefix, uint64_t& offset) noexcept
+{
+    std::string responseStr;
+    if (!requestResponse(request, responseStr))
+    {
+        return false;
+    }
+    
+    if (responseStr.find(expectedPrefix) != 0)
+    {
+        ZEROCP_LOG(Error, "Registration rejected: " << responseStr);
+        return false;
+    }
+    
+    try
+    {
+        offset = std::stoull(responseStr.substr(expectedPrefix.size()));
+    }
+    catch (const std::exception& e)
+    {
+        ZEROCP_LOG(Error, "Invalid offset in response: " << responseStr);
+        return false;
+    }
+    return true;
+}
+
+zerocp::memory::ReceiveQueue* PoshRuntime::registerSubscriber(const ServiceDescription& serviceDesc) noexcept
+{
+    if (!m_heartbeatShm)
+    {
+        ZEROCP_LOG(Error, "Shared memory not opened");
+        return nullptr;
+    }
+    
+    std::ostringstream oss;
+    oss << "SUBSCRIBER:" << m_runtimeName.c_str() << ":" << m_pid << ":"
+        << serviceDesc.getService().c_str() << ":"
+        << serviceDesc.getInstance().c_str() << ":"
+        << serviceDesc.getEvent().c_str();
+    
+    // 响应格式："OK:SUBSCRIBER_REGISTERED:QUEUE_OFFSET:<offset>"
+    uint64_t queueOffset = 0;
+    if (!requestOffset(oss.str(), "OK:SUBSCRIBER_REGISTERED:QUEUE_OFFSET:", queueOffset))
+    {
+        return nullptr;
+    }
+    
+    auto* components = reinterpret_cast<ZeroCP::Diroute::DirouteComponents*>(m_heartbeatShm->getBaseAddress());
+    auto* receiveQueue = components->receiveQueueFromOffset(queueOffset);
+    if (receiveQueue == nullptr)
+    {
+        ZEROCP_LOG(Error, "Queue offset out of range: " << queueOffset);
+        return nullptr;
+    }
+    
+    ZEROCP_LOG(Info, "Subscriber receive queue mapped at offset " << queueOffset);
+    return receiveQueue;
+}
+
+zerocp::memory::PublisherPort* PoshRuntime::registerPublisher(const ServiceDescription& serviceDesc) noexcept
+{
+    if (!m_heartbeatShm)
+    {
+        ZEROCP_LOG(Error, "Shared memory not opened");
+        return nullptr;
+    }
+    
+    std::ostringstream oss;
+    oss << "PUBLISHER:" << m_runtimeName.c_str() << ":" << m_pid << ":"
+        << serviceDesc.getService().c_str() << ":"
+        << serviceDesc.getInstance().c_str() << ":"
+        << serviceDesc.getEvent().c_str();
+    
+    // 响应格式："OK:PUBLISHER_REGISTERED:PORT_OFFSET:<offset>"
+    uint64_t portOffset = 0;
+    if (!requestOffset(oss.str(), "OK:PUBLISHER_REGISTERED:PORT_OFFSET:", portOffset))
+    {
+        return nullptr;
+    }
+    
+    auto* components = reinterpret_cast<ZeroCP::Diroute::DirouteComponents*>(m_heartbeatShm->getBaseAddress());
+    auto* publisherPort = components->publisherPortFromOffset(portOffset);
+    if (publisherPort == nullptr)
+    {
+        ZEROCP_LOG(Error, "Port offset out of range: " << portOffset);
+        return nullptr;
+    }
+    
+    ZEROCP_LOG(Info, "Publisher port mapped at offset " << portOffset);
+    return publisherPort;
+}
+
+bool PoshRuntime::requestUnregister(const char* command, uint64_t offset) noexcept
+{
+    std::ostringstream oss;
+    oss << command << ":" << m_runtimeName.c_str() << ":" << m_pid << ":" << offset;
+    
+    std::string responseStr;
+    if (!requestResponse(oss.str(), responseStr))
+    {
+        return false;
+    }
+    if (responseStr.find("OK:") != 0)
+    {
+        ZEROCP_LOG(Warn, "Unregistration rejected: " << responseStr);
+        return false;
+    }
+    return true;
+}
+
+bool PoshRuntime::unregisterSubscriber(const zerocp::memory::ReceiveQueue* receiveQueue) noexcept
+{
+    if (!m_heartbeatShm || receiveQueue == nullptr)
+    {
+        return false;
+    }
+    
+    // 响应格式："OK:UNSUBSCRIBED"
+    auto* components = reinterpret_cast<ZeroCP::Diroute::DirouteComponents*>(m_heartbeatShm->getBaseAddress());
+    return requestUnregister("UNSUBSCRIBE", components->receiveQueueOffset(receiveQueue));
+}
+
+bool PoshRuntime::unregisterPublisher(const zerocp::memory::PublisherPort* publisherPort) noexcept
+{
+    if (!m_heartbeatShm || publisherPort == nullptr)
+    {
+        return false;
+    }
+    
+    // 响应格式："OK:UNPUBLISHED"
+    auto* components = reinterpret_cast<ZeroCP::Diroute::DirouteComponents*>(m_heartbeatShm->getBaseAddress());
+    return requestUnregister("UNPUBLISH", components->publisherPortOffset(publisherPort));
+}
+
+zerocp::memory::ReceiveQueuePool* PoshRuntime::getReceiveQueuePool() noexcept
+{
+    if (!m_heartbeatShm)
+    {
+        return nullptr;
+    }
+    auto* components = reinterpret_cast<ZeroCP::Diroute::DirouteComponents*>(m_heartbeatShm->getBaseAddress());
+    return &components->receiveQueuePool();
+}
+
+Memory::MemPoolManager* PoshRuntime::getMemPoolManager() noexcept
+{
+    auto* memPoolManager = Memory::MemPoolManager::getInstanceIfInitialized();
+    if (memPoolManager != nullptr)
+    {
+        return memPoolManager;
+    }
+    
+    if (!Memory::MemPoolManager::attachToSharedInstance())
+    {
+        ZEROCP_LOG(Error, "Failed to attach to chunk memory pool");
+        return nullptr;
+    }
+    return Memory::MemPoolManager::getInstanceIfInitialized();
+}
+
 bool PoshRuntime::openHeartbeatSharedMemory() noexcept
 {
     try
@@ -2,6 +2,8 @@
 #define ZEROCP_DIROUTE_COMPONENTS_HPP
 
 #include "zerocp_daemon/memory/include/heartbeat_pool.hpp"
+#include "zerocp_daemon/memory/include/receive_queue_pool.hpp"
+#include "zerocp_daemon/memory/include/publisher_port_pool.hpp"
 #include <type_traits>
 #include <new>
 #include <cstdint>
@@ -20,8 +22,18 @@ struct DirouteComponents
     alignas(alignof(zerocp::memory::HeartbeatPool)) 
     std::byte m_heartbeatPoolStorage[sizeof(zerocp::memory::HeartbeatPool)];
     
+    // 预留订阅者接收队列池内存（未构造）
+    alignas(alignof(zerocp::memory::ReceiveQueuePool))
+    std::byte m_receiveQueuePoolStorage[sizeof(zerocp::memory::ReceiveQueuePool)];
+    
+    // 预留发布者端口池内存（未构造）
+    alignas(alignof(zerocp::memory::PublisherPortPool))
+    std::byte m_publisherPortPoolStorage[sizeof(zerocp::memory::PublisherPortPool)];
+    
     // 构造状态标志
     bool m_heartbeatPoolConstructed{false};
+    bool m_receiveQueuePoolConstructed{false};
+    bool m_publisherPortPoolConstructed{false};
     
     // 默认构造函数：只预留内存，不构造对象
     DirouteComponents() noexcept = default;
@@ -54,9 +66,113 @@ struct DirouteComponents
         return m_heartbeatPoolConstructed;
     }
     
+    // 使用 placement new 构造接收队列池
+    zerocp::memory::ReceiveQueuePool& constructReceiveQueuePool() noexcept
+    {
+        if (!m_receiveQueuePoolConstructed)
+        {
+            new (&m_receiveQueuePoolStorage) zerocp::memory::ReceiveQueuePool();
+            m_receiveQueuePoolConstructed = true;
+        }
+        return *reinterpret_cast<zerocp::memory::ReceiveQueuePool*>(&m_receiveQueuePoolStorage);
+    }
+    
+    // 获取接收队列池引用（必须先调用 constructReceiveQueuePool）
+    zerocp::memory::ReceiveQueuePool& receiveQueuePool() noexcept
+    {
+        return *reinterpret_cast<zerocp::memory::ReceiveQueuePool*>(&m_receiveQueuePoolStorage);
+    }
+    
+    const zerocp::memory::ReceiveQueuePool& receiveQueuePool() const noexcept
+    {
+        return *reinterpret_cast<const zerocp::memory::ReceiveQueuePool*>(&m_receiveQueuePoolStorage);
+    }
+    
+    // 检查接收队列池是否已构造
+    [[nodiscard]] bool isReceiveQueuePoolConstructed() const noexcept
+    {
+        return m_receiveQueuePoolConstructed;
+    }
+    
+    // 计算接收队列相对于 DirouteComponents 起始地址的偏移量（跨进程传递用）
+    [[nodiscard]] uint64_t receiveQueueOffset(const zerocp::memory::ReceiveQueue* queue) const noexcept
+    {
+        return static_cast<uint64_t>(reinterpret_cast<const std::byte*>(queue)
+                                     - reinterpret_cast<const std::byte*>(this));
+    }
+    
+    // 根据偏移量在本进程的映射中定位接收队列，偏移量非法时返回 nullptr
+    [[nodiscard]] zerocp::memory::ReceiveQueue* receiveQueueFromOffset(uint64_t offset) noexcept
+    {
+        const uint64_t poolBegin = offsetof(DirouteComponents, m_receiveQueuePoolStorage);
+        const uint64_t poolEnd = poolBegin + sizeof(m_receiveQueuePoolStorage);
+        if (offset < poolBegin || offset + sizeof(zerocp::memory::ReceiveQueue) > poolEnd)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<zerocp::memory::ReceiveQueue*>(reinterpret_cast<std::byte*>(this) + offset);
+    }
+    
+    // 使用 placement new 构造发布者端口池
+    zerocp::memory::PublisherPortPool& constructPublisherPortPool() noexcept
+    {
+        if (!m_publisherPortPoolConstructed)
+        {
+            new (&m_publisherPortPoolStorage) zerocp::memory::PublisherPortPool();
+            m_publisherPortPoolConstructed = true;
+        }
+        return *reinterpret_cast<zerocp::memory::PublisherPortPool*>(&m_publisherPortPoolStorage);
+    }
+    
+    // 获取发布者端口池引用（必须先调用 constructPublisherPortPool）
+    zerocp::memory::PublisherPortPool& publisherPortPool() noexcept
+    {
+        return *reinterpret_cast<zerocp::memory::PublisherPortPool*>(&m_publisherPortPoolStorage);
+    }
+    
+    const zerocp::memory::PublisherPortPool& publisherPortPool() const noexcept
+    {
+        return *reinterpret_cast<const zerocp::memory::PublisherPortPool*>(&m_publisherPortPoolStorage);
+    }
+    
+    // 检查发布者端口池是否已构造
+    [[nodiscard]] bool isPublisherPortPoolConstructed() const noexcept
+    {
+        return m_publisherPortPoolConstructed;
+    }
+    
+    // 计算发布者端口相对于 DirouteComponents 起始地址的偏移量（跨进程传递用）
+    [[nodiscard]] uint64_t publisherPortOffset(const zerocp::memory::PublisherPort* port) const noexcept
+    {
+        return static_cast<uint64_t>(reinterpret_cast<const std::byte*>(port)
+                                     - reinterpret_cast<const std::byte*>(this));
+    }
+    
+    // 根据偏移量在本进程的映射中定位发布者端口，偏移量非法时返回 nullptr
+    [[nodiscard]] zerocp::memory::PublisherPort* publisherPortFromOffset(uint64_t offset) noexcept
+    {
+        const uint64_t poolBegin = offsetof(DirouteComponents, m_publisherPortPoolStorage);
+        const uint64_t poolEnd = poolBegin + sizeof(m_publisherPortPoolStorage);
+        if (offset < poolBegin || offset + sizeof(zerocp::memory::PublisherPort) > poolEnd)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<zerocp::memory::PublisherPort*>(reinterpret_cast<std::byte*>(this) + offset);
+    }
+    
     // 析构函数：按 LIFO 顺序显式销毁已构造的组件
     ~DirouteComponents() noexcept
     {
+        if (m_publisherPortPoolConstructed)
+        {
+            reinterpret_cast<zerocp::memory::PublisherPortPool*>(&m_publisherPortPoolStorage)->~PublisherPortPool();
+            m_publisherPortPoolConstructed = false;
+        }
+        if (m_receiveQueuePoolConstructed)
+        {
+            reinterpret_cast<zerocp::memory::ReceiveQueuePool*>(&m_receiveQueuePoolStorage)->~ReceiveQueuePool();
+            m_receiveQueuePoolConstructed = false;
+        }
         if (m_heartbeatPoolConstructed)
         {
             reinterpret_cast<zerocp::memory::HeartbeatPool*>(&m_heartbeatPoolStorage)->~HeartbeatPool();
@@ -39,6 +39,22 @@ DirouteMemoryManager::createMemoryPool(const Config& config) noexcept
         return std::unexpected(heartbeatResult.error());
     }
     
+    auto receiveQueueResult = constructReceiveQueuePool(components);
+    if (!receiveQueueResult)
+    {
+        ZEROCP_LOG(Error, "Failed to construct ReceiveQueuePool");
+        components->~DirouteComponents();
+        return std::unexpected(receiveQueueResult.error());
+    }
+    
+    auto publisherPortResult = constructPublisherPortPool(components);
+    if (!publisherPortResult)
+    {
+        ZEROCP_LOG(Error, "Failed to construct PublisherPortPool");
+        components->~DirouteComponents();
+        return std::unexpected(publisherPortResult.error());
+    }
+    
     ZEROCP_LOG(Info, "Memory pool created successfully at " << baseAddress);
 
     return DirouteMemoryManager(std::move(shm), components);
@@ -104,6 +120,45 @@ DirouteMemoryManager::constructHeartbeatPool(DirouteComponents* components) noex
     }
 }
 
+std::expected<void, MemoryManagerError>
+DirouteMemoryManager::constructReceiveQueuePool(DirouteComponents* components) noexcept
+{
+    if (components == nullptr)
+    {
+        return std::unexpected(MemoryManagerError::COMPONENT_CONSTRUCTION_FAILED);
+    }
+    
+    try
+    {
+        // 分布式构造：所有接收队列的槽位序列号在此一次性初始化
+        components->constructReceiveQueuePool();
+        return {};
+    }
+    catch (...)
+    {
+        return std::unexpected(MemoryManagerError::RECEIVE_QUEUE_POOL_CONSTRUCTION_FAILED);
+    }
+}
+
+std::expected<void, MemoryManagerError>
+DirouteMemoryManager::constructPublisherPortPool(DirouteComponents* components) noexcept
+{
+    if (components == nullptr)
+    {
+        return std::unexpected(MemoryManagerError::COMPONENT_CONSTRUCTION_FAILED);
+    }
+    
+    try
+    {
+        components->constructPublisherPortPool();
+        return {};
+    }
+    catch (...)
+    {
+        return std::unexpected(MemoryManagerError::PUBLISHER_PORT_POOL_CONSTRUCTION_FAILED);
+    }
+}
+
 DirouteMemoryManager::DirouteMemoryManager(ZeroCP::Details::PosixSharedMemoryObject&& shm,
                                            DirouteComponents* components) noexcept
     : m_sharedMemory(std::move(shm))
@@ -116,7 +171,7 @@ DirouteMemoryManager::~DirouteMemoryManager() noexcept
 {
     if (m_initialized && m_components != nullptr)
     {
-        // 显式析构：按 LIFO 顺序销毁 HeartbeatPool
+        // 显式析构：按 LIFO 顺序销毁 PublisherPortPool、ReceiveQueuePool、HeartbeatPool
         m_components->~DirouteComponents();
         m_components = nullptr;
         m_initialized = false;
@@ -138,6 +193,16 @@ zerocp::memory::HeartbeatPool& DirouteMemoryManager::getHeartbeatPool() noexcept
     return m_components->heartbeatPool();
 }
 
+zerocp::memory::ReceiveQueuePool& DirouteMemoryManager::getReceiveQueuePool() noexcept
+{
+    return m_components->receiveQueuePool();
+}
+
+zerocp::memory::PublisherPortPool& DirouteMemoryManager::getPublisherPortPool() noexcept
+{
+    return m_components->publisherPortPool();
+}
+
 bool DirouteMemoryManager::isInitialized() const noexcept
 {
     return m_initialized;
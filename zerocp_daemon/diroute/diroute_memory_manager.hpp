@@ -18,6 +18,8 @@ enum class MemoryManagerError
     SHARED_MEMORY_CREATION_FAILED,
     COMPONENT_CONSTRUCTION_FAILED,
     HEARTBEAT_BLOCK_CONSTRUCTION_FAILED,
+    RECEIVE_QUEUE_POOL_CONSTRUCTION_FAILED,
+    PUBLISHER_PORT_POOL_CONSTRUCTION_FAILED,
     INVALID_BASE_ADDRESS
 };
 
@@ -56,6 +58,8 @@ public:
     [[nodiscard]] DirouteComponents* getComponents() noexcept;
     [[nodiscard]] const DirouteComponents* getComponents() const noexcept;
     [[nodiscard]] zerocp::memory::HeartbeatPool& getHeartbeatPool() noexcept;
+    [[nodiscard]] zerocp::memory::ReceiveQueuePool& getReceiveQueuePool() noexcept;
+    [[nodiscard]] zerocp::memory::PublisherPortPool& getPublisherPortPool() noexcept;
     [[nodiscard]] bool isInitialized() const noexcept;
 
 private:
@@ -74,6 +78,14 @@ private:
     [[nodiscard]] static std::expected<void, MemoryManagerError>
     constructHeartbeatPool(DirouteComponents* components) noexcept;
 
+    // Phase 4: 分布式构造订阅者接收队列池
+    [[nodiscard]] static std::expected<void, MemoryManagerError>
+    constructReceiveQueuePool(DirouteComponents* components) noexcept;
+
+    // Phase 5: 分布式构造发布者端口池
+    [[nodiscard]] static std::expected<void, MemoryManagerError>
+    constructPublisherPortPool(DirouteComponents* components) noexcept;
+
     ZeroCP::Details::PosixSharedMemoryObject m_sharedMemory;
     DirouteComponents* m_components{nullptr};
     bool m_initialized{false};
@@ -22,6 +22,9 @@ struct alignas(8) ChunkHeader
 
     // 保留字节（未来扩展）
     uint8_t m_reserved{0};
+    
+    // 用户头相对于 ChunkHeader 的偏移量（没有用户头时等于 sizeof(ChunkHeader)）
+    uint16_t m_userHeaderOffset{sizeof(ChunkHeader)};
         
     // 发送者 ID（哪个端口发送的）
     // TODO: 需要定义 popo::UniquePortId
@@ -0,0 +1,95 @@
+#ifndef ZEROCP_CHUNK_MAGAZINE_HPP
+#define ZEROCP_CHUNK_MAGAZINE_HPP
+
+#include <cstdint>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+class MemPoolManager;
+
+/// @brief 单个尺寸级别的 chunk 弹匣（进程本地、线程私有）
+/// @details 预先从空闲链表批量取出的数据 chunk 索引（控制块索引由其直接算出），getChunk/releaseChunk 在弹匣内完成，
+///          不触碰共享空闲链表的栈顶；弹匣空/满时才批量补充/归还
+class ChunkMagazine
+{
+public:
+    static constexpr uint32_t kCapacity = 32U;    ///< 弹匣容量
+    static constexpr uint32_t kBatchSize = 16U;   ///< 每次补充/归还的数量
+
+    bool pop(uint32_t& chunkIndex) noexcept
+    {
+        if (m_count == 0U)
+        {
+            return false;
+        }
+        chunkIndex = m_entries[--m_count];
+        return true;
+    }
+
+    bool push(uint32_t chunkIndex) noexcept
+    {
+        if (m_count == kCapacity)
+        {
+            return false;
+        }
+        m_entries[m_count++] = chunkIndex;
+        return true;
+    }
+
+    /// @brief 从弹匣顶部取出最多 count 个索引（用于批量归还）
+    uint32_t take(uint32_t* chunkIndices, uint32_t count) noexcept
+    {
+        const uint32_t taken = (count < m_count) ? count : m_count;
+        m_count -= taken;
+        for (uint32_t i = 0U; i < taken; ++i)
+        {
+            chunkIndices[i] = m_entries[m_count + i];
+        }
+        return taken;
+    }
+
+    uint32_t size() const noexcept { return m_count; }
+    bool isEmpty() const noexcept { return m_count == 0U; }
+    bool isFull() const noexcept { return m_count == kCapacity; }
+
+    /// @brief 丢弃弹匣内容（内存池已销毁，索引不再有效）
+    void clear() noexcept { m_count = 0U; }
+
+private:
+    uint32_t m_count{0U};
+    uint32_t m_entries[kCapacity];
+};
+
+/// @brief 当前线程的弹匣集合（每个数据池一个弹匣）
+/// @details 线程退出时析构函数把所有弹匣归还给内存池；
+///          内存池重建后（generation 变化）旧弹匣中的索引直接丢弃
+class ThreadMagazineCache
+{
+public:
+    static constexpr uint32_t kMaxPools = 16U;     ///< 与 MemPoolManager::m_mempools 容量一致
+
+    /// @brief 获取当前线程的弹匣集合
+    static ThreadMagazineCache& forThisThread() noexcept;
+
+    ~ThreadMagazineCache() noexcept;
+
+    /// @brief 获取指定数据池的弹匣；generation 与缓存记录不一致时先清空
+    ChunkMagazine& magazine(uint32_t poolIndex, uint64_t generation) noexcept;
+
+    /// @brief 把所有弹匣归还给内存池
+    void flushAll(MemPoolManager& manager) noexcept;
+
+private:
+    ThreadMagazineCache() noexcept = default;
+
+    uint64_t m_generation{0U};
+    ChunkMagazine m_magazines[kMaxPools];
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_CHUNK_MAGAZINE_HPP
@@ -2,34 +2,56 @@
 #define ZEROCP_CHUNKMANAGER_HPP
 
 #include <atomic>
-#include "relative_pointer.hpp"
+#include <cstdint>
 
 namespace ZeroCP
 {
 namespace Memory
 {
-class MemPool;
-class ChunkHeader;
 
-//ChunkManager 主要用来原理chunk的具体数据，传输只传出ChunkManager的相对偏移在通过RelativePointer转换 
-struct ChunkManager
+/// @brief chunk 控制块：引用计数 + 所属池的回指索引
+/// @details 控制块与数据 chunk 一一对应：控制块索引 = 池的控制块基址 + chunk 索引，
+///          分配/释放只需操作数据池的一个空闲链表；启动时不初始化控制块，
+///          索引字段在分配时与引用计数一起写入。独占一个 cache line，避免相邻 chunk 的引用计数伪共享。
+///          控制块末尾是按所有者槽位的引用账本，进程崩溃时守护进程据此扣除它持有的引用。
+///          传输时只传控制块索引，任意进程按索引即可算出控制块和 ChunkHeader 地址
+struct alignas(64) ChunkManager
 {
-    using base_t = ChunkHeader;
-    ZeroCP::RelativePointer<base_t> m_chunkHeader;
-    /// @brief 指向数据所属内存池的相对指针
-    ZeroCP::RelativePointer<MemPool> m_mempool;
-    /// @brief 指向ChunkManagement对象池的相对指针
-    ZeroCP::RelativePointer<MemPool> m_chunkManagementPool;
     std::atomic<uint64_t> m_refCount{0};
     
     // ==================== 跨进程索引信息 ====================
     /// @brief 数据 chunk 在其所属池中的索引（用于跨进程地址重建）
     uint32_t m_chunkIndex{0};
-    /// @brief ChunkManager 对象在 ChunkManagerPool 中的索引
+    /// @brief 控制块在控制块数组中的索引（即跨进程传递的 chunk 索引）
     uint32_t m_chunkManagerIndex{0};
+    /// @brief 数据 chunk 所属内存池在 MemPoolManager::m_mempools 中的索引
+    uint32_t m_mempoolIndex{0};
+    
+    // ==================== 所有者信息（分配时写入，释放时据此记账） ====================
+    /// @brief 分配该 chunk 的进程的所有者槽位（MemPoolManager::kNoChunkOwner 表示不记账）
+    uint16_t m_ownerSlot{0xFFFFU};
+    /// @brief 分配时所有者槽位的任期（低 16 位），槽位被新进程登记后旧 chunk 不再记入新账户
+    uint16_t m_ownerEpoch{0};
+    /// @brief 是否来自所有者的预留链表（释放后回到预留链表）
+    bool m_fromReservation{false};
+    
+    // ==================== 链式消息（超过最大尺寸级别的负载分段存放） ====================
+    static constexpr uint32_t kNoNextChunk = UINT32_MAX;
+    /// @brief 链中下一个 chunk 的控制块索引（kNoNextChunk 表示链尾或不是链式消息）
+    /// @details 只有链头的引用计数有效，后续 chunk 的引用计数为 0、不记入账本，链头归零时整条链一起归还
+    uint32_t m_nextChunkIndex{kNoNextChunk};
+    
+    // ==================== 引用持有账本（进程崩溃后据此回收引用） ====================
+    static constexpr uint32_t kMaxHolders = 32U;
+    /// @brief 每个所有者槽位持有的引用数（饱和于 255，超出部分不记账，崩溃时宁可泄漏不会重复释放）
+    /// @details 只有槽位的所有者进程增减自己的计数；进程死亡后由守护进程清零并从引用计数中扣除。
+    ///          引用计数减去所有槽位计数之和即为在途（已入队、尚未被接收者接管）的引用数
+    std::atomic<uint8_t> m_holderReferences[kMaxHolders]{};
 };
 
+static_assert(sizeof(ChunkManager) == 64U, "ChunkManager must occupy exactly one cache line");
+
 } // namespace Memory
 } // namespace ZeroCP
 
-#endif // ZEROCP_CHUNKMANAGER_HPP
\ No newline at end of file
+#endif // ZEROCP_CHUNKMANAGER_HPP
@@ -0,0 +1,37 @@
+#ifndef ZEROCP_CHUNK_OWNER_ACCOUNT_HPP
+#define ZEROCP_CHUNK_OWNER_ACCOUNT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief 一个 chunk 所有者（进程）在共享内存中的账户：配额、预留和用量计数
+/// @details 进程创建/连接共享实例时登记一个槽位，之后它分配的每个 chunk 都在控制块中记下槽位，
+///          任意进程释放该 chunk 时按槽位记账。预留的 chunk 放在账户的私有链表中（见 MemPoolManager::reserveChunks），
+///          不经过共享空闲链表，因此其他进程无法耗尽它们
+struct alignas(64) ChunkOwnerAccount
+{
+    static constexpr uint32_t kMaxPools = 16U;
+
+    std::atomic<uint32_t> m_pid{0};                 ///< 所有者进程号（0 表示槽位空闲）
+    std::atomic<uint32_t> m_epoch{0};               ///< 槽位每次登记时递增，区分槽位的前后两任所有者
+    std::atomic<uint64_t> m_quotaRejections{0};     ///< 因超出配额被拒绝的分配次数
+
+    /// @brief 从共享空闲链表分配、尚未释放的 chunk 数（分配/释放热路径，独占 cache line）
+    alignas(64) std::atomic<uint32_t> m_heldChunks[kMaxPools]{};
+    /// @brief 预留的 chunk 数（私有链表中的 + 从私有链表借出的）
+    alignas(64) std::atomic<uint32_t> m_reservedChunks[kMaxPools]{};
+    /// @brief 取消预留时仍借出的 chunk 数：这些 chunk 释放后回到共享空闲链表
+    std::atomic<uint32_t> m_reservationDebt[kMaxPools]{};
+    /// @brief 每个池的配额：最多同时持有的 chunk 数（含预留，0 表示不限）
+    alignas(64) std::atomic<uint32_t> m_quotaChunks[kMaxPools]{};
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_CHUNK_OWNER_ACCOUNT_HPP
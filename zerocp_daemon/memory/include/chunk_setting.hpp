@@ -0,0 +1,130 @@
+#ifndef ZEROCP_CHUNKSETTING_HPP
+#define ZEROCP_CHUNKSETTING_HPP
+
+#include "chunk_header.hpp"
+#include <cstdint>
+#include <expected>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief ChunkSetting 的错误类型
+enum class ChunkSettingError : uint8_t
+{
+    INVALID_PAYLOAD_ALIGNMENT,      // 用户数据对齐不是 2 的幂或超过 kMaxAlignment
+    INVALID_USER_HEADER_ALIGNMENT,  // 用户头对齐不是 2 的幂或超过 kMaxAlignment
+    USER_HEADER_TOO_LARGE,          // 用户头超过 kMaxUserHeaderSize
+    CHUNK_TOO_LARGE                 // chunk 总大小溢出
+};
+
+/// @brief 一个池的 chunk 布局：[ChunkHeader][填充][用户头][填充][用户数据][填充]
+/// @details 每个池按配置计算一次（见 MemPoolConfig::getChunkSetting），分配时只读取结果：
+///          chunk 步长是 chunk 对齐的整数倍，池起始地址也按 chunk 对齐，因此池内每个 chunk 的
+///          用户头和用户数据都位于固定偏移且满足各自的对齐要求
+class ChunkSetting
+{
+public:
+    static constexpr uint32_t kDefaultAlignment = 8U;
+    /// @brief 支持的最大对齐（一页，可用于 DMA 等要求页对齐的场景）
+    static constexpr uint32_t kMaxAlignment = 4096U;
+    static constexpr uint32_t kMaxUserHeaderSize = 0xFFFFU;
+
+    /// @brief 默认布局：没有用户头，用户数据紧跟 ChunkHeader，按 8 字节对齐
+    constexpr explicit ChunkSetting(uint64_t userPayloadSize = 0U) noexcept
+        : ChunkSetting(userPayloadSize, kDefaultAlignment, 0U, kDefaultAlignment)
+    {
+    }
+
+    /// @brief 计算布局
+    /// @param userPayloadSize 用户数据容量（字节）
+    /// @param userPayloadAlignment 用户数据对齐（2 的幂，不超过 kMaxAlignment）
+    /// @param userHeaderSize 用户头大小（0 表示没有用户头）
+    /// @param userHeaderAlignment 用户头对齐（2 的幂，不超过 kMaxAlignment）
+    static constexpr std::expected<ChunkSetting, ChunkSettingError> create(uint64_t userPayloadSize,
+                                                                         uint32_t userPayloadAlignment = kDefaultAlignment,
+                                                                         uint32_t userHeaderSize = 0U,
+                                                                         uint32_t userHeaderAlignment = kDefaultAlignment) noexcept
+    {
+        if (!isValidAlignment(userPayloadAlignment))
+        {
+            return std::unexpected(ChunkSettingError::INVALID_PAYLOAD_ALIGNMENT);
+        }
+        if (!isValidAlignment(userHeaderAlignment))
+        {
+            return std::unexpected(ChunkSettingError::INVALID_USER_HEADER_ALIGNMENT);
+        }
+        if (userHeaderSize > kMaxUserHeaderSize)
+        {
+            return std::unexpected(ChunkSettingError::USER_HEADER_TOO_LARGE);
+        }
+        if (userPayloadSize > UINT64_MAX / 2U)
+        {
+            return std::unexpected(ChunkSettingError::CHUNK_TOO_LARGE);
+        }
+        return ChunkSetting(userPayloadSize, userPayloadAlignment, userHeaderSize, userHeaderAlignment);
+    }
+
+    constexpr uint64_t getUserPayloadSize() const noexcept { return m_userPayloadSize; }
+    constexpr uint32_t getUserPayloadAlignment() const noexcept { return m_userPayloadAlignment; }
+    constexpr uint32_t getUserHeaderSize() const noexcept { return m_userHeaderSize; }
+    constexpr uint32_t getUserHeaderAlignment() const noexcept { return m_userHeaderAlignment; }
+
+    /// @brief 用户头相对 chunk 起始地址的偏移（没有用户头时等于 sizeof(ChunkHeader)）
+    constexpr uint32_t getUserHeaderOffset() const noexcept { return m_userHeaderOffset; }
+    /// @brief 用户数据相对 chunk 起始地址的偏移
+    constexpr uint32_t getUserPayloadOffset() const noexcept { return m_userPayloadOffset; }
+    /// @brief chunk 起始地址的对齐要求（池起始地址按此对齐）
+    constexpr uint32_t getChunkAlignment() const noexcept { return m_chunkAlignment; }
+    /// @brief chunk 步长：相邻 chunk 起始地址之差，也是每个 chunk 占用的字节数
+    constexpr uint64_t getChunkSize() const noexcept { return m_chunkSize; }
+
+private:
+    constexpr ChunkSetting(uint64_t userPayloadSize, uint32_t userPayloadAlignment,
+                           uint32_t userHeaderSize, uint32_t userHeaderAlignment) noexcept
+        : m_userPayloadSize(userPayloadSize)
+        , m_userPayloadAlignment(userPayloadAlignment)
+        , m_userHeaderSize(userHeaderSize)
+        , m_userHeaderAlignment(userHeaderAlignment)
+    {
+        const uint64_t userHeaderOffset = (userHeaderSize == 0U)
+            ? sizeof(ChunkHeader)
+            : alignUp(sizeof(ChunkHeader), userHeaderAlignment);
+        const uint64_t userPayloadOffset = alignUp(userHeaderOffset + userHeaderSize, userPayloadAlignment);
+        m_userHeaderOffset = static_cast<uint32_t>(userHeaderOffset);
+        m_userPayloadOffset = static_cast<uint32_t>(userPayloadOffset);
+        m_chunkAlignment = maxOf(maxOf(alignof(ChunkHeader), userPayloadAlignment),
+                                 (userHeaderSize == 0U) ? 1U : userHeaderAlignment);
+        m_chunkSize = alignUp(userPayloadOffset + userPayloadSize, m_chunkAlignment);
+    }
+
+    static constexpr bool isValidAlignment(uint32_t alignment) noexcept
+    {
+        return alignment != 0U && (alignment & (alignment - 1U)) == 0U && alignment <= kMaxAlignment;
+    }
+
+    static constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1U) & ~(alignment - 1U);
+    }
+
+    static constexpr uint32_t maxOf(uint32_t lhs, uint32_t rhs) noexcept
+    {
+        return (lhs > rhs) ? lhs : rhs;
+    }
+
+    uint64_t m_userPayloadSize{0U};
+    uint32_t m_userPayloadAlignment{kDefaultAlignment};
+    uint32_t m_userHeaderSize{0U};
+    uint32_t m_userHeaderAlignment{kDefaultAlignment};
+    uint32_t m_userHeaderOffset{sizeof(ChunkHeader)};
+    uint32_t m_userPayloadOffset{sizeof(ChunkHeader)};
+    uint32_t m_chunkAlignment{kDefaultAlignment};
+    uint64_t m_chunkSize{sizeof(ChunkHeader)};
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_CHUNKSETTING_HPP
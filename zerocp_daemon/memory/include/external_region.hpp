@@ -0,0 +1,42 @@
+#ifndef ZEROCP_EXTERNAL_REGION_HPP
+#define ZEROCP_EXTERNAL_REGION_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief 外部池的区域状态
+enum class ExternalRegionState : uint32_t
+{
+    NOT_EXTERNAL = 0,   ///< 普通池（chunk 在数据区中）
+    VACANT,             ///< 外部池，尚未登记区域（没有可用 chunk）
+    REGISTERING,        ///< 某个进程正在登记区域
+    REGISTERED          ///< 区域已登记，其他进程第一次访问时按描述符映射
+};
+
+/// @brief 外部池的区域描述符（共享内存中，所有进程共用）
+/// @details 外部池的 chunk 数组不在数据区中，而在使用者自己创建的 POSIX 共享内存或 memfd 中
+///          （见 MemPoolManager::registerExternalRegion）。区域按 chunk 步长划分，
+///          布局与普通池相同：[ChunkHeader][用户头][用户数据] x chunk 数。
+///          其他进程据此描述符打开同一个区域：POSIX 共享内存按名字，memfd 按 /proc/<pid>/fd/<fd>
+struct ExternalRegionDescriptor
+{
+    static constexpr uint32_t kMaxNameLength = 64U;
+
+    std::atomic<ExternalRegionState> m_state{ExternalRegionState::NOT_EXTERNAL};
+    uint32_t m_segmentId{0};        ///< 区域的段ID（PoolRegistry 池ID，0 表示没有可用的段ID）
+    uint32_t m_ownerPid{0};         ///< memfd：持有 fd 的登记进程
+    int32_t m_fd{-1};               ///< memfd：登记进程中的 fd（m_shmName 为空时使用）
+    uint64_t m_offset{0};           ///< chunk 数组在区域中的偏移（按 chunk 对齐）
+    uint64_t m_mappedSize{0};       ///< 映射的字节数（offset + chunk 数组）
+    char m_shmName[kMaxNameLength]{};  ///< POSIX 共享内存名称（为空表示 memfd）
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_EXTERNAL_REGION_HPP
@@ -3,8 +3,11 @@
 
 #include <cstdint>
 #include <atomic>
+#include <type_traits>
 #include "relative_pointer.hpp"
 #include "mpmclockfreelist.hpp"
+#include "chunk_setting.hpp"
+#include "pool_telemetry.hpp"
 
 namespace ZeroCP
 {
@@ -12,7 +15,9 @@ namespace Memory
 {
 
 //复用 即使管理chunk块的内存池 同时也是管理chunmanager对象的内存池
-class MemPool
+/// @note 布局按写入频率分成四个 cache line 组：只读字段 | 空闲链表栈顶 | 已使用计数和高水位 | 按 CPU 分片的遥测计数。
+///       不同尺寸级别的分配只写各自池的行，vector<MemPool, 16> 中相邻的池不会互相失效
+class alignas(64) MemPool
 {
 public:
     /// @brief 带参数的构造函数 - 直接在构造时完成所有初始化
@@ -22,6 +27,10 @@ public:
     /// @param chunkNums chunk 的数量
     /// @param freeListMemory 空闲索引链表的内存地址
     /// @param pool_id 内存池ID
+    /// @param capacity 最大 chunk 数（含运行时扩容的段，0 表示等于 chunkNums）；
+    ///                 空闲链表按 capacity 分配，初始只有前 chunkNums 个索引可用
+    /// @param chunkSetting 数据池的 chunk 布局（控制块池不使用）
+    /// @param deriveUsedCount true 时不维护共享的已使用计数，getUsedChunks 由遥测分片推算（见 MemPoolConfig::m_deriveUsedCount）
     /// @note 这个构造函数允许 emplace_back 直接在 vector 内部构造完全初始化的 MemPool 对象
     /// @note 对象构造完成后立即可用，遵循 RAII 原则
     MemPool(void* baseAddress, 
@@ -29,7 +38,10 @@ public:
             uint64_t chunkSize, 
             uint32_t chunkNums, 
             void* freeListMemory,
-            uint64_t pool_id) noexcept;
+            uint64_t pool_id,
+            uint32_t capacity = 0U,
+            const ChunkSetting& chunkSetting = ChunkSetting(),
+            bool deriveUsedCount = false) noexcept;
     
     // 删除默认构造（强制使用带参数的构造函数）
     MemPool() = delete;
@@ -43,19 +55,49 @@ public:
     /// @brief 获取 chunk 大小
     uint64_t getChunkSize() const noexcept { return m_chunkSize; }
     
-    /// @brief 获取 chunk 总数
-    uint32_t getTotalChunks() const noexcept { return m_chunkNums; }
+    /// @brief 获取 chunk 布局（步长、用户头和用户数据的偏移，构造时计算一次）
+    const ChunkSetting& getChunkSetting() const noexcept { return m_chunkSetting; }
+    
+    /// @brief 获取当前可用的 chunk 总数（初始段 + 已扩容的段）
+    uint32_t getTotalChunks() const noexcept { return m_activeChunks.load(std::memory_order_acquire); }
+    
+    /// @brief 获取每个段的 chunk 数（初始段与扩容段大小相同）
+    uint32_t getSegmentChunks() const noexcept { return m_chunkNums; }
+    
+    /// @brief 获取最大 chunk 数（扩容上限，控制块和空闲链表按此预留）
+    uint32_t getCapacity() const noexcept { return m_capacity; }
     
     /// @brief 获取已使用的 chunk 数量
-    uint32_t getUsedChunks() const noexcept { return m_usedChunk.load(std::memory_order_relaxed); }
+    /// @note 普通模式为一次原子读取；推算模式下为 PoolTelemetry::kShardCount 个分片之和
+    ///       （O(16) 次 relaxed 读取，与空闲数无关，可以被 sampleChunkUsage 等周期任务频繁调用）
+    uint32_t getUsedChunks() const noexcept
+    {
+        if (m_deriveUsedCount)
+        {
+            const uint32_t used = m_telemetry.usedCount();
+            const uint32_t total = getTotalChunks();
+            return (used > total) ? total : used;
+        }
+        return m_usedChunk.load(std::memory_order_relaxed);
+    }
+    
+    /// @brief 已使用计数是否由空闲链表推算
+    bool isUsedCountDerived() const noexcept { return m_deriveUsedCount; }
     
     /// @brief 获取空闲 chunk 数量
-    uint32_t getFreeChunks() const noexcept { return m_chunkNums - getUsedChunks(); }
+    uint32_t getFreeChunks() const noexcept { return getTotalChunks() - getUsedChunks(); }
     
     /// @brief 设置原始内存地址（用于延迟初始化）
     /// @param rawMemory 原始内存地址
     /// @param dataOffset 数据区偏移量（相对于数据区基地址）
-    void setRawMemory(void* rawMemory, uint64_t dataOffset) noexcept;
+    /// @param segmentId rawMemory 所在共享内存段的池ID（必须已在本进程的 PoolRegistry 中注册）
+    void setRawMemory(void* rawMemory, uint64_t dataOffset, pool_id_t segmentId) noexcept;
+    
+    /// @brief 获取 chunk 数组在本进程中的起始地址（经 PoolRegistry 转换，任意进程可用）
+    void* getRawMemory() const noexcept { return m_rawMemory.get(); }
+    
+    /// @brief chunk 数组所在共享内存段的池ID（数据区为 CHUNK_POOL_ID，外部池为区域的段ID）
+    pool_id_t getSegmentId() const noexcept { return m_rawMemory.get_pool_id(); }
     
     /// @brief 获取数据区偏移量
     /// @return 相对于数据区基地址的偏移量
@@ -64,27 +106,145 @@ public:
     /// @brief 从空闲链表中获取一个 chunk 索引
     /// @param index 输出参数，存储获取到的索引
     /// @return 成功返回 true，失败返回 false
-    bool allocateChunk(uint32_t& index) noexcept { return m_freeIndices.pop(index); }
+    /// @note 依次尝试回收栈、冷链表和从未使用的区间：物理页已回收的冷 chunk 在热 chunk 用完后才被复用
+    bool allocateChunk(uint32_t& index) noexcept
+    {
+        return countCasRetries([&]() noexcept {
+            return m_freeIndices.popRecycledBatch(&index, 1U) == 1U
+                   || m_coldIndices.popRecycledBatch(&index, 1U) == 1U
+                   || m_freeIndices.pop(index);
+        });
+    }
     
     /// @brief 将 chunk 索引归还到空闲链表
     /// @param index 要归还的索引
     /// @return 成功返回 true，失败返回 false
-    bool freeChunk(uint32_t index) noexcept { return m_freeIndices.push(index); }
+    bool freeChunk(uint32_t index) noexcept
+    {
+        return countCasRetries([&]() noexcept { return m_freeIndices.push(index); });
+    }
+    
+    /// @brief 从空闲链表中批量获取 chunk 索引（一次 CAS）
+    /// @param indices 输出数组
+    /// @param maxCount 最多获取的数量
+    /// @return 实际获取的数量
+    uint32_t allocateChunks(uint32_t* indices, uint32_t maxCount) noexcept
+    {
+        return countCasRetries([&]() noexcept {
+            uint32_t count = m_freeIndices.popRecycledBatch(indices, maxCount);
+            if (count == 0U)
+            {
+                count = m_coldIndices.popRecycledBatch(indices, maxCount);
+            }
+            return (count == 0U) ? m_freeIndices.popBatch(indices, maxCount) : count;
+        });
+    }
+    
+    /// @brief 摘下回收栈中最热的 hotDepth 个 chunk 之后的冷尾（按由热到冷的顺序写入 indices）
+    /// @param indices 输出数组，容量至少为 getCapacity()
+    /// @note 热的部分留在原位，并发分配不受影响；不会取从未使用过的 chunk。用于回收空闲 chunk 的物理页
+    uint32_t detachColdChunks(uint32_t hotDepth, uint32_t* indices) noexcept
+    {
+        return countCasRetries([&]() noexcept { return m_freeIndices.detachTail(hotDepth, indices); });
+    }
+    
+    /// @brief 把一批 chunk 索引放入冷链表（一次 CAS；回收栈为空时才从冷链表分配）
+    bool appendColdChunks(const uint32_t* indices, uint32_t count) noexcept
+    {
+        return countCasRetries([&]() noexcept { return m_coldIndices.pushBatch(indices, count); });
+    }
+    
+    /// @brief 将一批 chunk 索引归还到空闲链表（一次 CAS）
+    /// @param indices 要归还的索引数组
+    /// @param count 索引数量
+    /// @return 成功返回 true，失败返回 false
+    bool freeChunks(const uint32_t* indices, uint32_t count) noexcept
+    {
+        return countCasRetries([&]() noexcept { return m_freeIndices.pushBatch(indices, count); });
+    }
+    
+    /// @brief 空闲链表的索引数组（本进程地址），可供同一池的其他链表共用（如所有者的预留链表）
+    uint32_t* getFreeListMemory() const noexcept { return m_freeIndices.getIndexMemory(); }
+    
+    /// @brief 至少被分配过一次的 chunk 索引上界：[0, 返回值) 之外的控制块从未初始化
+    uint32_t getTouchedChunks() const noexcept { return m_freeIndices.getTouchedCount(); }
+    
+    /// @brief 启用一个新扩容段：索引 [getTotalChunks(), getTotalChunks() + getSegmentChunks()) 加入空闲链表
+    /// @note 调用者负责串行化，并保证新段已经创建且可以被其他进程按名字打开
+    /// @return 已达到 capacity 时返回 false
+    bool activateSegment() noexcept;
     
-    /// @brief 增加已使用 chunk 计数
-    void incrementUsedCount() noexcept { m_usedChunk.fetch_add(1, std::memory_order_relaxed); }
+    /// @brief 停用初始段：外部池在登记区域之前没有可用的 chunk（登记后由 activateSegment 启用）
+    void deactivateInitialSegment() noexcept;
     
-    /// @brief 减少已使用 chunk 计数
-    void decrementUsedCount() noexcept { m_usedChunk.fetch_sub(1, std::memory_order_relaxed); }
+    /// @brief 增加已使用 chunk 计数并更新高水位（推算模式下只加当前 CPU 的遥测分片，不维护高水位）
+    /// @note 高水位与已使用计数在同一 cache line，只有超过旧值时才写
+    void incrementUsedCount(uint32_t count = 1U) noexcept
+    {
+        if (m_deriveUsedCount)
+        {
+            m_telemetry.addUsed(count);
+        }
+        else
+        {
+            const uint32_t used = m_usedChunk.fetch_add(count, std::memory_order_relaxed) + count;
+            uint32_t highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+            while (used > highWaterMark
+                   && !m_highWaterMark.compare_exchange_weak(highWaterMark, used, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+    
+    /// @brief 减少已使用 chunk 计数（推算模式下减当前 CPU 的遥测分片）
+    void decrementUsedCount(uint32_t count = 1U) noexcept
+    {
+        if (m_deriveUsedCount)
+        {
+            m_telemetry.subUsed(count);
+        }
+        else
+        {
+            m_usedChunk.fetch_sub(count, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief 已使用 chunk 数的历史最大值（用于确定池的大小）
+    /// @note 推算模式下为空闲链表水位：回收栈为空时水位才前进，此时水位以下的 chunk 全部在用
+    uint32_t getHighWaterMark() const noexcept
+    {
+        return m_deriveUsedCount ? m_freeIndices.getTouchedCount() : m_highWaterMark.load(std::memory_order_relaxed);
+    }
+    
+    /// @brief 分配/释放/失败/CAS 重试计数（由 MemPoolManager 在分配和归还路径上累加）
+    PoolTelemetry& getTelemetry() noexcept { return m_telemetry; }
+    const PoolTelemetry& getTelemetry() const noexcept { return m_telemetry; }
 
 private:
+    /// @brief 执行一次空闲链表操作，把本线程在其间的 CAS 失败次数记到本池
+    template <typename Operation>
+    std::invoke_result_t<Operation&> countCasRetries(Operation&& operation) noexcept
+    {
+        const uint64_t retriesBefore = Concurrent::MPMC_LockFree_List::casRetriesOfThisThread();
+        const auto result = operation();
+        m_telemetry.recordCasRetries(Concurrent::MPMC_LockFree_List::casRetriesOfThisThread() - retriesBefore);
+        return result;
+    }
+    
     ZeroCP::RelativePointer<void> m_rawMemory;      ///< 数据池的基地址相对指针
     uint64_t m_chunkSize{0};                        ///< 当前的池的chunk大小
-    uint32_t m_chunkNums{0};                        ///< 当前的池的chunk数量
-    std::atomic<uint32_t> m_usedChunk{0};           ///< 当前的池的已使用chunk数量
+    ChunkSetting m_chunkSetting;                    ///< 当前的池的chunk布局
+    uint32_t m_chunkNums{0};                        ///< 当前的池每个段的chunk数量
+    uint32_t m_capacity{0};                         ///< 当前的池的最大chunk数量（含扩容段）
+    std::atomic<uint32_t> m_activeChunks{0};        ///< 当前的池已启用的chunk数量（只在扩容时写入）
+    bool m_deriveUsedCount{false};                  ///< 已使用计数由遥测分片推算，不维护 m_usedChunk
     uint64_t m_pool_id{0};                          ///< 当前的池的id
     uint64_t m_dataOffset{0};                       ///< 池首偏移（相对于数据区基地址），用于多进程通信
-    ZeroCP::Concurrent::MPMC_LockFree_List m_freeIndices; ///< 当前的池的空闲chunk索引链表
+    ZeroCP::Concurrent::MPMC_LockFree_List m_freeIndices; ///< 当前的池的空闲chunk索引链表（独占 cache line）
+    ZeroCP::Concurrent::MPMC_LockFree_List m_coldIndices; ///< 物理页已回收的空闲chunk索引链表（与 m_freeIndices 共用索引数组）
+    alignas(64) std::atomic<uint32_t> m_usedChunk{0}; ///< 当前的池的已使用chunk数量（与高水位共用一个 cache line）
+    std::atomic<uint32_t> m_highWaterMark{0};         ///< 已使用chunk数量的历史最大值
+    PoolTelemetry m_telemetry;                        ///< 按 CPU 分片的遥测计数（每片独占 cache line）
 };
 
 }
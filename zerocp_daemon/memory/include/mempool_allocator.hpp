@@ -51,18 +51,22 @@ public:
     /// @param mgmtMemorySize 管理内存区大小
     /// @param mempools 返回指向共享内存中创建的 MemPool vector 的指针
     /// @param chunkManagerPool 返回指向共享内存中创建的 ChunkManager pool 的指针
+    /// @param largeChunkSlotMemory 返回大块 chunk 控制块槽位空闲链表的索引数组（未启用大块段时为 nullptr）
     /// @return 成功返回 true，失败返回 false
     bool ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mgmtMemorySize,
                                 vector<MemPool, 16>& mempools,
-                                vector<MemPool, 1>& chunkManagerPool) noexcept;
+                                vector<MemPool, 1>& chunkManagerPool,
+                                void*& largeChunkSlotMemory) noexcept;
     
     /// @brief 布局数据内存区（分配 chunk 块并设置到 MemPool）
     /// @param baseAddress 数据内存区基地址
     /// @param memorySize 数据内存区大小
     /// @param mempools 共享内存中的 MemPool vector 引用
+    /// @param largeChunkArena 返回大块段（TLSF 堆）的起始地址，位于所有池之后、按页对齐（未启用时为 nullptr）
     /// @return 成功返回 true，失败返回 false
     bool ChunkMemoryLayout(void* baseAddress, uint64_t memorySize,
-                          vector<MemPool, 16>& mempools) noexcept;
+                          vector<MemPool, 16>& mempools,
+                          void*& largeChunkArena) noexcept;
     
 private:
     /// @brief 内存池配置引用
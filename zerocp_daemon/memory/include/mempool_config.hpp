@@ -3,12 +3,32 @@
 
 #include <cstdint>
 #include "vector.hpp"
+#include "chunk_setting.hpp"
 
 namespace ZeroCP
 {
 namespace Memory
 {
 
+/// @brief 目标尺寸级别耗尽时 getChunk 的回退策略
+enum class ChunkFallbackPolicy : uint8_t
+{
+    NONE = 0,       ///< 不回退：目标池为空即分配失败
+    NEXT_LARGER,    ///< 回退到下一个更大的尺寸级别
+    ANY_LARGER      ///< 依次尝试所有更大的尺寸级别
+};
+
+/// @brief 数据区（chunk 段）的页类型
+/// @note 显式大页依赖 hugetlbfs 挂载（2 MiB: /dev/hugepages，1 GiB: /dev/hugepages1G）
+///       和预留的大页；不可用时自动回退到 TRANSPARENT
+enum class HugePageMode : uint8_t
+{
+    NONE = 0,       ///< 普通 4 KiB 页（POSIX 共享内存）
+    TRANSPARENT,    ///< POSIX 共享内存 + madvise(MADV_HUGEPAGE)，需内核开启 shmem THP
+    EXPLICIT_2M,    ///< hugetlbfs 上的 2 MiB 显式大页
+    EXPLICIT_1G     ///< hugetlbfs 上的 1 GiB 显式大页（段大小向上取整到 1 GiB）
+};
+
 /// @brief 内存池配置（完全可在共享内存中）
 /// @note 使用 ZeroCP::vector 替代 std::vector 以支持共享内存
 struct MemPoolConfig
@@ -18,17 +38,59 @@ struct MemPoolConfig
     {
         MemPoolEntry() noexcept = default;
         
-        MemPoolEntry(uint64_t chunkSize, uint32_t chunkCount) noexcept 
-            : m_chunkSize(chunkSize), m_chunkCount(chunkCount)
+        MemPoolEntry(uint64_t chunkSize, uint32_t chunkCount, uint32_t numaNode = 0U,
+                     uint32_t maxGrowthSegments = 0U) noexcept 
+            : m_chunkSize(chunkSize), m_chunkCount(chunkCount), m_numaNode(numaNode)
+            , m_maxGrowthSegments(maxGrowthSegments)
     {}
         
         uint64_t m_chunkSize {0};   ///< 单个 chunk 大小（重命名自 m_poolSize）
         uint32_t m_chunkCount{0};   ///< chunk 数量（重命名自 m_poolCount）
+        uint32_t m_numaNode{0};     ///< 该池的 chunk 绑定到的 NUMA 节点（单节点机器上统一视为节点 0）
+        uint32_t m_maxGrowthSegments{0}; ///< 运行时最多追加的段数（每段 m_chunkCount 个 chunk，0 表示不扩容）
+        uint32_t m_ownerQuota{0};   ///< 每个进程在该池最多同时持有的 chunk 数（含预留，0 表示不限）
+        uint32_t m_userPayloadAlignment{ChunkSetting::kDefaultAlignment}; ///< 用户数据对齐（如 64 用于 AVX-512，4096 用于 DMA）
+        uint32_t m_userHeaderSize{0};                                     ///< 每个 chunk 的用户头大小（0 表示没有）
+        uint32_t m_userHeaderAlignment{ChunkSetting::kDefaultAlignment};  ///< 用户头对齐
+        bool m_external{false};     ///< chunk 数组位于使用者登记的外部区域（不占数据区，不参与按大小选池）
     };
     
+    /// @brief 支持的最大 NUMA 节点数（超出的节点号按节点 0 处理）
+    static constexpr uint32_t kMaxNumaNodes = 8U;
+    
+    /// @brief 所有池合计最多的扩容段数（每个扩容段占用一个固定的 PoolRegistry 池ID）
+    static constexpr uint32_t kMaxGrowthSegments = 46U;
+    
     /// @brief 内存池配置列表（最多支持 16 个内存池）
     ZeroCP::vector<MemPoolEntry, 16> m_memPoolEntries;
 
+    /// @brief 目标池耗尽时的回退策略
+    ChunkFallbackPolicy m_fallbackPolicy{ChunkFallbackPolicy::NEXT_LARGER};
+
+    /// @brief 数据区使用的页类型
+    HugePageMode m_hugePageMode{HugePageMode::NONE};
+
+    /// @brief createSharedInstance 返回前预取管理区和数据区的所有页（避免首批发布承担缺页延迟）
+    bool m_prefaultSegments{false};
+
+    /// @brief 预取使用的线程数（0 表示使用硬件并发数）
+    uint32_t m_prefaultThreads{0};
+
+    /// @brief createSharedInstance 返回前 mlock 管理区和数据区（受 RLIMIT_MEMLOCK 限制，失败只告警）
+    bool m_lockSegments{false};
+
+    /// @brief 不维护每个池共享的已使用计数，改为在按 CPU 分片的遥测计数中累加，查询时把各片相加
+    /// @note 分配/释放不再争用同一个计数所在的 cache line（写的是刚写过分配计数的本 CPU 分片）；
+    ///       代价是 getUsedChunks 变为 16 次读取，高水位改由空闲链表水位近似
+    bool m_deriveUsedCount{false};
+
+    /// @brief 大块段（TLSF 堆）的大小（字节，0 表示不启用）
+    /// @note 超过最大尺寸级别的 getChunk 请求从大块段按实际字节分配，不再需要按最坏情况配置大尺寸级别的池
+    uint64_t m_largeChunkSegmentSize{0};
+
+    /// @brief 大块段中同时存在的 chunk 的最大数量（每个占用一个控制块）
+    uint32_t m_largeChunkSlots{0};
+
     /// @brief 默认构造函数
     MemPoolConfig() noexcept = default;
 
@@ -50,8 +112,56 @@ struct MemPoolConfig
     /// @brief 添加内存池配置项
     /// @param chunkSize 单个 chunk 的大小（字节）
     /// @param chunkCount chunk 的数量
+    /// @param numaNode 该池所属的 NUMA 节点（默认节点 0）
+    /// @param maxGrowthSegments 运行时最多追加的段数（每段 chunkCount 个 chunk，默认不扩容）
     /// @return 成功返回 true，失败（超出容量）返回 false
-    bool addMemPoolEntry(uint64_t chunkSize, uint32_t chunkCount) noexcept;
+    bool addMemPoolEntry(uint64_t chunkSize, uint32_t chunkCount, uint32_t numaNode = 0U,
+                         uint32_t maxGrowthSegments = 0U) noexcept;
+
+    /// @brief 添加外部池：chunk 数组由使用者在运行时登记的共享内存/memfd 区域提供
+    /// @param chunkSize 单个 chunk 的用户数据大小（字节）
+    /// @param chunkCount 区域中的 chunk 数量
+    /// @return 成功返回 true，失败（超出容量）返回 false
+    /// @note 外部池占用一个扩容段ID，不能扩容；getChunk(size) 不会选中外部池，
+    ///       只能通过 MemPoolManager::getChunkFromPool 从中分配（见 MemPoolManager::registerExternalRegion）
+    bool addExternalPoolEntry(uint64_t chunkSize, uint32_t chunkCount) noexcept;
+
+    /// @brief 设置每个进程在第 entryIndex 个池上的默认配额
+    /// @param maxChunksPerOwner 每个进程最多同时持有的 chunk 数（含预留，0 表示不限）
+    /// @return entryIndex 越界时返回 false
+    bool setOwnerQuota(uint64_t entryIndex, uint32_t maxChunksPerOwner) noexcept;
+
+    /// @brief 启用大块段：变长/大块 chunk 在数据区末尾的 TLSF 堆中按实际大小分配（O(1) 分配/释放）
+    /// @param segmentSize 堆的大小（字节，向上取整到 64，不超过 TlsfHeap::kMaxArenaSize）
+    /// @param maxChunks 同时存在的大块 chunk 的最大数量
+    /// @return 参数无效时不做修改并返回 false
+    bool setLargeChunkSegment(uint64_t segmentSize, uint32_t maxChunks) noexcept;
+
+    /// @brief 设置第 entryIndex 个池的 chunk 布局：用户数据对齐和可选的用户头
+    /// @param userPayloadAlignment 池中每个 chunk 的用户数据对齐（2 的幂，不超过 ChunkSetting::kMaxAlignment）
+    /// @param userHeaderSize 用户头大小（0 表示没有用户头）
+    /// @param userHeaderAlignment 用户头对齐
+    /// @return entryIndex 越界或布局参数无效时不做修改并返回 false
+    bool setChunkLayout(uint64_t entryIndex, uint32_t userPayloadAlignment, uint32_t userHeaderSize = 0U,
+                        uint32_t userHeaderAlignment = ChunkSetting::kDefaultAlignment) noexcept;
+
+    /// @brief 第 entryIndex 个池的 chunk 布局（每个池在布局时计算一次）
+    ChunkSetting getChunkSetting(uint64_t entryIndex) const noexcept;
+
+    /// @brief 把当前（节点 0 的）池集合复制到节点 1 ~ nodeCount-1，每个节点一套
+    /// @param nodeCount NUMA 节点数（1 表示不复制）
+    /// @return 成功返回 true；池总数会超过 16 或 nodeCount 超过 kMaxNumaNodes 时不做修改并返回 false
+    bool replicatePoolsForNumaNodes(uint32_t nodeCount) noexcept;
+
+    /// @brief 配置中出现的最大节点号 + 1
+    uint32_t getNumaNodeCount() const noexcept;
+
+    /// @brief 第 entryIndex 个池实际可用的扩容段数
+    /// @note 按配置顺序分配：所有池合计不超过 kMaxGrowthSegments（每个外部池占用一个），池的最大 chunk 数不超过 uint32 索引范围
+    uint32_t getGrowthSegmentCount(uint64_t entryIndex) const noexcept;
+
+    /// @brief 第 entryIndex 个池的最大 chunk 数（初始段 + 所有扩容段）
+    uint32_t getPoolCapacity(uint64_t entryIndex) const noexcept;
 
     /// @brief 获取内存池配置信息
     void getMemPoolConfigInfo() noexcept;
@@ -1,17 +1,123 @@
 #ifndef ZEROCP_MEMPOOL_INTROSPECTION_HPP
 #define ZEROCP_MEMPOOL_INTROSPECTION_HPP
 
+#include "mempool_manager.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief 一个所有者在一个池上的用量快照
+struct ChunkOwnerUsage
+{
+    uint32_t m_ownerSlot{0};        ///< 所有者槽位
+    uint32_t m_pid{0};              ///< 所有者进程号
+    uint32_t m_poolIndex{0};        ///< 池索引
+    uint64_t m_chunkSize{0};        ///< 池的 chunk 大小
+    uint32_t m_heldChunks{0};       ///< 从共享空闲链表分配、尚未释放的 chunk 数
+    uint32_t m_reservedChunks{0};   ///< 预留的 chunk 数
+    uint32_t m_quotaChunks{0};      ///< 配额（0 表示不限）
+    uint64_t m_quotaRejections{0};  ///< 该所有者因超出配额被拒绝的分配次数（所有池合计）
+};
+
+/// @brief 一个池的容量与分配遥测快照
+struct MemPoolUsage
+{
+    uint32_t m_poolIndex{0};            ///< 池索引
+    uint64_t m_chunkSize{0};            ///< 池的 chunk 大小
+    uint32_t m_totalChunks{0};          ///< 当前可用的 chunk 总数（含已扩容的段）
+    uint32_t m_capacity{0};             ///< 扩容上限
+    uint32_t m_usedChunks{0};           ///< 已使用的 chunk 数
+    uint32_t m_highWaterMark{0};        ///< 已使用 chunk 数的历史最大值
+    uint64_t m_allocations{0};          ///< 成功分配的 chunk 数
+    uint64_t m_frees{0};                ///< 归还的 chunk 数
+    uint64_t m_failedAllocations{0};    ///< 以该池为目标、没有分配到 chunk 的请求数
+    uint64_t m_casRetries{0};           ///< 空闲链表 CAS 失败重试次数（竞争程度）
+};
+
+/// @brief 内存池内省：只读地采集共享内存中的用量计数（任意已连接的进程都可以使用）
 class MempoolIntrospection
 {
 public:
-    MempoolIntrospection() = default;
+    explicit MempoolIntrospection(const MemPoolManager& manager) noexcept
+        : m_manager(manager)
+    {
+    }
     MempoolIntrospection(const MempoolIntrospection& other) = delete;
     MempoolIntrospection(MempoolIntrospection&& other) noexcept = delete;
     MempoolIntrospection& operator=(const MempoolIntrospection& other) = delete;
     MempoolIntrospection& operator=(MempoolIntrospection&& other) noexcept = delete;
     ~MempoolIntrospection() noexcept = default;
+
+    /// @brief 采集所有已登记所有者的用量（每个所有者只列出有用量、预留或配额的池）
+    /// @note 各计数分别读取，快照不是原子的，只用于监控
+    std::vector<ChunkOwnerUsage> getOwnerUsage() const
+    {
+        std::vector<ChunkOwnerUsage> usage;
+        const auto& mempools = m_manager.getMemPools();
+        for (uint32_t ownerSlot = 0U; ownerSlot < MemPoolManager::kMaxChunkOwners; ++ownerSlot)
+        {
+            const ChunkOwnerAccount& account = m_manager.getOwnerAccount(ownerSlot);
+            const uint32_t pid = account.m_pid.load(std::memory_order_relaxed);
+            if (pid == 0U)
+            {
+                continue;
+            }
+            for (uint32_t poolIndex = 0U; poolIndex < mempools.size(); ++poolIndex)
+            {
+                ChunkOwnerUsage entry;
+                entry.m_ownerSlot = ownerSlot;
+                entry.m_pid = pid;
+                entry.m_poolIndex = poolIndex;
+                entry.m_chunkSize = mempools[poolIndex].getChunkSize();
+                entry.m_heldChunks = account.m_heldChunks[poolIndex].load(std::memory_order_relaxed);
+                entry.m_reservedChunks = account.m_reservedChunks[poolIndex].load(std::memory_order_relaxed);
+                entry.m_quotaChunks = account.m_quotaChunks[poolIndex].load(std::memory_order_relaxed);
+                entry.m_quotaRejections = account.m_quotaRejections.load(std::memory_order_relaxed);
+                if (entry.m_heldChunks != 0U || entry.m_reservedChunks != 0U || entry.m_quotaChunks != 0U)
+                {
+                    usage.push_back(entry);
+                }
+            }
+        }
+        return usage;
+    }
+
+    /// @brief 采集每个数据池的容量、高水位和分配遥测（按 CPU 分片的计数在这里相加）
+    /// @note 各计数分别读取，快照不是原子的，只用于监控和确定池的大小
+    std::vector<MemPoolUsage> getPoolUsage() const
+    {
+        std::vector<MemPoolUsage> usage;
+        const auto& mempools = m_manager.getMemPools();
+        usage.reserve(mempools.size());
+        for (uint32_t poolIndex = 0U; poolIndex < mempools.size(); ++poolIndex)
+        {
+            const MemPool& pool = mempools[poolIndex];
+            const PoolTelemetry::Snapshot telemetry = pool.getTelemetry().snapshot();
+            MemPoolUsage entry;
+            entry.m_poolIndex = poolIndex;
+            entry.m_chunkSize = pool.getChunkSize();
+            entry.m_totalChunks = pool.getTotalChunks();
+            entry.m_capacity = pool.getCapacity();
+            entry.m_usedChunks = pool.getUsedChunks();
+            entry.m_highWaterMark = pool.getHighWaterMark();
+            entry.m_allocations = telemetry.m_allocations;
+            entry.m_frees = telemetry.m_frees;
+            entry.m_failedAllocations = telemetry.m_failedAllocations;
+            entry.m_casRetries = telemetry.m_casRetries;
+            usage.push_back(entry);
+        }
+        return usage;
+    }
+
 private:
-}
+    const MemPoolManager& m_manager;
+};
 
+} // namespace Memory
+} // namespace ZeroCP
 
 #endif // ZEROCP_MEMPOOL_INTROSPECTION_HPP
@@ -4,17 +4,28 @@
 #include "mempool_config.hpp"
 #include "mempool.hpp"
 #include "chunk_manager.hpp"
+#include "chunk_magazine.hpp"
+#include "chunk_owner_account.hpp"
+#include "external_region.hpp"
+#include "tlsf_heap.hpp"
+#include "mpmclockfreelist.hpp"
 #include "vector.hpp"
 #include "relative_pointer.hpp"
 #include <pthread.h>
 #include <semaphore.h>
 #include <cstdint>
 #include <memory>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <sys/uio.h>
 
 // 前向声明
 namespace ZeroCP {
 namespace Memory {
 class PosixShmProvider;
+struct ChunkHeader;
 }
 }
 
@@ -42,6 +53,21 @@ public:
     /// @return 成功返回 true
     static bool createSharedInstance(const MemPoolConfig& config) noexcept;
     
+    /// @brief 管理区和数据区共享内存的大小
+    struct SegmentSizes
+    {
+        uint64_t m_managementSize{0};   ///< MemPoolManager 对象 + freeList + 控制块
+        uint64_t m_chunkMemorySize{0};  ///< 所有池的 chunk 数据（不含扩容段）
+    };
+    
+    /// @brief 按配置计算两个共享内存段的大小（createSharedInstance(config) 内部使用）
+    static SegmentSizes computeSegmentSizes(const MemPoolConfig& config) noexcept;
+    
+    /// @brief 使用已知的段大小创建共享实例，跳过启动时的布局计算
+    /// @param sizes 必须等于 computeSegmentSizes(config)，如 StaticMemPoolConfig 在编译期算出的大小
+    /// @return 创建进程发现 sizes 与配置的实际布局不一致时拒绝创建（删除已创建的段）并返回 false
+    static bool createSharedInstance(const MemPoolConfig& config, const SegmentSizes& sizes) noexcept;
+    
     /// @brief 连接到已存在的共享内存实例（客户端使用）
     /// @return 成功返回 true
     /// @note 客户端不需要提供配置，直接连接到服务端创建的共享内存
@@ -75,51 +101,530 @@ public:
     
     /// @brief 计算总共需要的内存大小（包括MemPoolManager对象本身）
     uint64_t getTotalMemorySize() const noexcept;
+    
+    /// @brief 按本对象的配置计算两个段的大小（只在创建进程初始化时有效，m_config 之后不再可信）
+    SegmentSizes layoutSegmentSizes() const noexcept;
 
     // ==================== 核心分配/释放接口 ====================
     
     /// @brief 分配指定大小的 chunk
     /// @param size 请求的内存大小（字节）
+    /// @param alignment 用户数据的对齐要求（2 的幂，默认 8 字节）
     /// @return 成功返回 ChunkManager 指针，失败返回 nullptr
-    /// @note 自动选择最小满足条件的内存池
-    ChunkManager* getChunk(uint64_t size) noexcept;
+    /// @note 自动选择最小满足条件的内存池（对齐超过 8 字节时预留填充空间）；
+    ///       没有池放得下时从大块段按实际大小分配（见 MemPoolConfig::setLargeChunkSegment）
+    ChunkManager* getChunk(uint64_t size, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 分配指定大小的 chunk，候选池耗尽时最多等待 timeout
+    /// @param size 请求的内存大小（字节）
+    /// @param timeout 最长等待时间（0 等同于非阻塞的 getChunk）
+    /// @param alignment 用户数据的对齐要求（2 的幂，默认 8 字节）
+    /// @return 成功返回 ChunkManager 指针，超时或没有满足条件的池时返回 nullptr
+    /// @note 先自旋重试 kBlockingSpinDuration，仍然失败再在管理器共用的 futex 字上休眠：
+    ///       等待者登记在所有候选池（各 NUMA 节点的目标尺寸级别和回退策略允许的更大级别）上，
+    ///       任意进程向其中任一池归还 chunk（含线程弹匣的归还和冲刷）时被唤醒并重试全部候选池；
+    ///       短暂的背压不会让低延迟调用者进入休眠。从大块段分配的请求不等待
+    ChunkManager* getChunk(uint64_t size, std::chrono::nanoseconds timeout, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 直接从指定的池分配，不做尺寸级别查找也不回退（池为空时返回 nullptr）
+    /// @param poolIndex 池索引，调用者保证该池能容纳 size/alignment（见 StaticMemPoolConfig::getChunk）
+    ChunkManager* getChunkFromPool(uint32_t poolIndex, uint64_t size, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 阻塞分配在休眠前自旋重试的时长
+    static constexpr std::chrono::nanoseconds kBlockingSpinDuration{std::chrono::microseconds(20)};
     
     /// @brief 释放 chunk（引用计数减到0时才真正释放）
     /// @param chunkManager chunk 管理器指针
     /// @return 成功返回 true
     bool releaseChunk(ChunkManager* chunkManager) noexcept;
     
+    /// @brief 批量分配 chunk（用于突发发布，如传感器帧扇出）
+    /// @param size 每个 chunk 的请求大小（字节）
+    /// @param count 请求的 chunk 数量
+    /// @param chunks 输出数组，至少能容纳 count 个指针
+    /// @param alignment 用户数据的对齐要求（2 的幂，默认 8 字节）
+    /// @return 实际分配的数量（目标池和回退池都耗尽时可能少于 count）
+    /// @note 每批最多 kMaxBatchSize 个索引只需一次 CAS，统计信息每批只更新一次；
+    ///       批量接口不经过线程弹匣
+    uint32_t getChunks(uint64_t size, uint32_t count, ChunkManager** chunks, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 批量释放 chunk 引用（引用计数归零的 chunk 按池分组一次归还）
+    /// @param chunkManagers 要释放的 chunk 管理器指针（nullptr 被忽略）
+    /// @return 全部成功返回 true
+    bool releaseChunks(std::span<ChunkManager* const> chunkManagers) noexcept;
+    
+    /// @brief 批量接口单次 CAS 处理的最大索引数
+    static constexpr uint32_t kMaxBatchSize = 64U;
+    
     /// @brief 通过索引获取 ChunkManager（用于跨进程重建）
-    /// @param index ChunkManager 在 ChunkManagerPool 中的索引
+    /// @param index 控制块索引（ChunkManager::m_chunkManagerIndex）
     /// @return ChunkManager 指针，失败返回 nullptr
-    /// @note 用于接收端根据索引重建 ChunkManager 指针
+    /// @note 纯地址计算：控制块数组起始地址（RelativePointer）+ index * 64
     ChunkManager* getChunkManagerByIndex(uint32_t index) noexcept;
     
+    /// @brief 获取 chunk 的 ChunkHeader（按索引计算，任意进程可用）
+    /// @param chunkManager chunk 管理器指针
+    /// @return 本进程地址空间中的 ChunkHeader 指针，失败返回 nullptr
+    ChunkHeader* getChunkHeader(const ChunkManager* chunkManager) const noexcept;
+    
+    // ==================== 链式消息 ====================
+    
+    /// @brief 分配链式消息：负载按 getChainSegmentSize() 切段，每段一个普通池 chunk，段之间用控制块索引相连
+    /// @param size 整条消息的负载大小（字节）
+    /// @param alignment 每段用户数据的对齐要求（2 的幂，默认 8 字节）
+    /// @return 链头的 ChunkManager；任意一段分配失败时归还已分配的段并返回 nullptr
+    /// @note 放得进单个 chunk 的请求等同于 getChunk。链头的引用计数管理整条链：
+    ///       传输、retain/release 都只针对链头，跨进程只传链头索引。每段 ChunkHeader 的 m_userPayloadSize 为该段字节数
+    ChunkManager* getChunkChain(uint64_t size, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 链中的下一个 chunk（链尾或普通 chunk 返回 nullptr）
+    ChunkManager* getNextChunk(const ChunkManager* chunkManager) noexcept;
+    
+    /// @brief 以 iovec 列出消息各段的用户数据（可直接交给 writev/sendmsg）
+    /// @param chunkManager 链头（普通 chunk 视为只有一段）
+    /// @param segments 输出数组，最多填 segments.size() 段
+    /// @return 链的总段数（大于 segments.size() 说明数组不够大，可按返回值重新分配后再取）
+    uint32_t getChunkSegments(const ChunkManager* chunkManager, std::span<iovec> segments) noexcept;
+    
+    /// @brief 链式消息每段的最大负载：参与按大小选池的池中最大的容量（扣除对齐填充）
+    uint64_t getChainSegmentSize(uint32_t alignment = 8U) const noexcept;
+    
+    // ==================== 线程弹匣（可选） ====================
+    
+    /// @brief 启用/禁用每线程 chunk 弹匣（进程本地设置，默认禁用）
+    /// @note 启用后 getChunk/releaseChunk 优先使用线程私有弹匣，
+    ///       只有弹匣空/满时才批量访问共享空闲链表；
+    ///       代价是弹匣中的 chunk 暂时不能被其他线程分配
+    static void setThreadMagazinesEnabled(bool enabled) noexcept;
+    
+    /// @brief 检查每线程 chunk 弹匣是否启用
+    static bool isThreadMagazinesEnabled() noexcept;
+    
+    /// @brief 获取当前映射的代数（每次创建/连接/销毁共享实例时递增）
+    /// @note 用于识别内存池重建后失效的线程弹匣
+    static uint64_t getGeneration() noexcept;
+    
+    /// @brief 把当前线程弹匣中的所有 chunk 归还给共享空闲链表
+    void flushThreadMagazines() noexcept;
+    
+    // ==================== 所有者账户：预留与配额 ====================
+    
+    /// @brief 可同时登记的 chunk 所有者（进程）数量
+    static constexpr uint32_t kMaxChunkOwners = 32U;
+    
+    /// @brief 不记账的所有者槽位（进程未登记或账户表已满）
+    static constexpr uint32_t kNoChunkOwner = 0xFFFFU;
+    
+    /// @brief 守护进程回收死亡进程的引用期间占住槽位使用的进程号（登记时跳过）
+    static constexpr uint32_t kReclaimingPid = 0xFFFFFFFFU;
+    
+    /// @brief 为本进程预留 count 个满足 size/alignment 的 chunk（本地节点目标尺寸级别的池）
+    /// @details 预留的 chunk 离开共享空闲链表，进入本进程账户的私有链表。本进程的 getChunk
+    ///          先从私有链表分配，在预留数量之内确定性地成功，不受其他进程耗尽共享池的影响；
+    ///          这些 chunk 在任意进程中被释放后回到私有链表。预留计入本进程在该池的配额
+    /// @return 进程未登记、池中空闲 chunk 不足或超出配额时不预留任何 chunk 并返回 false
+    bool reserveChunks(uint64_t size, uint32_t count, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 取消 reserveChunks 预留的 count 个 chunk（参数与预留时相同）
+    /// @note 仍被借出的预留 chunk 在释放时回到共享空闲链表
+    void cancelReservation(uint64_t size, uint32_t count, uint32_t alignment = 8U) noexcept;
+    
+    /// @brief 设置所有者在池上的配额（最多同时持有的 chunk 数，含预留；0 表示不限）
+    /// @note 登记时账户使用 MemPoolEntry::m_ownerQuota，守护进程可以按进程单独调整
+    bool setOwnerQuota(uint32_t ownerSlot, uint32_t poolIndex, uint32_t maxChunks) noexcept;
+    
+    /// @brief 本进程的所有者槽位（未登记时为 kNoChunkOwner）
+    static uint32_t getOwnerSlot() noexcept;
+    
+    /// @brief 所有者账户（只读，供内省读取用量计数）
+    const ChunkOwnerAccount& getOwnerAccount(uint32_t ownerSlot) const noexcept;
+    
+    // ==================== 引用持有账本：崩溃回收 ====================
+    
+    /// @brief 增加一个由本进程持有的引用（引用计数 +1，本进程账本 +1）
+    void retainChunk(ChunkManager* chunkManager) noexcept;
+    
+    /// @brief 本进程接管一个在途引用（引用计数不变，本进程账本 +1），如从接收队列取出的索引
+    /// @note prepareForTransfer 产生的引用在被接收方接管之前不记在任何进程的账本上：
+    ///       它在接收队列中，死亡进程的接收队列由守护进程清空
+    void adoptChunk(ChunkManager* chunkManager) noexcept;
+    
+    /// @brief 回收已死亡进程持有的全部引用，并归还它的预留、释放它的所有者槽位
+    /// @param pid 死亡进程的进程号（未登记所有者槽位时什么也不做）
+    /// @return 扣除的引用数
+    /// @note 守护进程在心跳超时并清空死亡进程的接收队列后调用；耗时与已分配过的 chunk 数成正比。
+    ///       心跳超时不等于死亡（进程可能只是被暂停）：进程仍存在时什么也不做，由调用者稍后重试。
+    ///       线程弹匣中缓存的空闲索引是进程私有的，无法回收
+    uint64_t reclaimChunksOfProcess(uint32_t pid) noexcept;
+    
+    /// @brief 进程是否仍然存在（kill(pid, 0) 没有返回 ESRCH；EPERM 也视为存在）
+    static bool isProcessAlive(uint32_t pid) noexcept;
+    
+    // ==================== 尺寸级别查找 ====================
+    
+    /// @brief 设置目标池耗尽时的回退策略（保存在共享内存中，对所有进程生效）
+    void setFallbackPolicy(ChunkFallbackPolicy policy) noexcept;
+    
+    /// @brief 获取当前的回退策略
+    ChunkFallbackPolicy getFallbackPolicy() const noexcept;
+    
+    /// @brief 查找满足 size 的最小内存池（优先调用线程所在 NUMA 节点的池）
+    /// @param size 请求大小（已包含对齐填充）
+    /// @return 内存池索引，没有满足条件的池时返回 m_mempools.size()
+    uint32_t findPoolIndex(uint64_t size) const noexcept;
+    
+    // ==================== NUMA ====================
+    
+    /// @brief 多节点配置下每个池的数据起始地址按此对齐，保证每个池可以单独 mbind
+    static constexpr uint64_t kNumaPoolAlignment = 4096U;
+    
+    /// @brief 生效的 NUMA 节点数（机器不支持 NUMA 或配置只有一个节点时为 1）
+    uint32_t getNumaNodeCount() const noexcept;
+    
+    /// @brief 池实际所属的 NUMA 节点（配置的节点在本机不存在时为 0）
+    uint32_t getPoolNumaNode(uint32_t poolIndex) const noexcept;
+    
+    /// @brief 本地节点没有可用 chunk、从其他节点分配的次数（所有进程累计）
+    uint64_t getNumaRemoteAllocationCount() const noexcept;
+    
+    // ==================== 运行时扩容 ====================
+    
+    /// @brief 为池追加一个扩容段（每段与初始段的 chunk 数相同，最多 MemPoolEntry::m_maxGrowthSegments 段）
+    /// @return 成功返回 true；不是创建进程、已达上限或创建共享内存失败时返回 false
+    /// @note 只有创建进程（守护进程）可以扩容；其他进程第一次遇到新段中的 chunk 时按段ID映射该段
+    bool growPool(uint32_t poolIndex) noexcept;
+    
+    /// @brief 为空闲比例低于 freePercent% 且仍可扩容的池各追加一个段（守护进程周期性调用）
+    /// @return 本次追加的段数
+    uint32_t growPoolsBelowWatermark(uint32_t freePercent) noexcept;
+    
+    /// @brief 池当前的段数（初始段 + 已追加的扩容段）
+    uint32_t getPoolSegmentCount(uint32_t poolIndex) const noexcept;
+    
+    // ==================== 外部区域 ====================
+    
+    /// @brief 把使用者已有的 POSIX 共享内存登记为外部池的 chunk 区域（任意已连接的进程都可以登记，每个外部池一次）
+    /// @param poolIndex 用 MemPoolConfig::addExternalPoolEntry 声明的池
+    /// @param shmName shm_open 使用的名称（其他进程按此名称映射区域）
+    /// @param offset chunk 数组在区域中的偏移（按池的 chunk 对齐），区域至少需要 offset + chunk 步长 x chunk 数 字节
+    /// @return 成功后池中的 chunk 立即可以通过 getChunkFromPool 分配；不是外部池、已登记或区域不满足要求时返回 false
+    /// @note 区域按 chunk 步长划分，每个 chunk 以 ChunkHeader 开头；使用者把数据直接写进 chunk 的用户数据区后发布，
+    ///       所有接收者读取的就是区域中的原始数据。区域在共享实例销毁前必须保持存在
+    bool registerExternalRegion(uint32_t poolIndex, const char* shmName, uint64_t offset = 0U) noexcept;
+    
+    /// @brief 把 memfd（或其他可以 mmap 的 fd）登记为外部池的 chunk 区域
+    /// @note 其他进程通过 /proc/<登记进程>/fd/<fd> 映射区域：登记进程必须保持 fd 打开，
+    ///       直到所有使用者都已映射（已映射的进程不受登记进程退出的影响）
+    bool registerExternalRegion(uint32_t poolIndex, int fd, uint64_t offset = 0U) noexcept;
+    
+    /// @brief 池是否为外部池
+    bool isExternalPool(uint32_t poolIndex) const noexcept;
+    
+    /// @brief 外部池的区域是否已登记
+    bool isExternalRegionRegistered(uint32_t poolIndex) const noexcept;
+    
+    // ==================== 大块段（TLSF 堆） ====================
+    
+    /// @brief 大块 chunk 控制块中的池索引（不属于任何固定尺寸的池）
+    static constexpr uint32_t kLargeChunkPool = 0xFFFFFFFFU;
+    
+    /// @brief 大块段在数据区中的对齐
+    static constexpr uint64_t kLargeChunkArenaAlignment = 4096U;
+    
+    /// @brief 是否配置了大块段
+    bool isLargeChunkSegmentEnabled() const noexcept;
+    
+    /// @brief 大块段的堆（只读统计：已用字节、块数、失败次数）
+    const TlsfHeap& getLargeChunkHeap() const noexcept;
+    
+    /// @brief 大块段中最大空闲块的可用字节数（加锁遍历一条链表，只用于监控）
+    uint64_t getLargestFreeLargeChunk() noexcept;
+    
+    // ==================== 空闲 chunk 物理页回收 ====================
+    
+    /// @brief 记录每个池自上次回收以来的已使用峰值（守护进程周期性调用，不在分配热路径上）
+    void sampleChunkUsage() noexcept;
+    
+    /// @brief 把每个池中冷的空闲 chunk 所占的整页还给内核（madvise(MADV_REMOVE)）
+    /// @details 空闲链表按 LIFO 复用：上次回收以来的复用深度 = 已使用峰值 - 当前已使用，
+    ///          回收栈中比复用深度（再加一批的余量）更深的 chunk 视为冷 chunk。
+    ///          回收期间冷 chunk 暂时离开空闲链表，之后放入池的冷链表；下次分配到它们时重新缺页（内容为 0）
+    /// @return 本次释放的字节数
+    uint64_t reclaimIdleChunks() noexcept;
+    
+    /// @brief 池的数据（本进程已映射的所有段）当前驻留在物理内存中的字节数（mincore）
+    uint64_t getPoolResidentBytes(uint32_t poolIndex) const noexcept;
+    
+    /// @brief 累计通过 reclaimIdleChunks 释放的字节数（所有进程共用）
+    uint64_t getReclaimedBytes() const noexcept;
+    
     /// @brief 打印所有内存池状态
     void printAllPoolStats() const noexcept;
     
+    // ==================== 页类型 ====================
+    
+    /// @brief 数据区实际使用的页类型（显式大页不可用时为回退后的结果）
+    HugePageMode getChunkHugePageMode() const noexcept;
+    
+    /// @brief 数据区映射的页大小（字节）
+    /// @note TRANSPARENT 模式下返回系统页大小，是否真正合并为大页由内核决定
+    uint64_t getChunkPageSize() const noexcept;
+    
     // ==================== 访问器接口 ====================
     
     /// @brief 获取内存池列表的引用
     /// @return 内存池列表的引用
     vector<MemPool, 16>& getMemPools() noexcept;
+    const vector<MemPool, 16>& getMemPools() const noexcept;
     
     /// @brief 获取 ChunkManager 内存池的引用
     /// @return ChunkManager 内存池的引用
     vector<MemPool, 1>& getChunkManagerPool() noexcept;
     
 private:
+    friend class ThreadMagazineCache;
+    
     // ==================== 私有构造函数 ====================
     
     /// @brief 构造函数（进程本地对象）
     /// @param config 配置对象引用
     explicit MemPoolManager(const MemPoolConfig& config) noexcept;
 
+    /// @brief 根据已布局的内存池构建尺寸级别查找表（布局完成后由创建进程调用一次）
+    void buildSizeClassTable() noexcept;
+    
+    /// @brief 计算每个池的控制块基址（布局完成后由创建进程调用一次，O(池数)）
+    void buildControlBlockTable() noexcept;
+    
+    /// @brief 数据 chunk 对应的控制块
+    ChunkManager* controlBlockOf(uint32_t poolIndex, uint32_t chunkIndex) noexcept;
+    
+    /// @brief 写入新分配 chunk 的控制块：引用计数 1，本进程为所有者和唯一持有者
+    static void initializeControlBlock(ChunkManager& chunkManager, uint32_t poolIndex, uint32_t chunkIndex,
+                                       uint32_t chunkManagerIndex, bool fromReservation) noexcept;
+    
+    /// @brief 计算 numaNode 上的候选池范围：目标尺寸级别 + 回退策略允许的更大级别（排序位置）
+    /// @return 该节点没有足够大的池时返回 false
+    bool findCandidatePositions(uint64_t size, uint32_t alignment, uint32_t numaNode,
+                                uint32_t& firstPosition, uint32_t& lastPosition) const noexcept;
+    
+    /// @brief 池的 chunk 能否容纳 size 字节、按 alignment 对齐的用户数据（含布局之外的对齐填充）
+    bool poolFits(uint32_t poolIndex, uint64_t size, uint32_t alignment) const noexcept;
+    
+    /// @brief getChunk 的实现
+    /// @param reportExhaustion 候选池全部耗尽时是否记录告警（阻塞分配的重试不记录）
+    ChunkManager* allocateChunk(uint64_t size, uint32_t alignment, bool reportExhaustion) noexcept;
+    
+    /// @brief 从大块段分配：取一个控制块槽位，在 TLSF 堆中分配 ChunkHeader + 对齐填充 + size 字节
+    /// @note 不计入所有者配额（配额按固定尺寸的池设置）；崩溃回收仍按控制块账本进行
+    ChunkManager* allocateLargeChunk(uint64_t size, uint32_t alignment) noexcept;
+    
+    /// @brief 引用计数已归零的大块 chunk：内存还给 TLSF 堆，控制块槽位还给槽位链表
+    bool recycleLargeChunk(const ChunkManager& chunkManager) noexcept;
+    
+    /// @brief 构造大块段的槽位链表并初始化堆（布局完成后由创建进程调用一次）
+    bool initializeLargeChunkSegment(void* slotIndexMemory, void* arena) noexcept;
+    
+    /// @brief 大块段控制块槽位的空闲链表
+    Concurrent::MPMC_LockFree_List& largeChunkSlots() noexcept;
+    
+    /// @brief 向池归还了 chunk 后唤醒候选集合包含该池的阻塞分配（没有等待者时只是一次原子读取）
+    void notifyChunksReleased(uint32_t poolIndex) noexcept;
+    
+    /// @brief 阻塞分配的候选池集合（所有 NUMA 节点上的候选区间），位 i 对应池 i
+    uint32_t candidatePoolMask(uint64_t size, uint32_t alignment) const noexcept;
+    
+    /// @brief 校验请求参数（对齐必须是 2 的幂，内存池已初始化）
+    bool validateRequest(uint32_t alignment) const noexcept;
+    
+    /// @brief 调用线程优先使用的 NUMA 节点（单节点时恒为 0，不做系统调用）
+    uint32_t localNumaNode() const noexcept;
+    
+    /// @brief 按配置确定每个池生效的 NUMA 节点（本机不存在的节点退化为节点 0）
+    void assignNumaNodes() noexcept;
+    
+    /// @brief 把每个池的 chunk 区间 mbind 到所属节点（创建进程在首次访问数据区之前调用）
+    void bindPoolsToNumaNodes() const noexcept;
+    
+    /// @brief 按配置顺序为每个池的扩容段分配固定的段ID（布局完成后由创建进程调用一次）
+    void assignGrowthSegments() noexcept;
+    
+    /// @brief chunk 在本进程中的地址：初始段直接由池起始地址计算，扩容段按段ID查 PoolRegistry
+    /// @return 扩容段无法映射时返回 nullptr
+    void* chunkAddressOf(uint32_t poolIndex, uint32_t chunkIndex) const noexcept;
+    
+    /// @brief 本进程第一次访问扩容段时按名字打开并注册（慢路径，进程内加锁）
+    /// @return 段在本进程中的基地址，失败返回 0
+    static std::uintptr_t mapGrowthSegment(pool_id_t segmentId) noexcept;
+    
+    /// @brief 登记外部区域（registerExternalRegion 的共同实现，shmName 为空时使用 fd）
+    bool registerRegion(uint32_t poolIndex, const char* shmName, int fd, uint64_t offset) noexcept;
+    
+    /// @brief 本进程第一次访问外部池时按描述符打开并映射区域（慢路径，进程内加锁）
+    /// @return 区域在本进程中的基地址，失败返回 0
+    std::uintptr_t mapExternalRegion(uint32_t poolIndex) const noexcept;
+    
+    /// @brief 回收一个池中复用深度 hotDepth 以下的空闲 chunk 的物理页，返回释放的字节数
+    uint64_t reclaimPool(uint32_t poolIndex, uint32_t hotDepth) noexcept;
+    
+    /// @brief 对已按地址排序的冷 chunk，把完全被它们覆盖的页交还内核，返回释放的字节数
+    uint64_t releaseChunkPages(uint32_t poolIndex, std::span<const uint32_t> sortedChunkIndices) noexcept;
+    
+    /// @brief 创建进程在分配失败时为 numaNode 上的目标尺寸级别扩容
+    /// @param poolIndex 输出扩容成功的池索引
+    bool growForRequest(uint64_t size, uint32_t alignment, uint32_t numaNode, uint32_t& poolIndex) noexcept;
+    
+    /// @brief 已获取 chunk 索引后的收尾：初始化控制块和 ChunkHeader，更新统计；失败时归还索引
+    ChunkManager* completeAllocation(uint32_t poolIndex, uint32_t chunkIndex, uint64_t size,
+                                     uint32_t alignment, bool fromReservation) noexcept;
+    
+    /// @brief 根据已获取的 chunk 索引初始化控制块引用计数、所有者信息和 ChunkHeader
+    ChunkManager* initializeChunk(uint32_t poolIndex, uint32_t chunkIndex,
+                                  uint64_t size, uint32_t alignment, bool fromReservation = false) noexcept;
+    
+    /// @brief 构造所有账户的预留链表并记录每个池的默认配额（布局完成后由创建进程调用一次）
+    void initializeOwnerAccounts() noexcept;
+    
+    /// @brief 为本进程登记所有者账户（创建/连接共享实例时调用；槽位用尽时回收已退出进程的槽位）
+    void registerChunkOwner() noexcept;
+    
+    /// @brief 注销本进程的账户：私有链表中的预留 chunk 归还共享空闲链表
+    void unregisterChunkOwner() noexcept;
+    
+    /// @brief 清空账户的私有链表，返回归还给共享空闲链表的 chunk 数
+    uint32_t drainReservations(uint32_t ownerSlot) noexcept;
+    
+    /// @brief 把本进程在池上的 count 个预留 chunk 从私有链表归还给共享空闲链表（调用者已扣减预留数）
+    /// @note 仍被借出、私有链表中取不够的部分记为欠账，释放时回到共享空闲链表
+    void returnReservedChunks(uint32_t poolIndex, uint32_t count) noexcept;
+    
+    /// @brief 账户在池上的私有预留链表（与池的空闲链表共用索引数组）
+    Concurrent::MPMC_LockFree_List& reservationListOf(uint32_t ownerSlot, uint32_t poolIndex) noexcept;
+    
+    /// @brief 按配额为本进程记入 count 个 chunk，返回允许的数量（超出部分不记入）
+    uint32_t chargeOwner(uint32_t poolIndex, uint32_t count) noexcept;
+    
+    /// @brief 撤销 chargeOwner 记入的 count 个 chunk
+    void refundOwner(uint32_t poolIndex, uint32_t count) noexcept;
+    
+    /// @brief 在池上获取一个 chunk 索引：先用本进程的预留，再按配额从共享空闲链表获取
+    bool acquireOwnedChunkIndex(uint32_t poolIndex, uint32_t& chunkIndex, bool& fromReservation) noexcept;
+    
+    /// @brief 引用计数归零的 chunk 按所有者记账
+    /// @return true 表示 chunk 已回到所有者的预留链表，调用者不再归还到共享空闲链表
+    bool dischargeOwner(const ChunkManager& chunkManager) noexcept;
+    
+    /// @brief 本进程在控制块账本中的持有计数 +1（饱和于 255）
+    static void recordHolder(ChunkManager& chunkManager) noexcept;
+    
+    /// @brief 本进程在控制块账本中的持有计数 -1（已为 0 时不变：释放的是不记账的在途引用）
+    static void eraseHolder(ChunkManager& chunkManager) noexcept;
+    
+    /// @brief 扫描所有分配过的控制块，扣除槽位账本记录的引用；引用计数归零的 chunk 归还
+    /// @note 调用者保证槽位的所有者已经死亡且槽位不会被并发登记
+    uint64_t reclaimOwnerReferences(uint32_t ownerSlot) noexcept;
+    
+    /// @brief 引用计数已归零的 chunk：按所有者记账后归还预留链表或空闲链表
+    bool recycleChunk(const ChunkManager& chunkManager) noexcept;
+    
+    /// @brief 链头归零时归还它后面的所有段（链头本身由调用者归还）
+    void recycleContinuations(const ChunkManager& head) noexcept;
+    
+    /// @brief 按配置预取并锁定本进程映射的管理区和数据区（createSharedInstance 末尾调用）
+    static void prepareSegments(const MemPoolConfig& config) noexcept;
+    
+    /// @brief 多线程预取 [baseAddress, baseAddress + size) 的所有页，不修改内存内容
+    static void prefaultSegment(void* baseAddress, uint64_t size, uint64_t pageSize, uint32_t threadCount) noexcept;
+    
+    /// @brief 计算 size 所在的 log2 桶：(2^(b-1), 2^b] -> b
+    static uint32_t sizeClassBucket(uint64_t size) noexcept;
+    
+    /// @brief 返回 size 在 numaNode 按大小排序的池列表中的起始位置
+    uint32_t findSizeClassPosition(uint64_t size, uint32_t numaNode) const noexcept;
+
+    // ==================== 索引获取/归还 ====================
+    
+    /// @brief 获取一个空闲数据 chunk 索引，优先使用线程弹匣
+    bool acquireChunkIndex(uint32_t poolIndex, uint32_t& chunkIndex) noexcept;
+    
+    /// @brief 归还一个数据 chunk 索引，优先放入线程弹匣
+    bool releaseChunkIndex(uint32_t poolIndex, uint32_t chunkIndex) noexcept;
+    
+    /// @brief 从共享空闲链表批量补充弹匣
+    bool refillMagazine(uint32_t poolIndex, ChunkMagazine& magazine) noexcept;
+    
+    /// @brief 把弹匣中最多 count 个索引批量归还给共享空闲链表
+    void flushMagazine(uint32_t poolIndex, ChunkMagazine& magazine, uint32_t count) noexcept;
+
     // ==================== 成员变量 ====================
     
     const MemPoolConfig& m_config;                  ///< 配置引用
     vector<MemPool, 16> m_mempools;                 ///< 数据 chunk 池（最多16个）
-    vector<MemPool, 1> m_chunkManagerPool;          ///< ChunkManager 对象池
+    vector<MemPool, 1> m_chunkManagerPool;          ///< ChunkManager 控制块数组（只用其偏移和容量，不再使用其空闲链表）
+    uint32_t m_controlBlockBase[16]{};              ///< 池索引 -> 该池第一个 chunk 的控制块索引
+    
+    // ==================== 尺寸级别查找表（共享内存中，所有进程共用） ====================
+    
+    // 每个 NUMA 节点一套：节点只在自己的池中按尺寸级别查找
+    static constexpr uint32_t kSizeClassBuckets = 65U;  ///< log2 桶数量（覆盖 0 ~ 2^64）
+    static constexpr uint32_t kMaxNumaNodes = MemPoolConfig::kMaxNumaNodes;
+    uint8_t m_sizeClassTable[kMaxNumaNodes][kSizeClassBuckets]{};  ///< 桶 -> 排序位置：第一个可能满足该桶的池
+    uint8_t m_sizeOrderedPools[kMaxNumaNodes][16]{};               ///< 排序位置 -> 池索引（按 chunk 大小升序）
+    uint8_t m_sizeOrderedPoolCount[kMaxNumaNodes]{};               ///< 每个节点已排序的池数量
+    std::atomic<ChunkFallbackPolicy> m_fallbackPolicy{ChunkFallbackPolicy::NEXT_LARGER};
+    
+    // ==================== NUMA 节点（共享内存中，所有进程共用） ====================
+    
+    uint8_t m_poolNumaNode[16]{};                           ///< 池索引 -> 生效的 NUMA 节点
+    uint8_t m_numaNodeCount{1};                             ///< 生效的节点数
+    std::atomic<uint64_t> m_numaRemoteAllocations{0};       ///< 跨节点回退分配次数
+    
+    // ==================== 扩容段（共享内存中，所有进程共用） ====================
+    
+    static constexpr uint32_t kMaxGrowthSegments = MemPoolConfig::kMaxGrowthSegments;
+    uint8_t m_growthSegmentBase[16]{};                      ///< 池索引 -> 第一个扩容段的段ID（PoolRegistry 池ID）
+    
+    // ==================== 外部区域（共享内存中，所有进程共用） ====================
+    
+    ExternalRegionDescriptor m_externalRegions[16]{};       ///< 池索引 -> 外部区域描述符（普通池为 NOT_EXTERNAL）
+    
+    // ==================== 大块段（共享内存中，所有进程共用） ====================
+    
+    TlsfHeap m_largeChunkHeap;                              ///< 数据区末尾的 TLSF 堆（未配置时未初始化）
+    uint32_t m_largeChunkControlBase{0};                    ///< 第一个大块槽位的控制块索引（所有池的控制块之后）
+    /// @brief 控制块槽位的空闲链表（initializeLargeChunkSegment 中就地构造）
+    alignas(Concurrent::MPMC_LockFree_List)
+    unsigned char m_largeChunkSlotList[sizeof(Concurrent::MPMC_LockFree_List)]{};
+    
+    // ==================== 阻塞分配（共享内存中，所有进程共用） ====================
+    
+    /// @brief 每个池的等待者计数：阻塞的 getChunk 登记在它的每个候选池上，归还方据此决定是否唤醒
+    struct alignas(64) PoolWaitQueue
+    {
+        std::atomic<uint32_t> m_waiterCount{0};      ///< 候选集合包含该池、正在休眠或即将休眠的调用者数量
+    };
+    PoolWaitQueue m_poolWaitQueues[16]{};                   ///< 池索引 -> 等待者计数（各占一个 cache line）
+    /// @brief 所有阻塞分配共用的 futex 字：向有等待者的池归还 chunk 时递增并唤醒全部等待者，
+    ///        等待者醒来后重试自己的全部候选池，候选池分属不同池/节点时也不会漏掉唤醒
+    alignas(64) std::atomic<uint32_t> m_releaseSequence{0};
+    
+    // ==================== 所有者账户（共享内存中，所有进程共用） ====================
+    
+    ChunkOwnerAccount m_ownerAccounts[kMaxChunkOwners]{};   ///< 所有者槽位 -> 账户
+    uint32_t m_defaultOwnerQuota[16]{};                     ///< 池索引 -> 登记时的默认配额
+    /// @brief 所有者槽位 x 池索引 -> 私有预留链表（initialize 中按池的索引数组就地构造）
+    alignas(Concurrent::MPMC_LockFree_List)
+    unsigned char m_reservationLists[kMaxChunkOwners][16][sizeof(Concurrent::MPMC_LockFree_List)]{};
+    
+    // ==================== 物理页回收（共享内存中，由守护进程维护） ====================
+    
+    uint32_t m_peakUsedSinceReclaim[16]{};                  ///< 池索引 -> 上次回收以来采样到的已使用峰值
+    std::atomic<uint64_t> m_reclaimedBytes{0};              ///< 累计释放的字节数
+    
+    // ==================== 数据区页类型（共享内存中，连接进程据此打开数据区） ====================
+    
+    HugePageMode m_chunkHugePageMode{HugePageMode::NONE};  ///< 创建进程实际得到的页类型
+    uint64_t m_chunkPageSize{0};                            ///< 数据区页大小
        
     // ==================== 静态成员（进程本地） ====================
     
@@ -151,9 +656,25 @@ private:
     // 保存 PosixShmProvider 对象，防止共享内存被析构
     static std::unique_ptr<PosixShmProvider> s_mgmtProvider;
     static std::unique_ptr<PosixShmProvider> s_chunkProvider;
+    static std::unique_ptr<PosixShmProvider> s_growthProviders[kMaxGrowthSegments];  ///< 按段ID - FIRST_GROWTH_POOL_ID 索引
+    static std::mutex s_growthMutex;                ///< 串行化本进程内扩容段的创建/映射（也用于外部区域）
+    
+    /// @brief 本进程对一个外部区域的映射
+    struct ExternalMapping
+    {
+        void* m_base{nullptr};
+        uint64_t m_size{0};
+        pool_id_t m_segmentId{0};
+    };
+    static ExternalMapping s_externalMappings[16];  ///< 按池索引（进程本地）
     
     // 标记当前进程是否是创建者（拥有所有权）
     static bool s_isOwner;
+    
+    static std::atomic<bool> s_threadMagazinesEnabled;  ///< 是否启用线程弹匣（进程本地）
+    static std::atomic<uint64_t> s_generation;          ///< 映射代数（进程本地）
+    static uint32_t s_ownerSlot;                        ///< 本进程的所有者槽位（进程本地）
+    static uint32_t s_ownerEpoch;                       ///< 登记时槽位的任期（进程本地）
 };
 
 } // namespace Memory
@@ -0,0 +1,115 @@
+#ifndef ZEROCP_POOL_TELEMETRY_HPP
+#define ZEROCP_POOL_TELEMETRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <sched.h>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief 单个池的分配遥测计数（位于共享内存中的 MemPool 内，所有进程共同累加）
+/// @details 计数按 CPU 分片：每片独占一个 cache line，线程只用 relaxed 原子操作写当前 CPU 的片，
+///          不同 CPU 上的分配/释放不会争用同一行；读取时把所有片相加。
+///          sched_getcpu 由 rseq/vDSO 提供，不陷入内核；线程迁移只影响写哪一片，不影响总数
+class PoolTelemetry
+{
+public:
+    static constexpr uint32_t kShardCount = 16U;
+
+    /// @brief 各片相加后的计数（分片分别读取，快照不是原子的，只用于监控）
+    struct Snapshot
+    {
+        uint64_t m_allocations{0};        ///< 成功分配的 chunk 数
+        uint64_t m_frees{0};              ///< 引用计数归零后归还的 chunk 数
+        uint64_t m_failedAllocations{0};  ///< 以该池为目标尺寸级别、最终没有分配到 chunk 的请求数
+        uint64_t m_casRetries{0};         ///< 该池空闲链表 pop/push 的 CAS 失败重试次数
+    };
+
+    void recordAllocations(uint32_t count) noexcept
+    {
+        shard().m_allocations.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void recordFrees(uint32_t count) noexcept
+    {
+        shard().m_frees.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void recordFailedAllocation() noexcept
+    {
+        shard().m_failedAllocations.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    /// @brief 分片的已使用计数（MemPoolConfig::m_deriveUsedCount 模式，代替池内单个共享的已使用计数）
+    /// @note 与分配/归还计数在同一片：热路径写的是刚写过的 cache line，不多碰一行
+    void addUsed(uint32_t count) noexcept
+    {
+        shard().m_usedDelta.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void subUsed(uint32_t count) noexcept
+    {
+        shard().m_usedDelta.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    /// @brief 各片已使用增量之和：O(kShardCount) 次 relaxed 读取
+    /// @note 单片可以为"负"（在一个 CPU 上分配、在另一个 CPU 上归还），按 32 位回绕相加后总和正确；
+    ///       分片分别读取，并发时的瞬时和可能短暂为负，返回 0
+    uint32_t usedCount() const noexcept
+    {
+        uint32_t total = 0U;
+        for (const Shard& shard : m_shards)
+        {
+            total += shard.m_usedDelta.load(std::memory_order_relaxed);
+        }
+        return (static_cast<int32_t>(total) < 0) ? 0U : total;
+    }
+
+    /// @brief 无竞争时 count 为 0，不访问任何分片
+    void recordCasRetries(uint64_t count) noexcept
+    {
+        if (count != 0U)
+        {
+            shard().m_casRetries.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    Snapshot snapshot() const noexcept
+    {
+        Snapshot total;
+        for (const Shard& shard : m_shards)
+        {
+            total.m_allocations += shard.m_allocations.load(std::memory_order_relaxed);
+            total.m_frees += shard.m_frees.load(std::memory_order_relaxed);
+            total.m_failedAllocations += shard.m_failedAllocations.load(std::memory_order_relaxed);
+            total.m_casRetries += shard.m_casRetries.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> m_allocations{0};
+        std::atomic<uint64_t> m_frees{0};
+        std::atomic<uint64_t> m_failedAllocations{0};
+        std::atomic<uint64_t> m_casRetries{0};
+        std::atomic<uint32_t> m_usedDelta{0};  ///< 本片上的分配数 - 归还数（32 位回绕）
+    };
+
+    Shard& shard() noexcept
+    {
+        const int cpu = sched_getcpu();
+        return m_shards[(cpu < 0) ? 0U : static_cast<uint32_t>(cpu) % kShardCount];
+    }
+
+    Shard m_shards[kShardCount];
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_POOL_TELEMETRY_HPP
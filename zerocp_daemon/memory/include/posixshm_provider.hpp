@@ -3,6 +3,8 @@
 
 #include "posix_sharedmemory.hpp"
 #include "posix_sharedmemory_object.hpp"
+#include "mempool_config.hpp"
+#include "relative_pointer.hpp"
 #include "logging.hpp"
 #include <expected>
 #include <optional>
@@ -40,6 +42,15 @@ public:
     PosixShmProvider& operator=(const PosixShmProvider&) = delete;
     PosixShmProvider& operator=(PosixShmProvider&&) noexcept = delete;
     
+    /// @brief 指定池ID（需在 createMemory 之前调用）
+    /// @note 默认ID是进程本地自动分配的；被多个进程共享、需要跨进程解析 RelativePointer 的段
+    ///       必须使用所有进程一致的固定ID（如 MANAGEMENT_POOL_ID、CHUNK_POOL_ID）
+    void setPoolId(pool_id_t poolId) noexcept;
+    
+    /// @brief 设置期望的页类型（需在 createMemory 之前调用，默认 NONE）
+    /// @note 显式大页不可用时回退到透明大页，实际结果通过 getHugePageMode/getPageSize 查询
+    void setHugePageMode(HugePageMode mode) noexcept;
+    
     // 创建共享内存，返回基地址
     std::expected<void*, PosixSharedMemoryObjectError> createMemory() noexcept;
 
@@ -57,7 +68,21 @@ public:
     
     /// 通知所有 MemoryBlock 已经可以使用分配好的内存
     void announceMemoryAvailable() noexcept;
+    
+    /// @brief 实际生效的页类型（createMemory 之后有效）
+    HugePageMode getHugePageMode() const noexcept;
+    
+    /// @brief 映射使用的页大小（显式大页为大页大小，否则为系统页大小）
+    uint64_t getPageSize() const noexcept;
+    
+    /// @brief 显式大页模式对应的 hugetlbfs 挂载目录（其他模式返回空字符串）
+    static const char* hugetlbfsMountPoint(HugePageMode mode) noexcept;
 private:
+    /// @brief 按给定的页类型参数创建/打开共享内存对象
+    std::expected<PosixSharedMemoryObject, PosixSharedMemoryObjectError>
+    createSharedMemoryObject(const char* hugetlbfsDirectory, bool transparentHugePages) noexcept;
+    
+
     Name_t m_name;                                      // 共享内存名称
     uint64_t m_memorySize{0U};                          // 共享内存大小（字节）
     AccessMode m_accessMode{AccessMode::ReadOnly};      // 访问模式
@@ -67,6 +92,7 @@ private:
     void* m_baseAddress{nullptr};                       // 共享内存基地址
     bool m_memoryAvailableAnnounced{false};             // 内存可用标志，是否已通知各MemoryBlock
     uint64_t m_poolId{0};                               // 池ID
+    HugePageMode m_hugePageMode{HugePageMode::NONE};    // 页类型（创建前为期望值，创建后为实际值）
 };
 
 } // namespace Memory
@@ -0,0 +1,91 @@
+#ifndef ZEROCP_PUBLISHER_PORT_HPP
+#define ZEROCP_PUBLISHER_PORT_HPP
+
+#include "receive_queue_pool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace zerocp::memory
+{
+
+/// 发布者端口：守护进程维护的"已匹配订阅者接收队列"列表（存储在共享内存中）
+/// 守护进程只负责服务发现（增删匹配的队列），发布者直接读取列表并自行入队，
+/// 稳态发布不经过守护进程，也不需要任何系统调用
+class PublisherPort
+{
+  public:
+    using QueueMask = uint64_t;
+    static_assert(ReceiveQueuePool::kMaxReceiveQueues <= std::numeric_limits<QueueMask>::digits,
+                  "each receive queue index must map to one bit of the queue mask");
+
+    explicit PublisherPort(uint32_t publisherSlot) noexcept
+        : m_publisherSlot(publisherSlot)
+    {
+    }
+    PublisherPort(const PublisherPort&) = delete;
+    PublisherPort& operator=(const PublisherPort&) = delete;
+
+    // ==================== 守护进程侧（服务发现） ====================
+
+    /// 添加一个已匹配的接收队列
+    void addQueue(uint64_t queueIndex) noexcept
+    {
+        m_matchedQueues.fetch_or(QueueMask{1} << queueIndex, std::memory_order_release);
+    }
+
+    /// 移除一个接收队列（之后需等待 isQuiescent() 再回收队列）
+    /// @return 移除前端口中是否有该队列（没有时不需要等待本端口）
+    /// @note 与 beginDelivery 构成 Dekker 式握手：本侧"写掩码、读计数"，发布者侧"写计数、读掩码"。
+    ///       四个操作都是 seq_cst，处于同一个全序中：isQuiescent 读到 0 时，
+    ///       之后递增计数的投递一定能看到新的掩码；acq_rel/acquire 不禁止两侧的"先读后写"重排
+    bool removeQueue(uint64_t queueIndex) noexcept
+    {
+        const QueueMask bit = QueueMask{1} << queueIndex;
+        return (m_matchedQueues.fetch_and(~bit, std::memory_order_seq_cst) & bit) != 0;
+    }
+
+    /// 当前没有发布者正在投递（移除队列之后，再也不会有人写入被移除的队列）
+    [[nodiscard]] bool isQuiescent() const noexcept
+    {
+        return m_activeDeliveries.load(std::memory_order_seq_cst) == 0;
+    }
+
+    // ==================== 发布者侧（数据面） ====================
+
+    /// 开始一次投递，返回本次投递可见的已匹配队列集合
+    /// @note 先递增计数再读掩码，均为 seq_cst（见 removeQueue）；x86 上 fetch_add 本身就是全屏障，没有额外开销
+    [[nodiscard]] QueueMask beginDelivery() noexcept
+    {
+        m_activeDeliveries.fetch_add(1, std::memory_order_seq_cst);
+        return m_matchedQueues.load(std::memory_order_seq_cst);
+    }
+
+    /// 结束一次投递
+    void endDelivery() noexcept
+    {
+        m_activeDeliveries.fetch_sub(1, std::memory_order_release);
+    }
+
+    /// 分配下一个消息序列号
+    [[nodiscard]] uint64_t nextSequenceNumber() noexcept
+    {
+        return m_sequenceNumber.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// 发布者进程的心跳槽位索引
+    [[nodiscard]] uint32_t publisherSlot() const noexcept
+    {
+        return m_publisherSlot;
+    }
+
+  private:
+    std::atomic<QueueMask> m_matchedQueues{0};      ///< 已匹配的接收队列索引位图
+    std::atomic<uint32_t> m_activeDeliveries{0};    ///< 正在进行中的投递数
+    uint32_t m_publisherSlot{0};                    ///< 发布者进程的心跳槽位索引
+    std::atomic<uint64_t> m_sequenceNumber{0};      ///< 消息序列号
+};
+
+} // namespace zerocp::memory
+
+#endif // ZEROCP_PUBLISHER_PORT_HPP
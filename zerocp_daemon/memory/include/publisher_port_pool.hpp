@@ -0,0 +1,88 @@
+#ifndef ZEROCP_PUBLISHER_PORT_POOL_HPP
+#define ZEROCP_PUBLISHER_PORT_POOL_HPP
+
+#include "publisher_port.hpp"
+#include "zerocp_foundationLib/vocabulary/include/fixed_position_container.hpp"
+
+namespace zerocp::memory
+{
+
+/// 发布者端口池：固定数量的发布者端口（容量 64）
+/// 基于 FixedPositionContainer，端口地址稳定，可以用偏移量跨进程定位
+class PublisherPortPool
+{
+  public:
+    static constexpr uint64_t kMaxPublisherPorts = 64;
+    using Container = ZeroCP::FixedPositionContainer<PublisherPort, kMaxPublisherPorts>;
+    using Iterator = typename Container::Iterator;
+    using ConstIterator = typename Container::ConstIterator;
+
+    PublisherPortPool() noexcept = default;
+    PublisherPortPool(const PublisherPortPool&) = delete;
+    PublisherPortPool& operator=(const PublisherPortPool&) = delete;
+
+    /// 为指定心跳槽位的发布者分配一个端口，如果端口池已满则返回 end()
+    [[nodiscard]] Iterator emplace(uint32_t publisherSlot) noexcept
+    {
+        return m_ports.emplace(publisherSlot);
+    }
+
+    /// 释放一个已分配的端口
+    void release(Iterator it) noexcept
+    {
+        if (it != m_ports.end())
+        {
+            m_ports.erase(it);
+        }
+    }
+
+    /// 根据固定 index 获取迭代器（index 稳定不随释放而变化）
+    [[nodiscard]] Iterator iteratorFromIndex(uint64_t index) noexcept
+    {
+        if (index >= kMaxPublisherPorts)
+        {
+            return m_ports.end();
+        }
+        return m_ports.iter_from_index(static_cast<typename Container::IndexType>(index));
+    }
+
+    [[nodiscard]] ConstIterator iteratorFromIndex(uint64_t index) const noexcept
+    {
+        if (index >= kMaxPublisherPorts)
+        {
+            return m_ports.cend();
+        }
+        return m_ports.iter_from_index(static_cast<typename Container::IndexType>(index));
+    }
+
+    /// 获取已分配的端口数量
+    [[nodiscard]] uint64_t size() const noexcept
+    {
+        return m_ports.size();
+    }
+
+    /// 获取最大容量
+    [[nodiscard]] constexpr uint64_t capacity() const noexcept
+    {
+        return kMaxPublisherPorts;
+    }
+
+    /// 检查端口池是否已满
+    [[nodiscard]] bool isFull() const noexcept
+    {
+        return m_ports.full();
+    }
+
+    // 迭代器接口
+    [[nodiscard]] Iterator begin() noexcept { return m_ports.begin(); }
+    [[nodiscard]] Iterator end() noexcept { return m_ports.end(); }
+    [[nodiscard]] ConstIterator begin() const noexcept { return m_ports.begin(); }
+    [[nodiscard]] ConstIterator end() const noexcept { return m_ports.end(); }
+
+  private:
+    Container m_ports{};
+};
+
+} // namespace zerocp::memory
+
+#endif // ZEROCP_PUBLISHER_PORT_POOL_HPP
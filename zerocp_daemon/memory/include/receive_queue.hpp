@@ -0,0 +1,74 @@
+#ifndef ZEROCP_RECEIVE_QUEUE_HPP
+#define ZEROCP_RECEIVE_QUEUE_HPP
+
+#include "zerocp_foundationLib/concurrent/include/mpmcboundedqueue.hpp"
+#include <cstdint>
+#include <limits>
+
+namespace zerocp::memory
+{
+
+/// 接收队列条目：只携带 chunk 的引用，不携带数据本身
+/// 订阅者通过 ChunkManager 索引在本进程中重建 chunk 地址（零拷贝）
+struct ChunkQueueEntry
+{
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    uint32_t m_chunkManagerIndex{kInvalidIndex};    ///< ChunkManager 在 ChunkManagerPool 中的索引
+    uint32_t m_publisherSlot{kInvalidIndex};        ///< 发布者进程的心跳槽位索引
+    uint64_t m_sequenceNumber{0};                   ///< 序列号（用于去重和排序）
+};
+
+/// 订阅者接收队列：共享内存中的有界 MPMC 无锁队列
+/// 生产端（守护进程/发布者）tryPush，消费端（订阅者）tryPop，全程无系统调用
+class ReceiveQueue
+{
+  public:
+    static constexpr uint64_t kCapacity = 256;
+    using Queue = ZeroCP::Concurrent::MPMC_BoundedQueue<ChunkQueueEntry, kCapacity>;
+
+    ReceiveQueue() noexcept = default;
+    ReceiveQueue(const ReceiveQueue&) = delete;
+    ReceiveQueue& operator=(const ReceiveQueue&) = delete;
+
+    /// 投递一个 chunk 引用，队列满时返回 false
+    [[nodiscard]] bool push(const ChunkQueueEntry& entry) noexcept
+    {
+        return m_queue.tryPush(entry);
+    }
+
+    /// 取出一个 chunk 引用，队列空时返回 false
+    [[nodiscard]] bool pop(ChunkQueueEntry& entry) noexcept
+    {
+        return m_queue.tryPop(entry);
+    }
+
+    /// 批量取出最多 maxCount 个 chunk 引用，返回实际取出的数量
+    [[nodiscard]] uint64_t popBatch(ChunkQueueEntry* entries, uint64_t maxCount) noexcept
+    {
+        return m_queue.tryPopBatch(entries, maxCount);
+    }
+
+    /// 当前排队的条目数（近似值）
+    [[nodiscard]] uint64_t size() const noexcept
+    {
+        return m_queue.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_queue.empty();
+    }
+
+    [[nodiscard]] static constexpr uint64_t capacity() noexcept
+    {
+        return kCapacity;
+    }
+
+  private:
+    Queue m_queue{};
+};
+
+} // namespace zerocp::memory
+
+#endif // ZEROCP_RECEIVE_QUEUE_HPP
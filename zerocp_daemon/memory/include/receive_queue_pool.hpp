@@ -0,0 +1,88 @@
+#ifndef ZEROCP_RECEIVE_QUEUE_POOL_HPP
+#define ZEROCP_RECEIVE_QUEUE_POOL_HPP
+
+#include "receive_queue.hpp"
+#include "zerocp_foundationLib/vocabulary/include/fixed_position_container.hpp"
+
+namespace zerocp::memory
+{
+
+/// 接收队列池：固定数量的订阅者接收队列（容量 64）
+/// 基于 FixedPositionContainer，队列地址稳定，可以用偏移量跨进程定位
+class ReceiveQueuePool
+{
+  public:
+    static constexpr uint64_t kMaxReceiveQueues = 64;
+    using Container = ZeroCP::FixedPositionContainer<ReceiveQueue, kMaxReceiveQueues>;
+    using Iterator = typename Container::Iterator;
+    using ConstIterator = typename Container::ConstIterator;
+
+    ReceiveQueuePool() noexcept = default;
+    ReceiveQueuePool(const ReceiveQueuePool&) = delete;
+    ReceiveQueuePool& operator=(const ReceiveQueuePool&) = delete;
+
+    /// 分配一个新的接收队列，如果队列池已满则返回 end()
+    [[nodiscard]] Iterator emplace() noexcept
+    {
+        return m_queues.emplace();
+    }
+
+    /// 释放一个已分配的接收队列
+    void release(Iterator it) noexcept
+    {
+        if (it != m_queues.end())
+        {
+            m_queues.erase(it);
+        }
+    }
+
+    /// 根据固定 index 获取迭代器（index 稳定不随释放而变化）
+    [[nodiscard]] Iterator iteratorFromIndex(uint64_t index) noexcept
+    {
+        if (index >= kMaxReceiveQueues)
+        {
+            return m_queues.end();
+        }
+        return m_queues.iter_from_index(static_cast<typename Container::IndexType>(index));
+    }
+
+    [[nodiscard]] ConstIterator iteratorFromIndex(uint64_t index) const noexcept
+    {
+        if (index >= kMaxReceiveQueues)
+        {
+            return m_queues.cend();
+        }
+        return m_queues.iter_from_index(static_cast<typename Container::IndexType>(index));
+    }
+
+    /// 获取已分配的队列数量
+    [[nodiscard]] uint64_t size() const noexcept
+    {
+        return m_queues.size();
+    }
+
+    /// 获取最大容量
+    [[nodiscard]] constexpr uint64_t capacity() const noexcept
+    {
+        return kMaxReceiveQueues;
+    }
+
+    /// 检查队列池是否已满
+    [[nodiscard]] bool isFull() const noexcept
+    {
+        return m_queues.full();
+    }
+
+    // 迭代器接口
+    [[nodiscard]] Iterator begin() noexcept { return m_queues.begin(); }
+    [[nodiscard]] Iterator end() noexcept { return m_queues.end(); }
+    [[nodiscard]] ConstIterator begin() const noexcept { return m_queues.begin(); }
+    [[nodiscard]] ConstIterator end() const noexcept { return m_queues.end(); }
+
+  private:
+    Container m_queues{};
+};
+
+} // namespace zerocp::memory
+
+#endif // ZEROCP_RECEIVE_QUEUE_POOL_HPP
@@ -0,0 +1,278 @@
+#ifndef ZEROCP_STATIC_MEMPOOL_CONFIG_HPP
+#define ZEROCP_STATIC_MEMPOOL_CONFIG_HPP
+
+#include "mempool_manager.hpp"
+#include "chunk_setting.hpp"
+#include "mpmclockfreelist.hpp"
+#include "logging.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief 编译期内存池配置中的一个池（字段含义同 MemPoolConfig::MemPoolEntry）
+struct StaticPoolEntry
+{
+    uint64_t m_chunkSize{0};
+    uint32_t m_chunkCount{0};
+    uint32_t m_userPayloadAlignment{ChunkSetting::kDefaultAlignment};
+    uint32_t m_userHeaderSize{0};
+    uint32_t m_userHeaderAlignment{ChunkSetting::kDefaultAlignment};
+    uint32_t m_ownerQuota{0};
+};
+
+/// @brief 固定拓扑的编译期内存池配置
+/// @details 段大小、各池在数据区中的偏移和尺寸级别表都在编译期算好并用 static_assert 检查；
+///          createSharedInstance 直接使用算好的段大小，不再构造临时 MemPoolManager 计算布局；
+///          getChunk<Bytes>() 在编译期确定池索引，分配时没有尺寸级别查找。
+/// @note 只描述单 NUMA 节点、不扩容的池集合（需要 replicatePoolsForNumaNodes 或扩容段时使用 MemPoolConfig）
+/// @code
+/// using Pools = StaticMemPoolConfig<StaticPoolEntry{128U, 1024U}, StaticPoolEntry{4096U, 64U, 64U}>;
+/// Pools::createSharedInstance();
+/// ChunkManager* chunk = Pools::getChunk<100U>();   // 编译期选中 128 字节的池
+/// @endcode
+template <StaticPoolEntry... Entries>
+class StaticMemPoolConfig
+{
+    // 需在下面的静态成员初始化之前声明
+    static constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1U) & ~(alignment - 1U);
+    }
+
+public:
+    static constexpr uint32_t kPoolCount = sizeof...(Entries);
+    static constexpr uint32_t kSizeClassBuckets = 65U;
+
+    static_assert(kPoolCount >= 1U && kPoolCount <= ChunkOwnerAccount::kMaxPools,
+                  "StaticMemPoolConfig supports 1 to 16 pools");
+
+    static constexpr std::array<StaticPoolEntry, kPoolCount> kEntries{Entries...};
+
+    static_assert(((Entries.m_chunkSize > 0U && Entries.m_chunkCount > 0U) && ...),
+                  "every pool needs a non-zero chunk size and chunk count");
+    static_assert((ChunkSetting::create(Entries.m_chunkSize, Entries.m_userPayloadAlignment,
+                                        Entries.m_userHeaderSize, Entries.m_userHeaderAlignment).has_value() && ...),
+                  "invalid chunk layout (alignment must be a power of two up to 4096, user header up to 64 KiB)");
+
+    /// @brief 每个池的 chunk 布局（与 MemPoolConfig::getChunkSetting 相同）
+    static constexpr std::array<ChunkSetting, kPoolCount> kChunkSettings{
+        ChunkSetting::create(Entries.m_chunkSize, Entries.m_userPayloadAlignment,
+                             Entries.m_userHeaderSize, Entries.m_userHeaderAlignment).value_or(ChunkSetting())...};
+
+    /// @brief 每个池的 chunk 数组相对数据区基址的偏移（与 MemPoolAllocator::ChunkMemoryLayout 的分配顺序一致）
+    static constexpr std::array<uint64_t, kPoolCount> kPoolOffsets = []() {
+        std::array<uint64_t, kPoolCount> offsets{};
+        uint64_t offset = 0U;
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            const uint64_t alignment = (kChunkSettings[i].getChunkAlignment() > 8U)
+                ? kChunkSettings[i].getChunkAlignment() : 8U;
+            offset = alignUp(offset, alignment);
+            offsets[i] = offset;
+            offset += kChunkSettings[i].getChunkSize() * kEntries[i].m_chunkCount;
+        }
+        return offsets;
+    }();
+
+    // 段大小的两套公式无法互相 static_assert（computeSegmentSizes 需要构造 MemPoolManager，不是 constexpr）：
+    // MemPoolManager::createSharedInstance 在创建进程中按实际配置重算，不相等时拒绝创建
+
+    /// @brief 数据区大小（同 MemPoolManager::computeSegmentSizes）
+    static constexpr uint64_t kChunkMemorySize = []() {
+        uint64_t size = 0U;
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            size += kChunkSettings[i].getChunkAlignment() + kChunkSettings[i].getChunkSize() * kEntries[i].m_chunkCount;
+        }
+        return alignUp(size, 8U);
+    }();
+
+    /// @brief 管理区大小：MemPoolManager 对象 + 各池 freeList + 控制块 + 控制块 freeList
+    static constexpr uint64_t kManagementMemorySize = []() {
+        uint64_t size = alignUp(sizeof(MemPoolManager), 8U);
+        uint64_t chunkNums = 0U;
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            size += alignUp(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(kEntries[i].m_chunkCount), 8U);
+            chunkNums += kEntries[i].m_chunkCount;
+        }
+        size += chunkNums * sizeof(ChunkManager) + alignof(ChunkManager);
+        size += alignUp(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(chunkNums), 8U);
+        return size;
+    }();
+
+    static_assert(kPoolOffsets[kPoolCount - 1U]
+                      + kChunkSettings[kPoolCount - 1U].getChunkSize() * kEntries[kPoolCount - 1U].m_chunkCount
+                      <= kChunkMemorySize,
+                  "pool layout exceeds the chunk segment");
+    static_assert([]() {
+        uint64_t chunkNums = 0U;
+        for (const auto& entry : kEntries)
+        {
+            chunkNums += entry.m_chunkCount;
+        }
+        return chunkNums < UINT32_MAX;
+    }(), "total chunk count exceeds the uint32 index range");
+
+    /// @brief 按 chunk 大小升序排列的池索引（大小相同的池保持配置顺序，同 buildSizeClassTable）
+    static constexpr std::array<uint8_t, kPoolCount> kSizeOrderedPools = []() {
+        std::array<uint8_t, kPoolCount> ordered{};
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            // 稳定插入排序
+            uint32_t position = i;
+            while (position > 0U && kEntries[ordered[position - 1U]].m_chunkSize > kEntries[i].m_chunkSize)
+            {
+                ordered[position] = ordered[position - 1U];
+                --position;
+            }
+            ordered[position] = static_cast<uint8_t>(i);
+        }
+        return ordered;
+    }();
+
+    /// @brief 尺寸级别表：log2 桶 -> 第一个可能满足该桶的排序位置
+    static constexpr std::array<uint8_t, kSizeClassBuckets> kSizeClassTable = []() {
+        std::array<uint8_t, kSizeClassBuckets> table{};
+        for (uint32_t bucket = 0U; bucket < kSizeClassBuckets; ++bucket)
+        {
+            const uint64_t bucketMinSize = (bucket == 0U) ? 0U : (uint64_t{1} << (bucket - 1U)) + 1U;
+            uint32_t position = 0U;
+            while (position < kPoolCount && kEntries[kSizeOrderedPools[position]].m_chunkSize < bucketMinSize)
+            {
+                ++position;
+            }
+            table[bucket] = static_cast<uint8_t>(position);
+        }
+        return table;
+    }();
+
+    /// @brief 与 MemPoolManager::getChunk 相同的选池规则：第一个容量足够且对齐填充后仍放得下的池
+    /// @return 没有满足条件的池时返回 kPoolCount
+    static constexpr uint32_t findPoolIndex(uint64_t size, uint32_t alignment = 8U) noexcept
+    {
+        const uint32_t bucket = (size <= 1U) ? 0U : static_cast<uint32_t>(std::bit_width(size - 1U));
+        for (uint32_t position = kSizeClassTable[bucket]; position < kPoolCount; ++position)
+        {
+            const uint32_t poolIndex = kSizeOrderedPools[position];
+            const uint32_t payloadAlignment = kChunkSettings[poolIndex].getUserPayloadAlignment();
+            const uint64_t alignmentPadding = (alignment > payloadAlignment) ? alignment - payloadAlignment : 0U;
+            if (kEntries[poolIndex].m_chunkSize >= size + alignmentPadding)
+            {
+                return poolIndex;
+            }
+        }
+        return kPoolCount;
+    }
+
+    /// @brief 编译期确定 Bytes/Alignment 请求使用的池
+    template <uint64_t Bytes, uint32_t Alignment = 8U>
+    static constexpr uint32_t poolIndexFor() noexcept
+    {
+        static_assert(Alignment != 0U && (Alignment & (Alignment - 1U)) == 0U, "alignment must be a power of two");
+        constexpr uint32_t poolIndex = findPoolIndex(Bytes, Alignment);
+        static_assert(poolIndex < kPoolCount, "no pool can hold a chunk of this size and alignment");
+        return poolIndex;
+    }
+
+    /// @brief 对应的运行时配置（可在此基础上设置大页、预取等与布局无关的选项）
+    static MemPoolConfig toMemPoolConfig() noexcept
+    {
+        MemPoolConfig config;
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            const StaticPoolEntry& entry = kEntries[i];
+            config.addMemPoolEntry(entry.m_chunkSize, entry.m_chunkCount);
+            config.setChunkLayout(i, entry.m_userPayloadAlignment, entry.m_userHeaderSize, entry.m_userHeaderAlignment);
+            config.setOwnerQuota(i, entry.m_ownerQuota);
+        }
+        return config;
+    }
+
+    /// @brief 使用编译期段大小创建共享实例
+    static bool createSharedInstance() noexcept
+    {
+        return createSharedInstance(toMemPoolConfig());
+    }
+
+    /// @brief 使用编译期段大小创建共享实例
+    /// @param config 必须由 toMemPoolConfig() 得到（只允许修改与布局无关的选项）
+    /// @return 配置的池集合与模板参数不一致，或实际布局与编译期布局不一致时返回 false
+    static bool createSharedInstance(const MemPoolConfig& config) noexcept
+    {
+        if (!matches(config))
+        {
+            ZEROCP_LOG(Error, "MemPoolConfig does not match the static pool layout");
+            return false;
+        }
+        const MemPoolManager::SegmentSizes sizes{kManagementMemorySize, kChunkMemorySize};
+        if (!MemPoolManager::createSharedInstance(config, sizes))
+        {
+            return false;
+        }
+
+        // 布局公式若与运行时实现不一致，编译期选出的池就不可信：在第一次分配前拒绝启动
+        MemPoolManager* manager = MemPoolManager::getInstanceIfInitialized();
+        const auto& mempools = manager->getMemPools();
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            if (mempools[i].getDataOffset() != kPoolOffsets[i]
+                || manager->findPoolIndex(kEntries[i].m_chunkSize) != findPoolIndex(kEntries[i].m_chunkSize))
+            {
+                ZEROCP_LOG(Error, "Static layout mismatch at pool " << i << ": offset " << mempools[i].getDataOffset()
+                                  << " (expected " << kPoolOffsets[i] << ")");
+                MemPoolManager::destroySharedInstance();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief 从编译期确定的池分配（没有尺寸级别查找和回退，池为空时返回 nullptr）
+    template <uint64_t Bytes, uint32_t Alignment = 8U>
+    static ChunkManager* getChunk() noexcept
+    {
+        constexpr uint32_t poolIndex = poolIndexFor<Bytes, Alignment>();
+        MemPoolManager* manager = MemPoolManager::getInstanceIfInitialized();
+        if (manager == nullptr)
+        {
+            return nullptr;
+        }
+        return manager->getChunkFromPool(poolIndex, Bytes, Alignment);
+    }
+
+private:
+    static bool matches(const MemPoolConfig& config) noexcept
+    {
+        // 大块段改变两个段的大小，编译期布局不包含它
+        if (config.m_memPoolEntries.size() != kPoolCount || config.getNumaNodeCount() != 1U
+            || config.m_largeChunkSegmentSize != 0U || config.m_largeChunkSlots != 0U)
+        {
+            return false;
+        }
+        for (uint32_t i = 0U; i < kPoolCount; ++i)
+        {
+            const auto& entry = config.m_memPoolEntries[i];
+            const ChunkSetting chunkSetting = config.getChunkSetting(i);
+            if (entry.m_external || entry.m_chunkSize != kEntries[i].m_chunkSize
+                || entry.m_chunkCount != kEntries[i].m_chunkCount
+                || config.getPoolCapacity(i) != kEntries[i].m_chunkCount
+                || chunkSetting.getChunkSize() != kChunkSettings[i].getChunkSize()
+                || chunkSetting.getUserPayloadOffset() != kChunkSettings[i].getUserPayloadOffset())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_STATIC_MEMPOOL_CONFIG_HPP
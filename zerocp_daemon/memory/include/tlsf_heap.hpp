@@ -0,0 +1,148 @@
+#ifndef ZEROCP_TLSF_HEAP_HPP
+#define ZEROCP_TLSF_HEAP_HPP
+
+#include "relative_pointer.hpp"
+#include <pthread.h>
+#include <atomic>
+#include <cstdint>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+/// @brief 共享内存中的 TLSF（two-level segregated fit）堆，用于变长/大块 chunk
+/// @details 一级按块大小的 log2 分级，每级再线性分成 kSecondLevelCount 个子级，每个子级一条空闲链表；
+///          两级位图记录哪些链表非空，分配和释放都是 O(1)：查找 = 两次找最低置位，释放 = 与物理相邻的空闲块合并。
+///          分配时按子级上取整查找，保证链表中的任意块都放得下（good-fit），碎片有界。
+///          块头与块内容一起放在区域中，链表和相邻块全部用相对区域起始地址的偏移表示，任意进程都可以操作。
+///          块的起始地址和大小都是 kBlockAlignment 的整数倍：[块头 64B][可用内存 ...]
+/// @note 对象本身必须位于共享内存中（MemPoolManager 的成员），所有操作在进程间共享的健壮互斥锁下进行
+class TlsfHeap
+{
+public:
+    static constexpr uint64_t kBlockAlignment = 64U;                      ///< 块起始地址和大小的粒度
+    static constexpr uint64_t kBlockHeaderSize = kBlockAlignment;         ///< 块头占用的字节（可用内存按 cache line 对齐）
+    static constexpr uint64_t kMinBlockSize = 2U * kBlockAlignment;       ///< 最小块（块头 + 一个粒度的可用内存）
+    static constexpr uint32_t kSecondLevelLog2 = 4U;
+    static constexpr uint32_t kSecondLevelCount = 1U << kSecondLevelLog2; ///< 每个一级的子级数
+    static constexpr uint32_t kFirstLevelShift = 10U;                     ///< log2(kBlockAlignment) + kSecondLevelLog2：更小的块全部在一级 0
+    static constexpr uint32_t kMaxFirstLevel = 39U;
+    static constexpr uint32_t kFirstLevelCount = kMaxFirstLevel - kFirstLevelShift + 1U;
+    /// @brief 区域上限：偏移 / kBlockAlignment 必须能放进 32 位（ChunkManager::m_chunkIndex）
+    static constexpr uint64_t kMaxArenaSize = uint64_t{1} << 38U;
+
+    TlsfHeap() noexcept = default;
+    ~TlsfHeap() noexcept;
+
+    TlsfHeap(const TlsfHeap&) = delete;
+    TlsfHeap(TlsfHeap&&) = delete;
+    TlsfHeap& operator=(const TlsfHeap&) = delete;
+    TlsfHeap& operator=(TlsfHeap&&) = delete;
+
+    /// @brief 把整个区域初始化为一个空闲块（创建进程调用一次）
+    /// @param arena 区域起始地址（至少按 kBlockAlignment 对齐，所在段已在 PoolRegistry 中注册）
+    /// @param segmentId 区域所在共享内存段的池ID
+    /// @param arenaSize 区域大小（向下取整到 kBlockAlignment，不超过 kMaxArenaSize）
+    bool initialize(void* arena, pool_id_t segmentId, uint64_t arenaSize) noexcept;
+
+    /// @brief 是否已初始化（未配置大块段时为 false）
+    bool isInitialized() const noexcept { return m_arenaSize != 0U; }
+
+    /// @brief 持锁进程死亡后堆结构无法修复时为 true：此后所有分配和释放都失败
+    bool isCorrupted() const noexcept { return m_corrupted.load(std::memory_order_acquire); }
+
+    /// @brief 分配至少 size 字节的可用内存
+    /// @param offset 输出：可用内存相对区域起始地址的偏移（kBlockAlignment 的整数倍）
+    /// @return 没有足够大的空闲块、或无法加锁（堆已不可用）时返回 false
+    bool allocate(uint64_t size, uint64_t& offset) noexcept;
+
+    /// @brief 释放 allocate 返回的偏移，并与相邻的空闲块合并
+    /// @return 偏移无效、块已经空闲或无法加锁（堆已不可用）时返回 false（不修改堆）
+    bool free(uint64_t offset) noexcept;
+
+    /// @brief 偏移在本进程中的地址
+    void* addressOf(uint64_t offset) const noexcept { return static_cast<char*>(m_arena.get()) + offset; }
+
+    /// @brief 已分配块的可用字节数（分配时按粒度和子级向上取整，可能大于请求的大小）
+    uint64_t usableSizeOf(uint64_t offset) const noexcept;
+
+    uint64_t getArenaSize() const noexcept { return m_arenaSize; }
+
+    /// @brief 已分配块占用的字节（含块头）
+    uint64_t getUsedBytes() const noexcept { return m_usedBytes.load(std::memory_order_relaxed); }
+
+    /// @brief 当前已分配的块数
+    uint32_t getAllocatedBlocks() const noexcept { return m_allocatedBlocks.load(std::memory_order_relaxed); }
+
+    /// @brief 因没有足够大的空闲块而失败的分配次数
+    uint64_t getFailedAllocations() const noexcept { return m_failedAllocations.load(std::memory_order_relaxed); }
+
+    /// @brief 持锁进程死亡后成功重建并接管锁的次数
+    uint32_t getLockRecoveries() const noexcept { return m_lockRecoveries.load(std::memory_order_relaxed); }
+
+    /// @brief 最大空闲块的可用字节数（加锁遍历最高的非空链表，只用于监控）
+    uint64_t getLargestFreeBlock() noexcept;
+
+private:
+    /// @brief 块头（位于块起始处，占 kBlockHeaderSize 字节）
+    struct BlockHeader
+    {
+        uint64_t m_previousPhysical;  ///< 物理上前一个块的偏移（第一个块为 kNullOffset）
+        uint64_t m_sizeAndFlags;      ///< 块大小（含块头）| kFreeFlag
+        uint64_t m_nextFree;          ///< 空闲块：同一链表的下一个块
+        uint64_t m_previousFree;      ///< 空闲块：同一链表的上一个块
+    };
+    static_assert(sizeof(BlockHeader) <= kBlockHeaderSize, "block header must fit in one granule");
+
+    static constexpr uint64_t kNullOffset = UINT64_MAX;
+    static constexpr uint64_t kFreeFlag = 1U;
+
+    /// @brief 块大小 -> (一级, 子级)：释放时按实际大小入链
+    static void mapping(uint64_t blockSize, uint32_t& firstLevel, uint32_t& secondLevel) noexcept;
+
+    /// @brief 请求大小按子级向上取整后再映射：得到的链表中任意块都不小于 blockSize
+    /// @return 超出最大一级时返回 false
+    static bool mappingSearch(uint64_t blockSize, uint32_t& firstLevel, uint32_t& secondLevel) noexcept;
+
+    BlockHeader* blockAt(uint64_t blockOffset) const noexcept;
+    static uint64_t sizeOf(const BlockHeader* block) noexcept { return block->m_sizeAndFlags & ~kFreeFlag; }
+    static bool isFree(const BlockHeader* block) noexcept { return (block->m_sizeAndFlags & kFreeFlag) != 0U; }
+
+    /// @brief 从 (firstLevel, secondLevel) 起找第一个非空链表
+    bool findFreeList(uint32_t& firstLevel, uint32_t& secondLevel) const noexcept;
+    void insertFreeBlock(uint64_t blockOffset) noexcept;
+    void removeFreeBlock(uint64_t blockOffset) noexcept;
+    /// @brief 让 blockOffset 之后的物理相邻块指回 blockOffset
+    void linkNextPhysical(uint64_t blockOffset) noexcept;
+
+    /// @brief 持锁时按物理块链重建空闲链表、位图和计数（中断的拆分/合并在此被撤销或补全）
+    /// @details 块大小越界或没有对齐时链无法可靠地遍历，返回 false；
+    ///          相邻的空闲块被合并，物理前驱指针按遍历结果重写
+    bool rebuildFreeLists() noexcept;
+
+    /// @brief 加锁
+    /// @details 持锁进程死亡（EOWNERDEAD）时它可能停在一次堆操作的中途：先按物理块链重建空闲链表，
+    ///          成功后才 pthread_mutex_consistent 接管锁；物理块链本身损坏时不恢复锁，
+    ///          锁随之变为 ENOTRECOVERABLE，堆被标记为不可用
+    /// @return 拿到锁且堆结构一致时返回 true；锁不可恢复或加锁出错时返回 false（未持锁）
+    bool lock() noexcept;
+    void unlock() noexcept;
+
+    RelativePointer<void> m_arena;                                  ///< 区域起始地址（所在段 + 偏移）
+    uint64_t m_arenaSize{0};
+    pthread_mutex_t m_mutex{};                                      ///< PTHREAD_PROCESS_SHARED + PTHREAD_MUTEX_ROBUST
+    uint32_t m_firstLevelBitmap{0};                                 ///< 位 i：一级 i 中有非空链表
+    uint32_t m_secondLevelBitmaps[kFirstLevelCount]{};              ///< 位 j：链表 (i, j) 非空
+    uint64_t m_freeLists[kFirstLevelCount][kSecondLevelCount]{};    ///< 链表头（块偏移，初始化前为 0，初始化时置为 kNullOffset）
+    std::atomic<uint64_t> m_usedBytes{0};
+    std::atomic<uint32_t> m_allocatedBlocks{0};
+    std::atomic<uint64_t> m_failedAllocations{0};
+    std::atomic<uint32_t> m_lockRecoveries{0};
+    std::atomic<bool> m_corrupted{false};
+};
+
+} // namespace Memory
+} // namespace ZeroCP
+
+#endif // ZEROCP_TLSF_HEAP_HPP
@@ -0,0 +1,51 @@
+#include "chunk_magazine.hpp"
+#include "mempool_manager.hpp"
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+ThreadMagazineCache& ThreadMagazineCache::forThisThread() noexcept
+{
+    thread_local ThreadMagazineCache cache;
+    return cache;
+}
+
+ThreadMagazineCache::~ThreadMagazineCache() noexcept
+{
+    // 线程退出：把缓存的索引还给共享空闲链表，避免其他线程/进程分配失败
+    auto* manager = MemPoolManager::getInstanceIfInitialized();
+    if (manager != nullptr && m_generation == MemPoolManager::getGeneration())
+    {
+        flushAll(*manager);
+    }
+}
+
+ChunkMagazine& ThreadMagazineCache::magazine(uint32_t poolIndex, uint64_t generation) noexcept
+{
+    if (m_generation != generation)
+    {
+        for (auto& magazine : m_magazines)
+        {
+            magazine.clear();
+        }
+        m_generation = generation;
+    }
+    return m_magazines[poolIndex];
+}
+
+void ThreadMagazineCache::flushAll(MemPoolManager& manager) noexcept
+{
+    for (uint32_t poolIndex = 0U; poolIndex < kMaxPools; ++poolIndex)
+    {
+        auto& magazine = m_magazines[poolIndex];
+        while (!magazine.isEmpty())
+        {
+            manager.flushMagazine(poolIndex, magazine, ChunkMagazine::kCapacity);
+        }
+    }
+}
+
+} // namespace Memory
+} // namespace ZeroCP
@@ -14,13 +14,21 @@ MemPool::MemPool(void* baseAddress,
                  uint64_t chunkSize,
                  uint32_t chunkNums,
                  void* freeListMemory,
-                 uint64_t pool_id) noexcept
-    : m_rawMemory(baseAddress, rawMemory, pool_id)  // 初始化 RelativePointer
+                 uint64_t pool_id,
+                 uint32_t capacity,
+                 const ChunkSetting& chunkSetting,
+                 bool deriveUsedCount) noexcept
+    : m_rawMemory(baseAddress, rawMemory, pool_id)  // 布局阶段 rawMemory 为空，由 setRawMemory 设置
     , m_chunkSize(chunkSize)
+    , m_chunkSetting(chunkSetting)
     , m_chunkNums(chunkNums)
-    , m_usedChunk(0)  // 初始化 atomic
+    , m_capacity((capacity > chunkNums) ? capacity : chunkNums)
+    , m_activeChunks(chunkNums)
+    , m_deriveUsedCount(deriveUsedCount)
     , m_pool_id(pool_id)
-    , m_freeIndices(static_cast<uint32_t*>(freeListMemory), chunkNums)  // 初始化 MPMC_LockFree_List
+    , m_freeIndices(static_cast<uint32_t*>(freeListMemory), m_capacity)  // 初始化 MPMC_LockFree_List
+    , m_coldIndices(static_cast<uint32_t*>(freeListMemory), m_capacity)
+    , m_usedChunk(0)  // 初始化 atomic
 {
     // 验证参数
     // 注意：rawMemory 可以为 nullptr，因为它会在 ChunkMemoryLayout 中设置
@@ -37,14 +45,35 @@ MemPool::MemPool(void* baseAddress,
         return;
     }
     
-    // 初始化 MPMC_LockFree_List 的内部状态
-    m_freeIndices.Initialize();
+    // 初始化 MPMC_LockFree_List 的内部状态：O(1)，索引数组不在启动时写入（扩容段的索引在 activateSegment 时才加入）
+    m_freeIndices.Initialize(chunkNums);
+    m_coldIndices.Initialize(0U);
     
     ZEROCP_LOG(Info, "MemPool constructed successfully - ChunkSize: " << chunkSize 
-               << ", ChunkNums: " << chunkNums << ", PoolID: " << pool_id);
+               << ", ChunkNums: " << chunkNums << ", Capacity: " << m_capacity << ", PoolID: " << pool_id);
+}
+
+bool MemPool::activateSegment() noexcept
+{
+    const uint32_t activeChunks = m_activeChunks.load(std::memory_order_relaxed);
+    if (m_capacity - activeChunks < m_chunkNums)
+    {
+        return false;
+    }
+    
+    // 先发布新的总数，再让索引可被分配：拿到新索引的进程一定能看到新的总数
+    m_activeChunks.store(activeChunks + m_chunkNums, std::memory_order_release);
+    return m_freeIndices.extend(m_chunkNums);
+}
+
+void MemPool::deactivateInitialSegment() noexcept
+{
+    m_activeChunks.store(0U, std::memory_order_relaxed);
+    m_freeIndices.Initialize(0U);
+    m_coldIndices.Initialize(0U);
 }
 
-void MemPool::setRawMemory(void* rawMemory, uint64_t dataOffset) noexcept
+void MemPool::setRawMemory(void* rawMemory, uint64_t dataOffset, pool_id_t segmentId) noexcept
 {
     if (rawMemory == nullptr)
     {
@@ -52,9 +81,8 @@ void MemPool::setRawMemory(void* rawMemory, uint64_t dataOffset) noexcept
         return;
     }
     
-    // 注意：RelativePointer 已经在构造函数中初始化，这里只更新 dataOffset
-    // m_rawMemory 已经在构造函数中设置，指向正确的 rawMemory
-    // 这个方法现在主要用于更新 dataOffset
+    // 相对于所在段的基地址保存，其他进程通过各自注册的基地址解析
+    m_rawMemory = RelativePointer<void>(rawMemory, segmentId);
     
     // 记录数据区偏移量（用于多进程通信）
     m_dataOffset = dataOffset;
@@ -9,6 +9,7 @@
 #include "memory.hpp"
 #include "logging.hpp"
 #include <cstring>
+#include <algorithm>
 
 using ZeroCP::Memory::align;
 
@@ -62,7 +63,8 @@ void* MemPoolAllocator::createSharedMemory(const Name_t& name,
 
 bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mgmtMemorySize,
                                               vector<MemPool, 16>& mempools,
-                                              vector<MemPool, 1>& chunkManagerPool) noexcept
+                                              vector<MemPool, 1>& chunkManagerPool,
+                                              void*& largeChunkSlotMemory) noexcept
 {
     if (mgmtBaseAddress == nullptr || mgmtMemorySize == 0)
     {
@@ -85,9 +87,10 @@ bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mg
     {
         const auto& entry = m_config.m_memPoolEntries[i];
         
-        // 1.1 计算 freeList 大小
+        // 1.1 计算 freeList 大小（按扩容后的最大 chunk 数预留，扩容时不需要重新布局管理区）
+        const uint32_t capacity = m_config.getPoolCapacity(i);
         uint64_t freeListSize = align(
-            Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(entry.m_chunkCount), 8U);
+            Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(capacity), 8U);
         
         // 1.2 分配 freeList 内存
         auto freeListResult = allocator.allocate(freeListSize, 8U);
@@ -106,7 +109,10 @@ bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mg
             entry.m_chunkSize,        // chunkSize
             entry.m_chunkCount,       // chunkNums
             freeListMemory,           // freeListMemory
-            poolIndex                 // pool_id
+            poolIndex,                // pool_id
+            capacity,                 // capacity（含扩容段）
+            m_config.getChunkSetting(i), // chunk 布局
+            m_config.m_deriveUsedCount   // 已使用计数由遥测分片推算
         );
         
         if (!success)
@@ -115,17 +121,27 @@ bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mg
             return false;
         }
         
-        ZEROCP_LOG(Info, "  Added MemPool[" << poolIndex << "]: " << entry.m_chunkSize << "B x " << entry.m_chunkCount);
+        // 1.4 外部池的 chunk 在使用者登记区域后才可用
+        if (entry.m_external)
+        {
+            mempools[i].deactivateInitialSegment();
+        }
+        
+        ZEROCP_LOG(Info, "  Added MemPool[" << poolIndex << "]: " << entry.m_chunkSize << "B x " << entry.m_chunkCount
+                   << " (capacity " << capacity << ")");
         
-        totalChunks += entry.m_chunkCount;
+        totalChunks += capacity;
         poolIndex++;
     }
     
     ZEROCP_LOG(Info, "  mempools vector size after: " << mempools.size());
     
-    // 2. 分配所有 ChunkManager 对象的内存
-    uint64_t chunkManagerArraySize = totalChunks * align(sizeof(ChunkManager), 8U);
-    auto chunkManagerResult = allocator.allocate(chunkManagerArraySize, 8U);
+    // 大块段的每个槽位也需要一个控制块，排在所有池的控制块之后
+    totalChunks += m_config.m_largeChunkSlots;
+    
+    // 2. 分配所有 ChunkManager 控制块的内存（每个控制块独占一个 cache line）
+    uint64_t chunkManagerArraySize = totalChunks * sizeof(ChunkManager);
+    auto chunkManagerResult = allocator.allocate(chunkManagerArraySize, alignof(ChunkManager));
     if (!chunkManagerResult.has_value())
     {
         ZEROCP_LOG(Error, "Failed to allocate ChunkManager array");
@@ -148,7 +164,7 @@ bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mg
     bool success = chunkManagerPool.emplace_back(
         m_sharedMemoryBase,           // baseAddress
         chunkManagerMemory,           // rawMemory (ChunkManager 对象数组)
-        align(sizeof(ChunkManager), 8U),  // chunkSize
+        sizeof(ChunkManager),         // chunkSize
         static_cast<uint32_t>(totalChunks),  // chunkNums
         chunkMgrFreeListMemory,       // freeListMemory
         0UL                           // pool_id
@@ -163,7 +179,21 @@ bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mg
     // 5. 设置 ChunkManagerPool 的 dataOffset
     // ChunkManager 数组在管理区内存中，计算相对于管理区基地址的偏移量
     uint64_t chunkMgrDataOffset = static_cast<char*>(chunkManagerMemory) - static_cast<char*>(m_sharedMemoryBase);
-    chunkManagerPool[0].setRawMemory(chunkManagerMemory, chunkMgrDataOffset);
+    chunkManagerPool[0].setRawMemory(chunkManagerMemory, chunkMgrDataOffset, MANAGEMENT_POOL_ID);
+    
+    // 6. 分配大块段控制块槽位的空闲链表
+    largeChunkSlotMemory = nullptr;
+    if (m_config.m_largeChunkSlots > 0U)
+    {
+        auto slotResult = allocator.allocate(
+            align(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(m_config.m_largeChunkSlots), 8U), 8U);
+        if (!slotResult.has_value())
+        {
+            ZEROCP_LOG(Error, "Failed to allocate large chunk slot list");
+            return false;
+        }
+        largeChunkSlotMemory = slotResult.value();
+    }
     
     ZEROCP_LOG(Info, "ManagementMemoryLayout completed successfully");
     return true;
@@ -172,7 +202,8 @@ bool MemPoolAllocator::ManagementMemoryLayout(void* mgmtBaseAddress, uint64_t mg
 // ==================== 数据区内存布局 ====================
 
 bool MemPoolAllocator::ChunkMemoryLayout(void* baseAddress, uint64_t memorySize,
-                                         vector<MemPool, 16>& mempools) noexcept
+                                         vector<MemPool, 16>& mempools,
+                                         void*& largeChunkArena) noexcept
 {
     if (baseAddress == nullptr || memorySize == 0)
     {
@@ -183,6 +214,9 @@ bool MemPoolAllocator::ChunkMemoryLayout(void* baseAddress, uint64_t memorySize,
     // 使用 BumpAllocator 从数据内存中分配
     BumpAllocator allocator(baseAddress, memorySize);
     
+    // 多个 NUMA 节点时每个池从页边界开始，才能把各池单独 mbind 到所属节点
+    const uint64_t poolAlignment = (m_config.getNumaNodeCount() > 1U) ? MemPoolManager::kNumaPoolAlignment : 8U;
+    
     // 按照 memory.md 第80-117行的布局：
     // 数据区 = [池0的Chunk数组] [池1的Chunk数组] [池2的Chunk数组] ...
     // 为每个 MemPool 分配 chunk 数据块并记录偏移量
@@ -190,15 +224,20 @@ bool MemPoolAllocator::ChunkMemoryLayout(void* baseAddress, uint64_t memorySize,
     {
         MemPool& pool = mempools[i];
         const auto& entry = m_config.m_memPoolEntries[i];
+        if (entry.m_external)
+        {
+            continue;  // chunk 数组在登记的外部区域中（见 MemPoolManager::registerExternalRegion）
+        }
         
-        // 每个 chunk 的实际大小 = ChunkHeader + 用户数据
-        uint64_t actualChunkSize = align(sizeof(ChunkHeader) + entry.m_chunkSize, 8U);
+        // 每个 chunk 的实际大小 = ChunkHeader + 用户头 + 用户数据（含对齐填充，见 ChunkSetting）
+        const ChunkSetting& chunkSetting = pool.getChunkSetting();
+        uint64_t actualChunkSize = chunkSetting.getChunkSize();
         
         // 计算这个 Pool 需要的总内存
         uint64_t poolTotalSize = actualChunkSize * entry.m_chunkCount;
         
-        // 分配 chunk 数据块
-        auto chunkResult = allocator.allocate(poolTotalSize, 8U);
+        // 分配 chunk 数据块：池起始地址按 chunk 对齐，池内每个 chunk 的用户数据都满足配置的对齐
+        auto chunkResult = allocator.allocate(poolTotalSize, std::max<uint64_t>(poolAlignment, chunkSetting.getChunkAlignment()));
         if (!chunkResult.has_value())
         {
             ZEROCP_LOG(Error, "Failed to allocate chunk memory for Pool " << i);
@@ -213,7 +252,20 @@ bool MemPoolAllocator::ChunkMemoryLayout(void* baseAddress, uint64_t memorySize,
         
         // 关键：设置 MemPool 的 rawMemory 指针和 dataOffset
         // 这个地址指向这个 Pool 管理的内存块的起始位置
-        pool.setRawMemory(chunkMemory, dataOffset);
+        pool.setRawMemory(chunkMemory, dataOffset, CHUNK_POOL_ID);
+    }
+    
+    // 大块段（TLSF 堆）在所有池之后，按页对齐：块在每个进程中的页内偏移相同，用户数据按偏移对齐即可
+    largeChunkArena = nullptr;
+    if (m_config.m_largeChunkSegmentSize > 0U)
+    {
+        auto arenaResult = allocator.allocate(m_config.m_largeChunkSegmentSize, MemPoolManager::kLargeChunkArenaAlignment);
+        if (!arenaResult.has_value())
+        {
+            ZEROCP_LOG(Error, "Failed to allocate large chunk segment");
+            return false;
+        }
+        largeChunkArena = arenaResult.value();
     }
     
     ZEROCP_LOG(Info, "ChunkMemoryLayout completed successfully");
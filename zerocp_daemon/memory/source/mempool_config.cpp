@@ -1,4 +1,5 @@
 #include "mempool_config.hpp"
+#include "tlsf_heap.hpp"
 #include "logging.hpp"
 #include <algorithm>
 
@@ -39,6 +40,14 @@ namespace Memory
 // ==================== 拷贝构造和赋值 ====================
 
 MemPoolConfig::MemPoolConfig(const MemPoolConfig& other) noexcept
+    : m_fallbackPolicy(other.m_fallbackPolicy)
+    , m_hugePageMode(other.m_hugePageMode)
+    , m_prefaultSegments(other.m_prefaultSegments)
+    , m_prefaultThreads(other.m_prefaultThreads)
+    , m_lockSegments(other.m_lockSegments)
+    , m_deriveUsedCount(other.m_deriveUsedCount)
+    , m_largeChunkSegmentSize(other.m_largeChunkSegmentSize)
+    , m_largeChunkSlots(other.m_largeChunkSlots)
 {
     for (uint64_t i = 0; i < other.m_memPoolEntries.size(); ++i)
     {
@@ -55,15 +64,24 @@ MemPoolConfig& MemPoolConfig::operator=(const MemPoolConfig& other) noexcept
         {
             m_memPoolEntries.emplace_back(other.m_memPoolEntries[i]);
         }
+        m_fallbackPolicy = other.m_fallbackPolicy;
+        m_hugePageMode = other.m_hugePageMode;
+        m_prefaultSegments = other.m_prefaultSegments;
+        m_prefaultThreads = other.m_prefaultThreads;
+        m_lockSegments = other.m_lockSegments;
+        m_deriveUsedCount = other.m_deriveUsedCount;
+        m_largeChunkSegmentSize = other.m_largeChunkSegmentSize;
+        m_largeChunkSlots = other.m_largeChunkSlots;
     }
     return *this;
 }
 
 // ==================== 配置管理 ====================
 
-bool MemPoolConfig::addMemPoolEntry(uint64_t chunkSize, uint32_t chunkCount) noexcept
+bool MemPoolConfig::addMemPoolEntry(uint64_t chunkSize, uint32_t chunkCount, uint32_t numaNode,
+                                    uint32_t maxGrowthSegments) noexcept
 {
-    bool success = m_memPoolEntries.emplace_back(MemPoolEntry(chunkSize, chunkCount));
+    bool success = m_memPoolEntries.emplace_back(MemPoolEntry(chunkSize, chunkCount, numaNode, maxGrowthSegments));
     if (!success)
     {
         ZEROCP_LOG(Error, "Failed to add MemPoolEntry: vector capacity exceeded");
@@ -71,6 +89,147 @@ bool MemPoolConfig::addMemPoolEntry(uint64_t chunkSize, uint32_t chunkCount) noe
     return success;
 }
 
+bool MemPoolConfig::addExternalPoolEntry(uint64_t chunkSize, uint32_t chunkCount) noexcept
+{
+    MemPoolEntry entry(chunkSize, chunkCount);
+    entry.m_external = true;
+    bool success = m_memPoolEntries.emplace_back(entry);
+    if (!success)
+    {
+        ZEROCP_LOG(Error, "Failed to add external MemPoolEntry: vector capacity exceeded");
+    }
+    return success;
+}
+
+bool MemPoolConfig::setOwnerQuota(uint64_t entryIndex, uint32_t maxChunksPerOwner) noexcept
+{
+    if (entryIndex >= m_memPoolEntries.size())
+    {
+        ZEROCP_LOG(Error, "Cannot set owner quota: pool entry " << entryIndex << " does not exist");
+        return false;
+    }
+    m_memPoolEntries[entryIndex].m_ownerQuota = maxChunksPerOwner;
+    return true;
+}
+
+bool MemPoolConfig::setLargeChunkSegment(uint64_t segmentSize, uint32_t maxChunks) noexcept
+{
+    const uint64_t alignedSize = (segmentSize + TlsfHeap::kBlockAlignment - 1U) & ~(TlsfHeap::kBlockAlignment - 1U);
+    if (alignedSize < TlsfHeap::kMinBlockSize || alignedSize > TlsfHeap::kMaxArenaSize || maxChunks == 0U)
+    {
+        ZEROCP_LOG(Error, "Invalid large chunk segment: " << segmentSize << " bytes, " << maxChunks << " chunk(s)");
+        return false;
+    }
+    m_largeChunkSegmentSize = alignedSize;
+    m_largeChunkSlots = maxChunks;
+    return true;
+}
+
+bool MemPoolConfig::setChunkLayout(uint64_t entryIndex, uint32_t userPayloadAlignment, uint32_t userHeaderSize,
+                                   uint32_t userHeaderAlignment) noexcept
+{
+    if (entryIndex >= m_memPoolEntries.size())
+    {
+        ZEROCP_LOG(Error, "Cannot set chunk layout: pool entry " << entryIndex << " does not exist");
+        return false;
+    }
+    MemPoolEntry& entry = m_memPoolEntries[entryIndex];
+    if (!ChunkSetting::create(entry.m_chunkSize, userPayloadAlignment, userHeaderSize, userHeaderAlignment).has_value())
+    {
+        ZEROCP_LOG(Error, "Invalid chunk layout for pool entry " << entryIndex << ": payload alignment "
+                   << userPayloadAlignment << ", user header " << userHeaderSize << "B aligned to " << userHeaderAlignment);
+        return false;
+    }
+    entry.m_userPayloadAlignment = userPayloadAlignment;
+    entry.m_userHeaderSize = userHeaderSize;
+    entry.m_userHeaderAlignment = userHeaderAlignment;
+    return true;
+}
+
+ChunkSetting MemPoolConfig::getChunkSetting(uint64_t entryIndex) const noexcept
+{
+    const MemPoolEntry& entry = m_memPoolEntries[entryIndex];
+    // 布局参数在 setChunkLayout 中已经校验过
+    return ChunkSetting::create(entry.m_chunkSize, entry.m_userPayloadAlignment, entry.m_userHeaderSize,
+                                entry.m_userHeaderAlignment).value_or(ChunkSetting(entry.m_chunkSize));
+}
+
+bool MemPoolConfig::replicatePoolsForNumaNodes(uint32_t nodeCount) noexcept
+{
+    const uint64_t poolsPerNode = m_memPoolEntries.size();
+    if (nodeCount == 0U || nodeCount > kMaxNumaNodes || poolsPerNode * nodeCount > m_memPoolEntries.capacity())
+    {
+        ZEROCP_LOG(Error, "Cannot replicate " << poolsPerNode << " pool(s) for " << nodeCount << " NUMA node(s)");
+        return false;
+    }
+    for (uint32_t node = 1U; node < nodeCount; ++node)
+    {
+        for (uint64_t i = 0; i < poolsPerNode; ++i)
+        {
+            const MemPoolEntry& entry = m_memPoolEntries[i];
+            MemPoolEntry replica(entry.m_chunkSize, entry.m_chunkCount, node, entry.m_maxGrowthSegments);
+            replica.m_ownerQuota = entry.m_ownerQuota;
+            replica.m_userPayloadAlignment = entry.m_userPayloadAlignment;
+            replica.m_userHeaderSize = entry.m_userHeaderSize;
+            replica.m_userHeaderAlignment = entry.m_userHeaderAlignment;
+            replica.m_external = entry.m_external;
+            m_memPoolEntries.emplace_back(replica);
+        }
+    }
+    return true;
+}
+
+uint32_t MemPoolConfig::getNumaNodeCount() const noexcept
+{
+    uint32_t nodeCount = 1U;
+    for (const auto& entry : m_memPoolEntries)
+    {
+        nodeCount = std::max(nodeCount, entry.m_numaNode + 1U);
+    }
+    return nodeCount;
+}
+
+uint32_t MemPoolConfig::getGrowthSegmentCount(uint64_t entryIndex) const noexcept
+{
+    if (entryIndex >= m_memPoolEntries.size())
+    {
+        return 0U;
+    }
+    
+    // 排在前面的池先占用扩容段
+    uint32_t remaining = kMaxGrowthSegments;
+    uint32_t segments = 0U;
+    for (uint64_t i = 0; i <= entryIndex; ++i)
+    {
+        const MemPoolEntry& entry = m_memPoolEntries[i];
+        if (entry.m_external)
+        {
+            // 外部池不扩容，区域本身占用一个段ID
+            segments = 0U;
+            remaining -= std::min(remaining, 1U);
+            continue;
+        }
+        segments = std::min(entry.m_maxGrowthSegments, remaining);
+        if (entry.m_chunkCount != 0U)
+        {
+            // 空闲链表用 capacity 作为无效索引，capacity 必须小于 UINT32_MAX
+            const uint32_t segmentLimit = (UINT32_MAX - 1U) / entry.m_chunkCount;
+            segments = std::min(segments, (segmentLimit > 0U) ? segmentLimit - 1U : 0U);
+        }
+        remaining -= segments;
+    }
+    return segments;
+}
+
+uint32_t MemPoolConfig::getPoolCapacity(uint64_t entryIndex) const noexcept
+{
+    if (entryIndex >= m_memPoolEntries.size())
+    {
+        return 0U;
+    }
+    return m_memPoolEntries[entryIndex].m_chunkCount * (1U + getGrowthSegmentCount(entryIndex));
+}
+
 MemPoolConfig& MemPoolConfig::setdefaultPool() noexcept
 {
     // 使用 emplace_back 并检查返回值
@@ -9,7 +9,25 @@
 #include "posixshm_provider.hpp"
 #include <iostream>
 #include <cstring>  // memset
+#include <cerrno>
+#include <new>     // std::launder
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <climits>  // INT_MAX
 #include <fcntl.h>  // O_CREAT, O_EXCL
+#include <linux/futex.h>  // FUTEX_WAIT, FUTEX_WAKE
+#include <sched.h>     // getcpu
+#include <signal.h>    // kill
+#include <sys/mman.h>  // madvise, mlock, mincore
+#include <sys/stat.h>  // fstat
+#include <sys/syscall.h>  // SYS_mbind, SYS_get_mempolicy, SYS_futex
+#include <unistd.h>    // sysconf
+#include <linux/mempolicy.h>  // MPOL_BIND, MPOL_F_MEMS_ALLOWED
 #include "logging.hpp"
 
 using ZeroCP::Memory::align;
@@ -36,23 +54,71 @@ const char* MemPoolManager::CHUNK_SHM_NAME = "zerocp_memory_chunk";
 const char* MemPoolManager::SEM_NAME = "/zerocp_init_sem";
 std::unique_ptr<PosixShmProvider> MemPoolManager::s_mgmtProvider = nullptr;
 std::unique_ptr<PosixShmProvider> MemPoolManager::s_chunkProvider = nullptr;
+std::unique_ptr<PosixShmProvider> MemPoolManager::s_growthProviders[MemPoolManager::kMaxGrowthSegments];
+std::mutex MemPoolManager::s_growthMutex;
+MemPoolManager::ExternalMapping MemPoolManager::s_externalMappings[16];
 bool MemPoolManager::s_isOwner = false;
+std::atomic<bool> MemPoolManager::s_threadMagazinesEnabled{false};
+std::atomic<uint64_t> MemPoolManager::s_generation{0};
+uint32_t MemPoolManager::s_ownerSlot = MemPoolManager::kNoChunkOwner;
+uint32_t MemPoolManager::s_ownerEpoch = 0;
+
+static_assert(FIRST_GROWTH_POOL_ID + MemPoolConfig::kMaxGrowthSegments <= PoolRegistry::FIRST_DYNAMIC_POOL_ID,
+              "growth segment ids must stay inside the fixed pool id range");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+              "futex words must be plain 32-bit integers");
+static_assert(MemPoolManager::kMaxChunkOwners == ChunkManager::kMaxHolders,
+              "every owner slot needs a column in the chunk holder ledger");
+
+namespace
+{
+/// @brief 扩容段的共享内存名称：数据区名称 + 段ID（所有进程按段ID得到同一个名字）
+Name_t growthSegmentName(pool_id_t segmentId) noexcept
+{
+    return Name_t("zerocp_memory_chunk_") + std::to_string(segmentId);
+}
+} // namespace
 
 // ==================== 单例模式实现（共享内存版本） ====================
 
-bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
+MemPoolManager::SegmentSizes MemPoolManager::computeSegmentSizes(const MemPoolConfig& config) noexcept
 {
-    // 1. 创建临时 MemPoolManager 来计算内存大小
+    // 创建临时 MemPoolManager 来计算内存大小
     MemPoolConfig tempConfig = config;  // 拷贝配置
     MemPoolManager tempMgr(tempConfig);
-    
+    return tempMgr.layoutSegmentSizes();
+}
+
+MemPoolManager::SegmentSizes MemPoolManager::layoutSegmentSizes() const noexcept
+{
     // 管理区大小 = MemPoolManager对象(包含vectors) + 管理数据结构(freeLists + ChunkManagers)
     // 注意：MemPoolManager 对象已经包含了 m_memPoolVector 和 m_chunkManagementPool 两个成员
     // 所以不需要单独为 vectors 分配空间
+    SegmentSizes sizes;
+    sizes.m_managementSize = align(sizeof(MemPoolManager), 8U) + getManagementMemorySize();
+    sizes.m_chunkMemorySize = align(getChunkMemorySize(), 8U);
+    return sizes;
+}
+
+bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
+{
+    return createSharedInstance(config, computeSegmentSizes(config));
+}
+
+bool MemPoolManager::createSharedInstance(const MemPoolConfig& config, const SegmentSizes& sizes) noexcept
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    
+    // 1. 段大小由调用者给出（运行时配置在 computeSegmentSizes 中计算，静态配置在编译期算好）
     size_t managerObjSize = align(sizeof(MemPoolManager), 8U);
-    uint64_t managementDataSize = tempMgr.getManagementMemorySize();
-    uint64_t managementSize = managerObjSize + managementDataSize;
-    uint64_t chunkSize = align(tempMgr.getChunkMemorySize(), 8U);
+    uint64_t managementSize = sizes.m_managementSize;
+    uint64_t managementDataSize = managementSize - managerObjSize;
+    uint64_t chunkSize = sizes.m_chunkMemorySize;
+    if (managementSize < managerObjSize || chunkSize == 0U)
+    {
+        ZEROCP_LOG(Error, "Invalid segment sizes: management=" << managementSize << ", chunk=" << chunkSize);
+        return false;
+    }
     
     ZEROCP_LOG(Info, "Memory layout calculation:");
     ZEROCP_LOG(Info, "  - MemPoolManager object (includes vectors): " << managerObjSize << " bytes");
@@ -70,6 +136,8 @@ bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
         Perms::OwnerAll
     );
     
+    s_mgmtProvider->setPoolId(MANAGEMENT_POOL_ID);
+    
     auto mgmtResult = s_mgmtProvider->createMemory();
     if (!mgmtResult.has_value())
     {
@@ -88,6 +156,8 @@ bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
         OpenMode::OpenOrCreate,
         Perms::OwnerAll
     );
+    s_chunkProvider->setPoolId(CHUNK_POOL_ID);
+    s_chunkProvider->setHugePageMode(config.m_hugePageMode);
     
     auto chunkResult = s_chunkProvider->createMemory();
     if (!chunkResult.has_value())
@@ -152,13 +222,31 @@ bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
         s_instance = new (managerAddress) MemPoolManager(config);
         s_isOwner = true;  // 标记为拥有者
         
+        // 调用者给出的段大小（StaticMemPoolConfig 在编译期算出）必须与本配置的实际布局完全一致：
+        // 偏小会越界布局，偏大说明两套公式已经分叉，编译期选出的池也不再可信。只是几次算术，不构造临时对象
+        const SegmentSizes expectedSizes = s_instance->layoutSegmentSizes();
+        if (expectedSizes.m_managementSize != managementSize || expectedSizes.m_chunkMemorySize != chunkSize)
+        {
+            ZEROCP_LOG(Fatal, "Segment sizes do not match the configured layout: management=" << managementSize
+                       << " (expected " << expectedSizes.m_managementSize << "), chunk=" << chunkSize
+                       << " (expected " << expectedSizes.m_chunkMemorySize << ")");
+            s_instance->~MemPoolManager();
+            s_instance = nullptr;
+            sem_post(s_initSemaphore);
+            destroySharedInstance();
+            return false;
+        }
+        
         // 创建 MemPoolAllocator 实例进行内存布局
         MemPoolAllocator allocator(config, managementAddress);
+        void* largeChunkSlotMemory = nullptr;
+        void* largeChunkArena = nullptr;
         
         // 布局管理区内存（填充 vector 内容，分配 freeList 等）
         if (!allocator.ManagementMemoryLayout(actualManagementStart, actualManagementSize,
                                              s_instance->m_mempools, 
-                                             s_instance->m_chunkManagerPool))
+                                             s_instance->m_chunkManagerPool,
+                                             largeChunkSlotMemory))
         {
             ZEROCP_LOG(Error, "Failed to layout management memory");
             s_instance->~MemPoolManager();
@@ -169,7 +257,7 @@ bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
         
         // 布局数据区内存（分配 chunk 块并设置到 MemPool，同时记录 dataOffset）
         if (!allocator.ChunkMemoryLayout(chunkMemoryAddress, chunkSize,
-                                        s_instance->m_mempools))
+                                        s_instance->m_mempools, largeChunkArena))
         {
             ZEROCP_LOG(Error, "Failed to layout chunk memory");
             s_instance->~MemPoolManager();
@@ -178,6 +266,23 @@ bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
             return false;
         }
         
+        s_instance->assignNumaNodes();
+        s_instance->assignGrowthSegments();
+        s_instance->buildSizeClassTable();
+        s_instance->buildControlBlockTable();
+        s_instance->bindPoolsToNumaNodes();
+        s_instance->initializeOwnerAccounts();
+        if (!s_instance->initializeLargeChunkSegment(largeChunkSlotMemory, largeChunkArena))
+        {
+            s_instance->~MemPoolManager();
+            s_instance = nullptr;
+            sem_post(s_initSemaphore);
+            return false;
+        }
+        s_instance->m_fallbackPolicy.store(config.m_fallbackPolicy, std::memory_order_relaxed);
+        s_instance->m_chunkHugePageMode = s_chunkProvider->getHugePageMode();
+        s_instance->m_chunkPageSize = s_chunkProvider->getPageSize();
+        
         ZEROCP_LOG(Info, "Shared memory layout initialized successfully");
     }
     else
@@ -195,13 +300,112 @@ bool MemPoolManager::createSharedInstance(const MemPoolConfig& config) noexcept
     s_managementMemorySize = managementSize;
     s_chunkMemorySize = chunkSize;
     
+    s_generation.fetch_add(1, std::memory_order_release);
+    s_instance->registerChunkOwner();
+    
     // 8. 解锁信号量
     sem_post(s_initSemaphore);
     
-    ZEROCP_LOG(Info, "MemPoolManager shared instance created successfully");
+    // 9. 可选：预取/锁定本进程的映射（在锁外进行，不阻塞其他进程初始化）
+    prepareSegments(config);
+    
+    const auto elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    ZEROCP_LOG(Info, "MemPoolManager shared instance created successfully in " << elapsedMs << " ms");
     return true;
 }
 
+void MemPoolManager::prepareSegments(const MemPoolConfig& config) noexcept
+{
+    if (!config.m_prefaultSegments && !config.m_lockSegments)
+    {
+        return;
+    }
+    
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint64_t systemPageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t chunkPageSize = (s_chunkProvider != nullptr && s_chunkProvider->getPageSize() != 0U)
+                                   ? s_chunkProvider->getPageSize() : systemPageSize;
+    
+    if (config.m_prefaultSegments)
+    {
+        uint32_t threadCount = config.m_prefaultThreads;
+        if (threadCount == 0U)
+        {
+            threadCount = std::max(1U, std::thread::hardware_concurrency());
+        }
+        prefaultSegment(s_managementBaseAddress, s_managementMemorySize, systemPageSize, 1U);
+        prefaultSegment(s_chunkBaseAddress, s_chunkMemorySize, chunkPageSize, threadCount);
+        ZEROCP_LOG(Info, "Prefaulted " << ((s_managementMemorySize + s_chunkMemorySize) >> 20)
+                   << " MiB with " << threadCount << " thread(s)");
+    }
+    
+    if (config.m_lockSegments)
+    {
+        // mlock 本身也会把尚未预取的页调入
+        if (mlock(s_managementBaseAddress, s_managementMemorySize) != 0
+            || mlock(s_chunkBaseAddress, s_chunkMemorySize) != 0)
+        {
+            ZEROCP_LOG(Warn, "mlock of shared segments failed (check RLIMIT_MEMLOCK): " << strerror(errno));
+        }
+        else
+        {
+            ZEROCP_LOG(Info, "Locked shared segments in memory");
+        }
+    }
+    
+    const auto elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    ZEROCP_LOG(Info, "Startup segment preparation took " << elapsedMs << " ms (management="
+               << s_managementMemorySize << " bytes, chunk=" << s_chunkMemorySize
+               << " bytes, chunk page size=" << chunkPageSize << ")");
+}
+
+void MemPoolManager::prefaultSegment(void* baseAddress, uint64_t size, uint64_t pageSize, uint32_t threadCount) noexcept
+{
+    if (baseAddress == nullptr || size == 0U || pageSize == 0U)
+    {
+        return;
+    }
+    
+    // 每个线程负责一段连续的、按页对齐的区间
+    const uint64_t pageCount = (size + pageSize - 1U) / pageSize;
+    threadCount = static_cast<uint32_t>(std::min<uint64_t>(std::max(threadCount, 1U), pageCount));
+    const uint64_t pagesPerThread = (pageCount + threadCount - 1U) / threadCount;
+    
+    auto prefaultRange = [=](uint64_t firstPage, uint64_t lastPage) {
+        char* begin = static_cast<char*>(baseAddress) + firstPage * pageSize;
+        const uint64_t length = (lastPage - firstPage) * pageSize;
+#ifdef MADV_POPULATE_WRITE
+        // 内核 5.14+：直接建立可写页表项，不触碰内存内容
+        if (madvise(begin, length, MADV_POPULATE_WRITE) == 0)
+        {
+            return;
+        }
+#endif
+        // 回退：每页一次原子空写（加 0），既触发写缺页又不会覆盖其他进程可能已写入的数据
+        for (uint64_t offset = 0U; offset < length; offset += pageSize)
+        {
+            __atomic_fetch_add(begin + offset, static_cast<char>(0), __ATOMIC_RELAXED);
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1U);
+    for (uint32_t t = 1U; t < threadCount; ++t)
+    {
+        const uint64_t firstPage = t * pagesPerThread;
+        const uint64_t lastPage = std::min(pageCount, firstPage + pagesPerThread);
+        if (firstPage < lastPage)
+        {
+            threads.emplace_back(prefaultRange, firstPage, lastPage);
+        }
+    }
+    prefaultRange(0U, std::min(pageCount, pagesPerThread));  // 调用线程负责第一段
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
 bool MemPoolManager::attachToSharedInstance() noexcept
 {
     // 如果已经连接，直接返回成功
@@ -220,6 +424,8 @@ bool MemPoolManager::attachToSharedInstance() noexcept
         Perms::OwnerAll
     );
     
+    s_mgmtProvider->setPoolId(MANAGEMENT_POOL_ID);
+    
     auto mgmtResult = s_mgmtProvider->createMemory();
     if (!mgmtResult.has_value())
     {
@@ -238,6 +444,9 @@ bool MemPoolManager::attachToSharedInstance() noexcept
         OpenMode::OpenExisting,
         Perms::OwnerAll
     );
+    s_chunkProvider->setPoolId(CHUNK_POOL_ID);
+    // 按创建进程实际得到的页类型打开（显式大页位于 hugetlbfs，透明大页需在本进程映射上重新 madvise）
+    s_chunkProvider->setHugePageMode(static_cast<MemPoolManager*>(managementAddress)->m_chunkHugePageMode);
     
     auto chunkResult = s_chunkProvider->createMemory();
     if (!chunkResult.has_value())
@@ -268,6 +477,8 @@ bool MemPoolManager::attachToSharedInstance() noexcept
     s_chunkBaseAddress = chunkMemoryAddress;
     // 注意：这里我们不知道确切的大小，但不影响使用
     // 因为所有的内存布局信息都在共享内存的 MemPoolManager 对象中
+    s_generation.fetch_add(1, std::memory_order_release);
+    s_instance->registerChunkOwner();
     
     ZEROCP_LOG(Info, "Successfully attached to shared instance");
     return true;
@@ -284,6 +495,11 @@ void MemPoolManager::destroySharedInstance() noexcept
     {
         ZEROCP_LOG(Info, "Destroying shared instance (isOwner=" << s_isOwner << ")");
         
+        // 调用线程的弹匣可以安全归还；其他线程的弹匣在代数变化后被丢弃
+        s_instance->flushThreadMagazines();
+        s_instance->unregisterChunkOwner();
+        s_generation.fetch_add(1, std::memory_order_release);
+        
         // 只有拥有者才需要调用析构函数
         // MemPoolManager 对象在共享内存中，使用 placement new 构造
         // 所以需要手动调用析构函数，但不能使用 delete
@@ -303,6 +519,23 @@ void MemPoolManager::destroySharedInstance() noexcept
     }
     
     // 释放共享内存提供者（会自动取消映射和删除共享内存）
+    {
+        std::lock_guard<std::mutex> lock(s_growthMutex);
+        for (auto& provider : s_growthProviders)
+        {
+            provider.reset();
+        }
+        // 外部区域属于使用者，只解除本进程的映射
+        for (auto& mapping : s_externalMappings)
+        {
+            if (mapping.m_base != nullptr)
+            {
+                PoolRegistry::instance().unregisterPool(mapping.m_segmentId, mapping.m_base);
+                munmap(mapping.m_base, mapping.m_size);
+                mapping = ExternalMapping{};
+            }
+        }
+    }
     s_mgmtProvider.reset();
     s_chunkProvider.reset();
     
@@ -334,14 +567,28 @@ uint64_t MemPoolManager::getChunkMemorySize() const noexcept
 {
     // 数据区共享内存：存储所有 MemPool 的实际数据块
     // 每个 chunk = ChunkHeader + 用户数据
+    // 多个 NUMA 节点时每个池按页对齐（见 ChunkMemoryLayout），为每个池预留对齐填充
+    const uint64_t poolPadding = (m_config.getNumaNodeCount() > 1U) ? kNumaPoolAlignment : 0U;
     uint64_t totalMemorySize{0};
-    for(const auto& entry : m_config.m_memPoolEntries)
+    for (uint64_t i = 0; i < m_config.m_memPoolEntries.size(); ++i)
     {
-        // 每个 chunk 的实际大小 = ChunkHeader + chunkSize（用户数据）
-        uint64_t actualChunkSize = align(sizeof(ChunkHeader) + entry.m_chunkSize, 8U);
+        const auto& entry = m_config.m_memPoolEntries[i];
+        if (entry.m_external)
+        {
+            continue;  // chunk 数组在使用者登记的区域中
+        }
+        // 每个 chunk 的实际大小 = ChunkHeader + 用户头 + 用户数据（含对齐填充），池起始地址按 chunk 对齐
+        const ChunkSetting chunkSetting = m_config.getChunkSetting(i);
+        totalMemorySize += poolPadding + chunkSetting.getChunkAlignment();
+        uint64_t actualChunkSize = chunkSetting.getChunkSize();
         // 每个池的总数据大小 = chunk实际大小 × chunk数量
         totalMemorySize += actualChunkSize * entry.m_chunkCount;
     }
+    // 大块段在所有池之后，预留页对齐填充
+    if (m_config.m_largeChunkSegmentSize > 0U)
+    {
+        totalMemorySize += kLargeChunkArenaAlignment + m_config.m_largeChunkSegmentSize;
+    }
     return totalMemorySize;
 }
 
@@ -351,21 +598,29 @@ uint64_t MemPoolManager::getManagementMemorySize() const noexcept
     uint64_t totalMemorySize{0};
     uint64_t chunkNums{0};
     
-    // 1. 计算所有 MemPool 的 freeList 大小
-    for(const auto& entry : m_config.m_memPoolEntries)
+    // 1. 计算所有 MemPool 的 freeList 大小（按含扩容段的最大 chunk 数预留）
+    for (uint64_t i = 0; i < m_config.m_memPoolEntries.size(); ++i)
     {
         // 每个池的 freeList（MPMC 无锁链表索引数组）
-        auto poolmemorySize = align(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(entry.m_chunkCount), 8U);
+        const uint32_t capacity = m_config.getPoolCapacity(i);
+        auto poolmemorySize = align(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(capacity), 8U);
         totalMemorySize += poolmemorySize;
-        chunkNums += entry.m_chunkCount;
+        chunkNums += capacity;
     }
     
-    // 2. 所有 ChunkManager 对象的大小
-    totalMemorySize += chunkNums * align(sizeof(ChunkManager), 8U);
+    // 2. 所有 ChunkManager 控制块的大小（按 cache line 对齐，预留对齐填充；大块段每个槽位一个）
+    chunkNums += m_config.m_largeChunkSlots;
+    totalMemorySize += chunkNums * sizeof(ChunkManager) + alignof(ChunkManager);
     
     // 3. ChunkManagerPool 的 freeList 大小
     totalMemorySize += align(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(chunkNums), 8U);
     
+    // 4. 大块段控制块槽位的空闲链表
+    if (m_config.m_largeChunkSlots > 0U)
+    {
+        totalMemorySize += align(Concurrent::MPMC_LockFree_List::requiredIndexMemorySize(m_config.m_largeChunkSlots), 8U);
+    }
+    
     return totalMemorySize;
 }
 
@@ -390,6 +645,7 @@ bool MemPoolManager::initialize() noexcept
         OpenMode::OpenOrCreate,
         Perms::OwnerAll
     );
+    mgmtProvider.setPoolId(MANAGEMENT_POOL_ID);
     
     auto mgmtResult = mgmtProvider.createMemory();
     if (!mgmtResult.has_value())
@@ -407,6 +663,7 @@ bool MemPoolManager::initialize() noexcept
         OpenMode::OpenOrCreate,
         Perms::OwnerAll
     );
+    chunkProvider.setPoolId(CHUNK_POOL_ID);
     
     auto chunkResult = chunkProvider.createMemory();
     if (!chunkResult.has_value())
@@ -418,270 +675,2440 @@ bool MemPoolManager::initialize() noexcept
     
     // 创建MemPoolAllocator实例进行内存布局
     MemPoolAllocator allocator(m_config, chunkMemoryAddress);
+    void* largeChunkSlotMemory = nullptr;
+    void* largeChunkArena = nullptr;
     
     // 布局管理区内存
-    if (!allocator.ManagementMemoryLayout(managementAddress, ManagementMemorySize, m_mempools, m_chunkManagerPool))
+    if (!allocator.ManagementMemoryLayout(managementAddress, ManagementMemorySize, m_mempools, m_chunkManagerPool,
+                                          largeChunkSlotMemory))
     {
         ZEROCP_LOG(Error, "Failed to layout management memory");
         return false;
     }
     
     // 布局chunk区内存
-    if (!allocator.ChunkMemoryLayout(chunkMemoryAddress, ChunkMemorySize, m_mempools))
+    if (!allocator.ChunkMemoryLayout(chunkMemoryAddress, ChunkMemorySize, m_mempools, largeChunkArena))
     {
         ZEROCP_LOG(Error, "Failed to layout chunk memory");
         return false;
     }
     
+    assignNumaNodes();
+    assignGrowthSegments();
+    buildSizeClassTable();
+    buildControlBlockTable();
+    bindPoolsToNumaNodes();
+    initializeOwnerAccounts();
+    if (!initializeLargeChunkSegment(largeChunkSlotMemory, largeChunkArena))
+    {
+        return false;
+    }
+    m_fallbackPolicy.store(m_config.m_fallbackPolicy, std::memory_order_relaxed);
+    
     ZEROCP_LOG(Info, "MemPoolManager initialized successfully");
     return true;
 }
 
 // ==================== 核心分配/释放接口 ====================
 
-ChunkManager* MemPoolManager::getChunk(uint64_t size) noexcept
+ChunkManager* MemPoolManager::getChunk(uint64_t size, uint32_t alignment) noexcept
 {
-    // 1. 根据请求大小找到合适的 MemPool（选择最小满足条件的池）
-    MemPool* targetPool = nullptr;
-    uint64_t poolIndex = 0;
-    
-    for (uint64_t i = 0; i < m_mempools.size(); ++i)
+    if (!validateRequest(alignment))
     {
-        const auto& entry = m_config.m_memPoolEntries[i];
-        if (entry.m_chunkSize >= size)
-        {
-            targetPool = &m_mempools[i];
-            poolIndex = i;
-            break;
-        }
+        return nullptr;
     }
-    
-    if (targetPool == nullptr)
+    return allocateChunk(size, alignment, true);
+}
+
+ChunkManager* MemPoolManager::getChunk(uint64_t size, std::chrono::nanoseconds timeout, uint32_t alignment) noexcept
+{
+    if (!validateRequest(alignment))
     {
-        ZEROCP_LOG(Error, "No suitable pool found for size: " << size);
         return nullptr;
     }
     
-    // 2. 并行获取两个索引：数据 chunk 索引 和 ChunkManager 索引
-    uint32_t chunkIndex = 0;
-    uint32_t chunkMgrIndex = 0;
-    
-    // 2.1 从目标池获取数据 chunk 索引
-    if (!targetPool->allocateChunk(chunkIndex))
+    // 1. 没有满足条件的池时等待没有意义，按非阻塞路径报告错误
+    const uint32_t localNode = localNumaNode();
+    uint32_t firstPosition = 0U;
+    uint32_t lastPosition = 0U;
+    if (!findCandidatePositions(size, alignment, localNode, firstPosition, lastPosition))
     {
-        ZEROCP_LOG(Warn, "Pool " << poolIndex << " is full, no free chunks available");
-        return nullptr;
+        return allocateChunk(size, alignment, true);
     }
     
-    // 2.2 从 ChunkManagerPool 获取管理对象索引
-    if (m_chunkManagerPool.empty())
+    // 2. 自旋阶段：短暂的背压通常在几微秒内解除，不值得一次休眠/唤醒的系统调用
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + timeout;
+    const auto spinDeadline = start + std::min(timeout, kBlockingSpinDuration);
+    ChunkManager* chunkManager = allocateChunk(size, alignment, false);
+    while (chunkManager == nullptr && std::chrono::steady_clock::now() < spinDeadline)
     {
-        ZEROCP_LOG(Error, "ChunkManagerPool is not initialized");
-        targetPool->freeChunk(chunkIndex);  // 回滚：归还数据 chunk 索引
-        return nullptr;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+        chunkManager = allocateChunk(size, alignment, false);
     }
     
-    MemPool& chunkMgrPool = m_chunkManagerPool[0];
-    if (!chunkMgrPool.allocateChunk(chunkMgrIndex))
+    // 3. 休眠阶段：登记到每个候选池后在共用的 futex 字上等待。先登记等待者再读序号并重试全部候选池，
+    //    归还方在放回 chunk 之后检查该池的等待者数量，两者之间不会丢失唤醒
+    if (chunkManager == nullptr && timeout > kBlockingSpinDuration)
     {
-        ZEROCP_LOG(Warn, "ChunkManagerPool is full, no free ChunkManager available");
-        targetPool->freeChunk(chunkIndex);  // 回滚：归还数据 chunk 索引
-        return nullptr;
+        const uint32_t waitMask = candidatePoolMask(size, alignment);
+        for (uint32_t mask = waitMask; mask != 0U; mask &= mask - 1U)
+        {
+            m_poolWaitQueues[std::countr_zero(mask)].m_waiterCount.fetch_add(1U, std::memory_order_seq_cst);
+        }
+        while (true)
+        {
+            const uint32_t sequence = m_releaseSequence.load(std::memory_order_seq_cst);
+            chunkManager = allocateChunk(size, alignment, false);
+            const auto now = std::chrono::steady_clock::now();
+            if (chunkManager != nullptr || now >= deadline)
+            {
+                break;
+            }
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+            struct timespec relativeTimeout{};
+            relativeTimeout.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+            relativeTimeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+            // 共享 futex（不带 FUTEX_PRIVATE_FLAG）：等待者与归还者可以在不同进程中
+            syscall(SYS_futex, &m_releaseSequence, FUTEX_WAIT, sequence, &relativeTimeout, nullptr, 0);
+        }
+        for (uint32_t mask = waitMask; mask != 0U; mask &= mask - 1U)
+        {
+            m_poolWaitQueues[std::countr_zero(mask)].m_waiterCount.fetch_sub(1U, std::memory_order_relaxed);
+        }
     }
     
-    // 3. 计算内存地址（基于获取的索引）
-    const auto& entry = m_config.m_memPoolEntries[poolIndex];
-    const uint64_t actualChunkSize = align(sizeof(ChunkHeader) + entry.m_chunkSize, 8U);
-    
-    // 3.1 计算数据 chunk 地址：数据区基地址 + 池偏移 + 索引偏移
-    void* chunkAddress = static_cast<char*>(s_chunkBaseAddress) + 
-                         targetPool->getDataOffset() + 
-                         chunkIndex * actualChunkSize;
-    
-    // 3.2 计算 ChunkManager 地址：管理区基地址 + 池偏移 + 索引偏移
-    ChunkManager* chunkManager = reinterpret_cast<ChunkManager*>(
-        static_cast<char*>(s_managementBaseAddress) + 
-        chunkMgrPool.getDataOffset() + 
-        chunkMgrIndex * sizeof(ChunkManager)
-    );
-    
-    // 4. 初始化 ChunkManager
-    // 4.1 设置三个关键指针（使用相对偏移）
-    chunkManager->m_chunkHeader = RelativePointer<ChunkHeader>(
-        static_cast<ChunkHeader*>(s_chunkBaseAddress), 
-        static_cast<ChunkHeader*>(chunkAddress),
-        poolIndex
-    );
-    
-    chunkManager->m_mempool = RelativePointer<MemPool>(
-        static_cast<MemPool*>(s_managementBaseAddress),
-        targetPool,
-        poolIndex
-    );
-    
-    chunkManager->m_chunkManagementPool = RelativePointer<MemPool>(
-        static_cast<MemPool*>(s_managementBaseAddress),
-        &chunkMgrPool,
-        0  // ChunkManagerPool 的 poolIndex 固定为 0
-    );
-    
-    // 4.2 存储索引信息（用于跨进程地址重建）
-    chunkManager->m_chunkIndex = chunkIndex;
-    chunkManager->m_chunkManagerIndex = chunkMgrIndex;
-    
-    // 4.3 初始化引用计数
-    chunkManager->m_refCount.store(1, std::memory_order_relaxed);
-    
-    // 5. 初始化 ChunkHeader（设置元数据）
-    ChunkHeader* header = static_cast<ChunkHeader*>(chunkAddress);
-    header->m_userHeaderSize = 0;
-    header->m_reserved = 0;
-    header->m_originId = 0;
-    header->m_sequenceNumber = 0;
-    header->m_chunkSize = actualChunkSize;
-    header->m_userPayloadSize = size;
-    header->m_userPayloadAlignment = 8;
-    header->m_userPayloadOffset = sizeof(ChunkHeader);
-    
-    // 6. 更新池统计信息
-    targetPool->incrementUsedCount();
-    chunkMgrPool.incrementUsedCount();
-    
-    ZEROCP_LOG(Info, "Allocated chunk: pool=" << poolIndex 
-               << ", chunkIdx=" << chunkIndex 
-               << ", chunkMgrIdx=" << chunkMgrIndex
-               << ", size=" << size << "/" << actualChunkSize);
-    
+    if (chunkManager == nullptr)
+    {
+        m_mempools[m_sizeOrderedPools[localNode][firstPosition]].getTelemetry().recordFailedAllocation();
+        ZEROCP_LOG(Warn, "No free chunk for size " << size << " within "
+                   << std::chrono::duration_cast<std::chrono::microseconds>(timeout).count() << " us");
+    }
     return chunkManager;
 }
 
-bool MemPoolManager::releaseChunk(ChunkManager* chunkManager) noexcept
+ChunkManager* MemPoolManager::allocateChunk(uint64_t size, uint32_t alignment, bool reportExhaustion) noexcept
 {
-    if (chunkManager == nullptr)
+    
+    // 1. 先在调用线程所在 NUMA 节点的候选池（目标尺寸级别 + 回退策略允许的更大级别）中分配，
+    //    本地节点全部耗尽或没有足够大的池时再依次尝试其他节点
+    // 2. 控制块由 chunk 索引直接算出，无需第二次出栈
+    const uint32_t localNode = localNumaNode();
+    uint32_t chunkIndex = 0U;
+    uint32_t poolIndex = 0U;
+    bool acquired = false;
+    bool fromReservation = false;
+    bool suitablePoolFound = false;
+    uint32_t targetPool = 0U;
+    for (uint32_t step = 0U; step < m_numaNodeCount && !acquired; ++step)
     {
-        ZEROCP_LOG(Error, "Cannot release null ChunkManager");
-        return false;
+        const uint32_t node = (localNode + step) % m_numaNodeCount;
+        uint32_t firstPosition = 0U;
+        uint32_t lastPosition = 0U;
+        if (!findCandidatePositions(size, alignment, node, firstPosition, lastPosition))
+        {
+            continue;
+        }
+        if (!suitablePoolFound)
+        {
+            targetPool = m_sizeOrderedPools[node][firstPosition];
+        }
+        suitablePoolFound = true;
+        for (uint32_t position = firstPosition; position <= lastPosition && !acquired; ++position)
+        {
+            poolIndex = m_sizeOrderedPools[node][position];
+            acquired = acquireOwnedChunkIndex(poolIndex, chunkIndex, fromReservation);
+        }
+        if (acquired && step > 0U)
+        {
+            m_numaRemoteAllocations.fetch_add(1U, std::memory_order_relaxed);
+        }
     }
-    
-    // 1. 原子性地减少引用计数，并获取减少前的值
-    // 使用 fetch_sub 确保多进程环境下的原子性（共享内存中的原子操作）
-    uint64_t oldRefCount = chunkManager->m_refCount.fetch_sub(1, std::memory_order_acq_rel);
-    
-    if (oldRefCount == 0)
+    // 3. 创建进程（守护进程）可以就地为本地节点的目标尺寸级别追加一个扩容段
+    if (!acquired && suitablePoolFound && s_isOwner && growForRequest(size, alignment, localNode, poolIndex))
     {
-        // 不应该发生：引用计数已经是0还在释放
-        ZEROCP_LOG(Error, "Double-free detected: ref count already 0 for chunkMgrIdx=" 
-                   << chunkManager->m_chunkManagerIndex);
-        // 尝试恢复引用计数
-        chunkManager->m_refCount.fetch_add(1, std::memory_order_release);
-        return false;
+        acquired = acquireOwnedChunkIndex(poolIndex, chunkIndex, fromReservation);
     }
-    
-    if (oldRefCount > 1)
+    // 4. 超过最大尺寸级别的请求从大块段按实际大小分配
+    if (!suitablePoolFound && m_largeChunkHeap.isInitialized())
     {
-        // 减少后引用计数 >= 1，还有其他进程在使用，不执行真正的释放
-        ZEROCP_LOG(Info, "Decremented ref count from " << oldRefCount << " to " << (oldRefCount - 1)
-                   << " for chunkMgrIdx=" << chunkManager->m_chunkManagerIndex);
-        return true;
+        return allocateLargeChunk(size, alignment);
     }
-    
-    // 2. oldRefCount == 1，减少后变为 0，执行真正的资源释放
-    ZEROCP_LOG(Info, "Ref count reached 0, releasing resources for chunkMgrIdx=" 
-               << chunkManager->m_chunkManagerIndex);
-    
-    // 3. 从 ChunkManager 中获取索引信息
-    uint32_t chunkIndex = chunkManager->m_chunkIndex;
-    uint32_t chunkMgrIndex = chunkManager->m_chunkManagerIndex;
-    
-    // 4. 通过 RelativePointer 获取实际的池对象
-    // 在多进程环境下，RelativePointer::get() 会根据当前进程的基地址重建指针
-    MemPool* dataPool = chunkManager->m_mempool.get();
-    MemPool* chunkMgrPool = chunkManager->m_chunkManagementPool.get();
-    
-    if (dataPool == nullptr || chunkMgrPool == nullptr)
+    if (!acquired)
     {
-        ZEROCP_LOG(Error, "Invalid pool pointers in ChunkManager");
-        // 引用计数已经减为0，无法回滚，返回失败
-        return false;
+        if (!suitablePoolFound)
+        {
+            ZEROCP_LOG(Error, "No suitable pool found for size: " << size);
+        }
+        else if (reportExhaustion)
+        {
+            // 阻塞分配的自旋/休眠重试不计入，超时后由调用方计一次
+            m_mempools[targetPool].getTelemetry().recordFailedAllocation();
+            ZEROCP_LOG(Warn, "No free chunk for size " << size << " (candidate pools on "
+                       << static_cast<uint32_t>(m_numaNodeCount) << " NUMA node(s) exhausted)");
+        }
+        return nullptr;
     }
     
-    // 5. 将数据 chunk 索引归还到对应的数据池
-    if (!dataPool->freeChunk(chunkIndex))
+    // 5. 初始化控制块和 ChunkHeader
+    return completeAllocation(poolIndex, chunkIndex, size, alignment, fromReservation);
+}
+
+ChunkManager* MemPoolManager::getChunkFromPool(uint32_t poolIndex, uint64_t size, uint32_t alignment) noexcept
+{
+    // 池索引已在编译期确定：没有尺寸级别查找、NUMA 遍历和回退，只做一次出栈
+    uint32_t chunkIndex = 0U;
+    bool fromReservation = false;
+    if (poolIndex >= m_mempools.size() || !poolFits(poolIndex, size, alignment))
     {
-        ZEROCP_LOG(Error, "Failed to free chunk index " << chunkIndex << " to data pool");
-        return false;
+        return nullptr;
     }
-    
-    // 6. 将 ChunkManager 索引归还到 ChunkManagerPool
-    if (!chunkMgrPool->freeChunk(chunkMgrIndex))
+    if (!acquireOwnedChunkIndex(poolIndex, chunkIndex, fromReservation))
     {
-        ZEROCP_LOG(Error, "Failed to free ChunkManager index " << chunkMgrIndex);
-        // 尝试回滚：重新分配数据 chunk 索引（虽然可能失败）
-        dataPool->allocateChunk(chunkIndex);
-        return false;
+        m_mempools[poolIndex].getTelemetry().recordFailedAllocation();
+        return nullptr;
+    }
+    return completeAllocation(poolIndex, chunkIndex, size, alignment, fromReservation);
+}
+
+ChunkManager* MemPoolManager::completeAllocation(uint32_t poolIndex, uint32_t chunkIndex, uint64_t size,
+                                                 uint32_t alignment, bool fromReservation) noexcept
+{
+    ChunkManager* chunkManager = initializeChunk(poolIndex, chunkIndex, size, alignment, fromReservation);
+    if (chunkManager == nullptr)
+    {
+        if (fromReservation)
+        {
+            reservationListOf(s_ownerSlot, poolIndex).push(chunkIndex);
+        }
+        else
+        {
+            releaseChunkIndex(poolIndex, chunkIndex);
+            refundOwner(poolIndex, 1U);
+        }
+        return nullptr;
     }
     
-    // 7. 更新池统计信息（减少已使用计数）
-    dataPool->decrementUsedCount();
-    chunkMgrPool->decrementUsedCount();
+    // 5. 更新池统计信息（预留的 chunk 在预留时已计为已使用）
+    if (!fromReservation)
+    {
+        m_mempools[poolIndex].incrementUsedCount();
+    }
+    m_mempools[poolIndex].getTelemetry().recordAllocations(1U);
     
-    ZEROCP_LOG(Info, "Successfully released chunk: chunkIdx=" << chunkIndex 
-               << ", chunkMgrIdx=" << chunkMgrIndex);
+    // 每次分配/释放都会经过这里：只在 Debug 级别记录（宏先检查级别，关闭时不格式化参数）
+    ZEROCP_LOG(Debug, "Allocated chunk: pool=" << poolIndex 
+               << ", chunkIdx=" << chunkIndex 
+               << ", chunkMgrIdx=" << chunkManager->m_chunkManagerIndex
+               << ", size=" << size << "/" << m_mempools[poolIndex].getChunkSize());
     
-    return true;
+    return chunkManager;
 }
 
-void MemPoolManager::printAllPoolStats() const noexcept
+uint32_t MemPoolManager::getChunks(uint64_t size, uint32_t count, ChunkManager** chunks, uint32_t alignment) noexcept
 {
-    std::cout << "==================== MemPoolManager Stats ====================" << std::endl;
+    if (chunks == nullptr || count == 0U || !validateRequest(alignment))
+    {
+        return 0U;
+    }
     
-    // 安全检查：先检查 m_config 是否有效
-    try {
-        std::cout << "Data Pools: " << m_mempools.size() << std::endl;
-        
-        if (!m_mempools.empty())
+    uint32_t chunkIndices[kMaxBatchSize];
+    uint32_t allocated = 0U;
+    
+    // 从一个池中尽量多地分配，直到池耗尽或请求满足
+    auto allocateFromPool = [&](uint32_t poolIndex) {
+        MemPool& dataPool = m_mempools[poolIndex];
+        while (allocated < count)
         {
-            for (size_t i = 0; i < m_mempools.size(); ++i)
+            // 一次 CAS 从空闲链表摘下一整段索引（数量受本进程在该池的配额限制）
+            const uint32_t wanted = chargeOwner(poolIndex, std::min<uint32_t>(count - allocated, kMaxBatchSize));
+            if (wanted == 0U)
             {
-                const MemPool& pool = m_mempools[i];
-                std::cout << "  Pool[" << i << "]: "
-                          << "ChunkSize=" << pool.getChunkSize() << " bytes, "
-                          << "Total=" << pool.getTotalChunks() << ", "
-                          << "Used=" << pool.getUsedChunks() << ", "
-                          << "Free=" << pool.getFreeChunks() << std::endl;
+                break;  // 已达到配额，尝试下一个尺寸级别
+            }
+            const uint32_t chunkCount = dataPool.allocateChunks(chunkIndices, wanted);
+            if (chunkCount < wanted)
+            {
+                refundOwner(poolIndex, wanted - chunkCount);
+            }
+            if (chunkCount == 0U)
+            {
+                break;  // 当前池已耗尽，尝试下一个尺寸级别
+            }
+            
+            uint32_t initialized = 0U;
+            for (uint32_t i = 0U; i < chunkCount; ++i)
+            {
+                ChunkManager* chunkManager = initializeChunk(poolIndex, chunkIndices[i], size, alignment);
+                if (chunkManager == nullptr)
+                {
+                    dataPool.freeChunk(chunkIndices[i]);  // 所在扩容段无法映射
+                    refundOwner(poolIndex, 1U);
+                    continue;
+                }
+                chunks[allocated++] = chunkManager;
+                ++initialized;
+            }
+            
+            // 每批只更新一次统计信息
+            dataPool.incrementUsedCount(initialized);
+            dataPool.getTelemetry().recordAllocations(initialized);
+            if (initialized < chunkCount)
+            {
+                break;
             }
         }
-        else
+    };
+    
+    // 与 getChunk 相同的顺序：本地节点优先，其余节点按编号依次回退
+    const uint32_t localNode = localNumaNode();
+    bool suitablePoolFound = false;
+    uint32_t targetPool = 0U;
+    for (uint32_t step = 0U; step < m_numaNodeCount && allocated < count; ++step)
+    {
+        const uint32_t node = (localNode + step) % m_numaNodeCount;
+        uint32_t firstPosition = 0U;
+        uint32_t lastPosition = 0U;
+        if (!findCandidatePositions(size, alignment, node, firstPosition, lastPosition))
         {
-            std::cout << "  (No data pools initialized)" << std::endl;
+            continue;
         }
-
-        if (!m_chunkManagerPool.empty())
+        if (!suitablePoolFound)
         {
-            const MemPool& mgmtPool = m_chunkManagerPool[0];
-            std::cout << "ChunkManager Pool: "
-                      << "Total=" << mgmtPool.getTotalChunks() << ", "
-                      << "Used=" << mgmtPool.getUsedChunks() << ", "
-                      << "Free=" << mgmtPool.getFreeChunks() << std::endl;
+            targetPool = m_sizeOrderedPools[node][firstPosition];
         }
-        else
+        suitablePoolFound = true;
+        
+        const uint32_t allocatedBefore = allocated;
+        for (uint32_t position = firstPosition; position <= lastPosition && allocated < count; ++position)
         {
-            std::cout << "ChunkManager Pool: (Not initialized)" << std::endl;
+            allocateFromPool(m_sizeOrderedPools[node][position]);
+        }
+        if (step > 0U && allocated > allocatedBefore)
+        {
+            m_numaRemoteAllocations.fetch_add(allocated - allocatedBefore, std::memory_order_relaxed);
         }
     }
-    catch (...)
+    
+    // 创建进程在所有候选池耗尽后逐段扩容本地节点的目标尺寸级别
+    uint32_t grownPool = 0U;
+    while (allocated < count && suitablePoolFound && s_isOwner
+           && growForRequest(size, alignment, localNode, grownPool))
     {
-        std::cout << "ERROR: Exception occurred while printing stats" << std::endl;
+        allocateFromPool(grownPool);
     }
     
-    std::cout << "===============================================================" << std::endl;
-}
+    // 超过最大尺寸级别：逐个从大块段分配（每个都要一次堆操作，没有批量路径）
+    while (allocated < count && !suitablePoolFound && m_largeChunkHeap.isInitialized())
+    {
+        ChunkManager* chunkManager = allocateLargeChunk(size, alignment);
+        if (chunkManager == nullptr)
+        {
+            break;
+        }
+        chunks[allocated++] = chunkManager;
+    }
+    
+    if (allocated < count)
+    {
+        if (suitablePoolFound)
+        {
+            m_mempools[targetPool].getTelemetry().recordFailedAllocation();
+        }
+        ZEROCP_LOG(Warn, "Batch allocation for size " << size << " satisfied " << allocated << "/" << count);
+    }
+    else
+    {
+        ZEROCP_LOG(Debug, "Allocated " << allocated << " chunks of size " << size << " in batch");
+    }
+    return allocated;
+}
+
+bool MemPoolManager::validateRequest(uint32_t alignment) const noexcept
+{
+    if (alignment == 0U || (alignment & (alignment - 1U)) != 0U)
+    {
+        ZEROCP_LOG(Error, "Invalid payload alignment: " << alignment);
+        return false;
+    }
+    if (m_chunkManagerPool.empty())
+    {
+        ZEROCP_LOG(Error, "ChunkManagerPool is not initialized");
+        return false;
+    }
+    return true;
+}
+
+bool MemPoolManager::findCandidatePositions(uint64_t size, uint32_t alignment, uint32_t numaNode,
+                                            uint32_t& firstPosition, uint32_t& lastPosition) const noexcept
+{
+    // 尺寸级别表给出第一个容量足够的池；布局对齐小于请求对齐的池需要额外的填充，跳过放不下的
+    const uint32_t poolCount = m_sizeOrderedPoolCount[numaNode];
+    firstPosition = findSizeClassPosition(size, numaNode);
+    while (firstPosition < poolCount && !poolFits(m_sizeOrderedPools[numaNode][firstPosition], size, alignment))
+    {
+        ++firstPosition;
+    }
+    if (firstPosition >= poolCount)
+    {
+        return false;
+    }
+    
+    uint32_t maxLastPosition = firstPosition;
+    switch (m_fallbackPolicy.load(std::memory_order_relaxed))
+    {
+    case ChunkFallbackPolicy::NONE:
+        break;
+    case ChunkFallbackPolicy::NEXT_LARGER:
+        maxLastPosition = std::min<uint32_t>(firstPosition + 1U, poolCount - 1U);
+        break;
+    case ChunkFallbackPolicy::ANY_LARGER:
+        maxLastPosition = poolCount - 1U;
+        break;
+    }
+    // 候选区间只包含连续的、放得下的池
+    lastPosition = firstPosition;
+    while (lastPosition < maxLastPosition && poolFits(m_sizeOrderedPools[numaNode][lastPosition + 1U], size, alignment))
+    {
+        ++lastPosition;
+    }
+    return true;
+}
+
+uint32_t MemPoolManager::candidatePoolMask(uint64_t size, uint32_t alignment) const noexcept
+{
+    // 与 allocateChunk 的查找顺序一致：每个节点上的候选区间都可能满足请求
+    uint32_t mask = 0U;
+    for (uint32_t node = 0U; node < m_numaNodeCount; ++node)
+    {
+        uint32_t firstPosition = 0U;
+        uint32_t lastPosition = 0U;
+        if (!findCandidatePositions(size, alignment, node, firstPosition, lastPosition))
+        {
+            continue;
+        }
+        for (uint32_t position = firstPosition; position <= lastPosition; ++position)
+        {
+            mask |= 1U << m_sizeOrderedPools[node][position];
+        }
+    }
+    return mask;
+}
+
+bool MemPoolManager::poolFits(uint32_t poolIndex, uint64_t size, uint32_t alignment) const noexcept
+{
+    // 用户数据的固定偏移满足布局对齐，超出布局对齐的请求需要预留最多 (alignment - 布局对齐) 字节填充
+    const ChunkSetting& chunkSetting = m_mempools[poolIndex].getChunkSetting();
+    const uint64_t alignmentPadding = (alignment > chunkSetting.getUserPayloadAlignment())
+        ? alignment - chunkSetting.getUserPayloadAlignment() : 0U;
+    return m_mempools[poolIndex].getChunkSize() >= size + alignmentPadding;
+}
+
+ChunkManager* MemPoolManager::controlBlockOf(uint32_t poolIndex, uint32_t chunkIndex) noexcept
+{
+    return static_cast<ChunkManager*>(m_chunkManagerPool[0].getRawMemory()) + m_controlBlockBase[poolIndex] + chunkIndex;
+}
+
+void MemPoolManager::initializeControlBlock(ChunkManager& chunkManager, uint32_t poolIndex, uint32_t chunkIndex,
+                                            uint32_t chunkManagerIndex, bool fromReservation) noexcept
+{
+    chunkManager.m_refCount.store(1, std::memory_order_relaxed);
+    chunkManager.m_chunkIndex = chunkIndex;
+    chunkManager.m_chunkManagerIndex = chunkManagerIndex;
+    chunkManager.m_mempoolIndex = poolIndex;
+    chunkManager.m_ownerSlot = static_cast<uint16_t>(s_ownerSlot);
+    chunkManager.m_ownerEpoch = static_cast<uint16_t>(s_ownerEpoch);
+    chunkManager.m_fromReservation = fromReservation;
+    chunkManager.m_nextChunkIndex = ChunkManager::kNoNextChunk;
+    for (auto& holderReferences : chunkManager.m_holderReferences)
+    {
+        holderReferences.store(0U, std::memory_order_relaxed);
+    }
+    if (s_ownerSlot != kNoChunkOwner)
+    {
+        chunkManager.m_holderReferences[s_ownerSlot].store(1U, std::memory_order_relaxed);
+    }
+}
+
+ChunkManager* MemPoolManager::initializeChunk(uint32_t poolIndex, uint32_t chunkIndex,
+                                              uint64_t size, uint32_t alignment, bool fromReservation) noexcept
+{
+    MemPool* targetPool = &m_mempools[poolIndex];
+    
+    // 1. 计算数据 chunk 地址：所在段的起始地址（经 PoolRegistry 转换到本进程）+ 段内索引偏移
+    const ChunkSetting& chunkSetting = targetPool->getChunkSetting();
+    void* chunkAddress = chunkAddressOf(poolIndex, chunkIndex);
+    if (chunkAddress == nullptr)
+    {
+        return nullptr;
+    }
+    
+    // 2. 控制块与 chunk 一一对应；启动时不初始化控制块，索引字段与引用计数在同一 cache line 上一起写入
+    ChunkManager* chunkManager = controlBlockOf(poolIndex, chunkIndex);
+    initializeControlBlock(*chunkManager, poolIndex, chunkIndex, m_controlBlockBase[poolIndex] + chunkIndex,
+                           fromReservation);
+    
+    // 3. 初始化 ChunkHeader（设置元数据）
+    ChunkHeader* header = static_cast<ChunkHeader*>(chunkAddress);
+    header->m_userHeaderSize = chunkSetting.getUserHeaderSize();
+    header->m_reserved = 0;
+    header->m_userHeaderOffset = static_cast<uint16_t>(chunkSetting.getUserHeaderOffset());
+    header->m_originId = 0;
+    header->m_sequenceNumber = 0;
+    header->m_chunkSize = chunkSetting.getChunkSize();
+    header->m_userPayloadSize = size;
+    // 池的布局已满足的对齐直接使用固定偏移；更大的对齐按本次请求在 chunk 内向后对齐（选池时已计入填充）
+    if (alignment <= chunkSetting.getUserPayloadAlignment())
+    {
+        header->m_userPayloadAlignment = chunkSetting.getUserPayloadAlignment();
+        header->m_userPayloadOffset = chunkSetting.getUserPayloadOffset();
+    }
+    else
+    {
+        const uint64_t payloadAddress = align(reinterpret_cast<uint64_t>(chunkAddress) + chunkSetting.getUserPayloadOffset(),
+                                              static_cast<uint64_t>(alignment));
+        header->m_userPayloadAlignment = alignment;
+        header->m_userPayloadOffset = payloadAddress - reinterpret_cast<uint64_t>(chunkAddress);
+    }
+    
+    return chunkManager;
+}
+
+bool MemPoolManager::releaseChunk(ChunkManager* chunkManager) noexcept
+{
+    if (chunkManager == nullptr)
+    {
+        ZEROCP_LOG(Error, "Cannot release null ChunkManager");
+        return false;
+    }
+    
+    // 1. 先从本进程的账本中划掉这个引用（引用计数归零后控制块可能立即被其他进程重新初始化）
+    eraseHolder(*chunkManager);
+    
+    // 2. 原子性地减少引用计数，并获取减少前的值
+    // 使用 fetch_sub 确保多进程环境下的原子性（共享内存中的原子操作）
+    uint64_t oldRefCount = chunkManager->m_refCount.fetch_sub(1, std::memory_order_acq_rel);
+    
+    if (oldRefCount == 0)
+    {
+        // 不应该发生：引用计数已经是0还在释放
+        ZEROCP_LOG(Error, "Double-free detected: ref count already 0 for chunkMgrIdx=" 
+                   << chunkManager->m_chunkManagerIndex);
+        // 尝试恢复引用计数
+        chunkManager->m_refCount.fetch_add(1, std::memory_order_release);
+        return false;
+    }
+    
+    if (oldRefCount > 1)
+    {
+        // 减少后引用计数 >= 1，还有其他进程在使用，不执行真正的释放
+        ZEROCP_LOG(Debug, "Decremented ref count from " << oldRefCount << " to " << (oldRefCount - 1)
+                   << " for chunkMgrIdx=" << chunkManager->m_chunkManagerIndex);
+        return true;
+    }
+    
+    // 3. oldRefCount == 1，减少后变为 0，执行真正的资源释放
+    ZEROCP_LOG(Debug, "Ref count reached 0, releasing resources for chunkMgrIdx=" 
+               << chunkManager->m_chunkManagerIndex);
+    if (!recycleChunk(*chunkManager))
+    {
+        return false;
+    }
+    
+    ZEROCP_LOG(Debug, "Successfully released chunk: chunkIdx=" << chunkManager->m_chunkIndex 
+               << ", chunkMgrIdx=" << chunkManager->m_chunkManagerIndex);
+    
+    return true;
+}
+
+bool MemPoolManager::recycleChunk(const ChunkManager& chunkManager) noexcept
+{
+    // 1. 从控制块中获取索引信息；链头先归还后面的段
+    uint32_t chunkIndex = chunkManager.m_chunkIndex;
+    uint32_t mempoolIndex = chunkManager.m_mempoolIndex;
+    if (chunkManager.m_nextChunkIndex != ChunkManager::kNoNextChunk)
+    {
+        recycleContinuations(chunkManager);
+    }
+    if (mempoolIndex == kLargeChunkPool)
+    {
+        return recycleLargeChunk(chunkManager);
+    }
+    
+    // 2. 通过索引定位池对象
+    // MemPoolManager 本身就在共享内存中，m_mempools 在每个进程里都能直接访问，
+    // 用索引查找不依赖任何进程的映射地址，释放端可以是任意进程
+    if (mempoolIndex >= m_mempools.size())
+    {
+        ZEROCP_LOG(Error, "Invalid pool index in ChunkManager: " << mempoolIndex);
+        // 引用计数已经减为0，无法回滚，返回失败
+        return false;
+    }
+    
+    // 3. 按所有者记账；预留的 chunk 回到所有者的私有链表
+    m_mempools[mempoolIndex].getTelemetry().recordFrees(1U);
+    if (dischargeOwner(chunkManager))
+    {
+        return true;
+    }
+    
+    // 4. 归还数据 chunk 索引（启用线程弹匣时先放入弹匣），控制块随之空闲
+    if (!releaseChunkIndex(mempoolIndex, chunkIndex))
+    {
+        return false;
+    }
+    
+    // 5. 更新池统计信息（减少已使用计数）
+    m_mempools[mempoolIndex].decrementUsedCount();
+    return true;
+}
+
+bool MemPoolManager::releaseChunks(std::span<ChunkManager* const> chunkManagers) noexcept
+{
+    // 按数据池分组收集引用计数归零的索引，最后每个空闲链表只做一次 CAS
+    uint32_t chunkIndices[16][kMaxBatchSize];
+    uint32_t chunkCounts[16] = {};
+    uint32_t freedCounts[16] = {};
+    bool success = true;
+    
+    auto flush = [&](uint32_t poolIndex) {
+        if (chunkCounts[poolIndex] > 0U)
+        {
+            m_mempools[poolIndex].freeChunks(chunkIndices[poolIndex], chunkCounts[poolIndex]);
+            m_mempools[poolIndex].decrementUsedCount(chunkCounts[poolIndex]);
+            notifyChunksReleased(poolIndex);
+            chunkCounts[poolIndex] = 0U;
+        }
+    };
+    
+    for (ChunkManager* chunkManager : chunkManagers)
+    {
+        if (chunkManager == nullptr)
+        {
+            continue;
+        }
+        
+        eraseHolder(*chunkManager);
+        const uint64_t oldRefCount = chunkManager->m_refCount.fetch_sub(1, std::memory_order_acq_rel);
+        if (oldRefCount == 0)
+        {
+            ZEROCP_LOG(Error, "Double-free detected: ref count already 0 for chunkMgrIdx=" 
+                       << chunkManager->m_chunkManagerIndex);
+            chunkManager->m_refCount.fetch_add(1, std::memory_order_release);
+            success = false;
+            continue;
+        }
+        if (oldRefCount > 1)
+        {
+            continue;  // 仍有其他持有者
+        }
+        if (chunkManager->m_nextChunkIndex != ChunkManager::kNoNextChunk)
+        {
+            recycleContinuations(*chunkManager);
+        }
+        
+        const uint32_t mempoolIndex = chunkManager->m_mempoolIndex;
+        if (mempoolIndex == kLargeChunkPool)
+        {
+            success = recycleLargeChunk(*chunkManager) && success;
+            continue;
+        }
+        if (mempoolIndex >= m_mempools.size())
+        {
+            ZEROCP_LOG(Error, "Invalid pool index in ChunkManager: " << mempoolIndex);
+            success = false;
+            continue;
+        }
+        ++freedCounts[mempoolIndex];
+        if (dischargeOwner(*chunkManager))
+        {
+            continue;  // 回到所有者的预留链表
+        }
+        
+        // 该池的缓冲区满时先归还已收集的部分
+        if (chunkCounts[mempoolIndex] == kMaxBatchSize)
+        {
+            flush(mempoolIndex);
+        }
+        chunkIndices[mempoolIndex][chunkCounts[mempoolIndex]++] = chunkManager->m_chunkIndex;
+    }
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        flush(poolIndex);
+        if (freedCounts[poolIndex] > 0U)
+        {
+            m_mempools[poolIndex].getTelemetry().recordFrees(freedCounts[poolIndex]);
+        }
+    }
+    
+    ZEROCP_LOG(Debug, "Released batch of " << chunkManagers.size() << " chunk reference(s)");
+    return success;
+}
+
+// ==================== 链式消息 ====================
+
+ChunkManager* MemPoolManager::getChunkChain(uint64_t size, uint32_t alignment) noexcept
+{
+    if (!validateRequest(alignment))
+    {
+        return nullptr;
+    }
+    const uint64_t segmentSize = getChainSegmentSize(alignment);
+    if (segmentSize == 0U)
+    {
+        ZEROCP_LOG(Error, "No pool can hold a chain segment with alignment " << alignment);
+        return nullptr;
+    }
+    if (size <= segmentSize)
+    {
+        return allocateChunk(size, alignment, true);
+    }
+    
+    ChunkManager* head = nullptr;
+    ChunkManager* tail = nullptr;
+    ChunkManager* segments[kMaxBatchSize];
+    uint64_t remaining = size;
+    while (remaining > 0U)
+    {
+        // 1. 满段按批分配（每批一次 CAS），不足一段的尾部按实际大小选池
+        const uint64_t fullSegments = remaining / segmentSize;
+        uint32_t allocated = 0U;
+        if (fullSegments > 0U)
+        {
+            allocated = getChunks(segmentSize, static_cast<uint32_t>(std::min<uint64_t>(fullSegments, kMaxBatchSize)),
+                                  segments, alignment);
+        }
+        else
+        {
+            segments[0] = allocateChunk(remaining, alignment, true);
+            allocated = (segments[0] != nullptr) ? 1U : 0U;
+        }
+        if (allocated == 0U)
+        {
+            ZEROCP_LOG(Warn, "Chunk chain allocation for size " << size << " failed with "
+                       << remaining << " bytes left");
+            if (head != nullptr)
+            {
+                releaseChunk(head);
+            }
+            return nullptr;
+        }
+        
+        // 2. 后续段交给链头管理：先从账本划掉、清零引用计数，再挂到链上
+        //    （两步之间崩溃只会泄漏这一段，不会被回收两次）
+        for (uint32_t i = 0U; i < allocated; ++i)
+        {
+            ChunkManager* segment = segments[i];
+            if (head == nullptr)
+            {
+                head = segment;
+            }
+            else
+            {
+                eraseHolder(*segment);
+                segment->m_refCount.store(0U, std::memory_order_relaxed);
+                tail->m_nextChunkIndex = segment->m_chunkManagerIndex;
+            }
+            tail = segment;
+            remaining -= std::min(remaining, segmentSize);
+        }
+    }
+    
+    ZEROCP_LOG(Debug, "Allocated chunk chain for size " << size << ": head chunkMgrIdx="
+               << head->m_chunkManagerIndex << ", segment size " << segmentSize);
+    return head;
+}
+
+ChunkManager* MemPoolManager::getNextChunk(const ChunkManager* chunkManager) noexcept
+{
+    if (chunkManager == nullptr || chunkManager->m_nextChunkIndex == ChunkManager::kNoNextChunk)
+    {
+        return nullptr;
+    }
+    return getChunkManagerByIndex(chunkManager->m_nextChunkIndex);
+}
+
+uint32_t MemPoolManager::getChunkSegments(const ChunkManager* chunkManager, std::span<iovec> segments) noexcept
+{
+    uint32_t segmentCount = 0U;
+    for (const ChunkManager* segment = chunkManager; segment != nullptr; segment = getNextChunk(segment))
+    {
+        if (segmentCount < segments.size())
+        {
+            ChunkHeader* header = getChunkHeader(segment);
+            if (header == nullptr)
+            {
+                break;
+            }
+            segments[segmentCount].iov_base = reinterpret_cast<char*>(header) + header->m_userPayloadOffset;
+            segments[segmentCount].iov_len = header->m_userPayloadSize;
+        }
+        ++segmentCount;
+    }
+    return segmentCount;
+}
+
+uint64_t MemPoolManager::getChainSegmentSize(uint32_t alignment) const noexcept
+{
+    // 与 poolFits 相同的容量计算：chunk 大小减去超出布局对齐的填充
+    uint64_t segmentSize = 0U;
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        if (isExternalPool(poolIndex))
+        {
+            continue;
+        }
+        const ChunkSetting& chunkSetting = m_mempools[poolIndex].getChunkSetting();
+        const uint64_t alignmentPadding = (alignment > chunkSetting.getUserPayloadAlignment())
+            ? alignment - chunkSetting.getUserPayloadAlignment() : 0U;
+        const uint64_t chunkSize = m_mempools[poolIndex].getChunkSize();
+        if (chunkSize > alignmentPadding)
+        {
+            segmentSize = std::max(segmentSize, chunkSize - alignmentPadding);
+        }
+    }
+    return segmentSize;
+}
+
+void MemPoolManager::recycleContinuations(const ChunkManager& head) noexcept
+{
+    // 先读出下一段再归还当前段：归还后的控制块可能立即被其他进程重新分配
+    uint32_t nextIndex = head.m_nextChunkIndex;
+    while (nextIndex != ChunkManager::kNoNextChunk)
+    {
+        ChunkManager* segment = getChunkManagerByIndex(nextIndex);
+        if (segment == nullptr)
+        {
+            return;
+        }
+        nextIndex = segment->m_nextChunkIndex;
+        segment->m_nextChunkIndex = ChunkManager::kNoNextChunk;
+        recycleChunk(*segment);
+    }
+}
+
+// ==================== 尺寸级别查找 ====================
+
+uint32_t MemPoolManager::sizeClassBucket(uint64_t size) noexcept
+{
+    // 向上取整的 log2：1 -> 0, 2 -> 1, 3..4 -> 2, 5..8 -> 3, ...
+    return (size <= 1U) ? 0U : static_cast<uint32_t>(std::bit_width(size - 1U));
+}
+
+void MemPoolManager::buildSizeClassTable() noexcept
+{
+    const uint32_t poolCount = static_cast<uint32_t>(m_mempools.size());
+    for (uint32_t node = 0U; node < m_numaNodeCount; ++node)
+    {
+        // 1. 按 chunk 大小升序排列该节点的池索引（大小相同的池保持配置顺序）
+        uint8_t* orderedPools = m_sizeOrderedPools[node];
+        uint32_t nodePoolCount = 0U;
+        for (uint32_t i = 0U; i < poolCount; ++i)
+        {
+            // 外部池只能通过 getChunkFromPool 分配，不参与按大小选池
+            if (m_poolNumaNode[i] == node && !isExternalPool(i))
+            {
+                orderedPools[nodePoolCount++] = static_cast<uint8_t>(i);
+            }
+        }
+        std::stable_sort(orderedPools, orderedPools + nodePoolCount,
+                         [this](uint8_t lhs, uint8_t rhs) {
+                             return m_mempools[lhs].getChunkSize() < m_mempools[rhs].getChunkSize();
+                         });
+        m_sizeOrderedPoolCount[node] = static_cast<uint8_t>(nodePoolCount);
+        
+        // 2. 每个桶记录第一个能容纳该桶最小请求的位置；
+        //    查找时最多向后跳过同一桶内较小的池
+        for (uint32_t bucket = 0U; bucket < kSizeClassBuckets; ++bucket)
+        {
+            const uint64_t bucketMinSize = (bucket == 0U) ? 0U : (uint64_t{1} << (bucket - 1U)) + 1U;
+            uint32_t position = 0U;
+            while (position < nodePoolCount && m_mempools[orderedPools[position]].getChunkSize() < bucketMinSize)
+            {
+                ++position;
+            }
+            m_sizeClassTable[node][bucket] = static_cast<uint8_t>(position);
+        }
+    }
+}
+
+void MemPoolManager::buildControlBlockTable() noexcept
+{
+    // 池 i 的控制块紧跟在池 0..i-1 之后：基址为之前所有池的最大 chunk 数之和（扩容段的控制块预先预留）
+    // 控制块本身不在这里初始化（O(池数)），索引字段在 chunk 第一次分配时写入
+    uint32_t base = 0U;
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        m_controlBlockBase[poolIndex] = base;
+        base += m_mempools[poolIndex].getCapacity();
+    }
+    m_largeChunkControlBase = base;
+}
+
+uint32_t MemPoolManager::findSizeClassPosition(uint64_t size, uint32_t numaNode) const noexcept
+{
+    uint32_t position = m_sizeClassTable[numaNode][sizeClassBucket(size)];
+    while (position < m_sizeOrderedPoolCount[numaNode]
+           && m_mempools[m_sizeOrderedPools[numaNode][position]].getChunkSize() < size)
+    {
+        ++position;
+    }
+    return position;
+}
+
+uint32_t MemPoolManager::findPoolIndex(uint64_t size) const noexcept
+{
+    const uint32_t localNode = localNumaNode();
+    for (uint32_t step = 0U; step < m_numaNodeCount; ++step)
+    {
+        const uint32_t node = (localNode + step) % m_numaNodeCount;
+        const uint32_t position = findSizeClassPosition(size, node);
+        if (position < m_sizeOrderedPoolCount[node])
+        {
+            return m_sizeOrderedPools[node][position];
+        }
+    }
+    return static_cast<uint32_t>(m_mempools.size());
+}
+
+// ==================== NUMA ====================
+
+void MemPoolManager::assignNumaNodes() noexcept
+{
+    // 本进程允许使用的节点集合；不支持 NUMA 的内核（ENOSYS）或单节点机器上只有节点 0
+    unsigned long allowedNodes = 1UL;
+    if (m_config.getNumaNodeCount() > 1U)
+    {
+        unsigned long nodeMask = 0UL;
+        if (syscall(SYS_get_mempolicy, nullptr, &nodeMask, sizeof(nodeMask) * 8U, nullptr, MPOL_F_MEMS_ALLOWED) == 0
+            && nodeMask != 0UL)
+        {
+            allowedNodes = nodeMask;
+        }
+        else
+        {
+            ZEROCP_LOG(Warn, "NUMA policy unavailable, all pools fall back to node 0: " << strerror(errno));
+        }
+    }
+    
+    uint32_t nodeCount = 1U;
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        uint32_t node = m_config.m_memPoolEntries[poolIndex].m_numaNode;
+        if (node >= kMaxNumaNodes || ((allowedNodes >> node) & 1UL) == 0UL)
+        {
+            if (node != 0U)
+            {
+                ZEROCP_LOG(Warn, "NUMA node " << node << " of pool " << poolIndex << " is not available, using node 0");
+            }
+            node = 0U;
+        }
+        m_poolNumaNode[poolIndex] = static_cast<uint8_t>(node);
+        nodeCount = std::max(nodeCount, node + 1U);
+    }
+    m_numaNodeCount = static_cast<uint8_t>(nodeCount);
+}
+
+void MemPoolManager::bindPoolsToNumaNodes() const noexcept
+{
+    if (m_numaNodeCount <= 1U)
+    {
+        return;
+    }
+    
+    // 策略设置在共享内存对象上，之后任何进程首次访问这些页时都从所属节点分配
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        if (isExternalPool(poolIndex))
+        {
+            continue;  // 区域属于使用者，内存策略由使用者决定
+        }
+        const MemPool& pool = m_mempools[poolIndex];
+        const uint64_t actualChunkSize = pool.getChunkSetting().getChunkSize();
+        void* poolAddress = pool.getRawMemory();
+        const uint64_t poolSize = actualChunkSize * pool.getSegmentChunks();
+        unsigned long nodeMask = 1UL << m_poolNumaNode[poolIndex];
+        if (syscall(SYS_mbind, poolAddress, poolSize, MPOL_BIND, &nodeMask, sizeof(nodeMask) * 8U, 0U) != 0)
+        {
+            // 例如大页数据区上池起始地址未按大页对齐：chunk 仍可使用，只是不保证本地
+            ZEROCP_LOG(Warn, "mbind of pool " << poolIndex << " to NUMA node "
+                       << static_cast<uint32_t>(m_poolNumaNode[poolIndex]) << " failed: " << strerror(errno));
+        }
+    }
+    ZEROCP_LOG(Info, "Bound " << m_mempools.size() << " pool(s) to " << static_cast<uint32_t>(m_numaNodeCount)
+               << " NUMA node(s)");
+}
+
+uint32_t MemPoolManager::localNumaNode() const noexcept
+{
+    if (m_numaNodeCount <= 1U)
+    {
+        return 0U;
+    }
+    // getcpu 走 vDSO，不陷入内核；线程迁移后下一次分配自然跟随新节点
+    unsigned int cpu = 0U;
+    unsigned int node = 0U;
+    if (getcpu(&cpu, &node) != 0 || node >= m_numaNodeCount)
+    {
+        return 0U;
+    }
+    return node;
+}
+
+uint32_t MemPoolManager::getNumaNodeCount() const noexcept
+{
+    return m_numaNodeCount;
+}
+
+uint32_t MemPoolManager::getPoolNumaNode(uint32_t poolIndex) const noexcept
+{
+    return (poolIndex < m_mempools.size()) ? m_poolNumaNode[poolIndex] : 0U;
+}
+
+uint64_t MemPoolManager::getNumaRemoteAllocationCount() const noexcept
+{
+    return m_numaRemoteAllocations.load(std::memory_order_relaxed);
+}
+
+// ==================== 运行时扩容 ====================
+
+void MemPoolManager::assignGrowthSegments() noexcept
+{
+    // 段ID按池顺序连续分配，所有进程由共享内存中的这张表得到同一个段ID（进而得到同一个共享内存名称）
+    uint32_t nextSegmentId = static_cast<uint32_t>(FIRST_GROWTH_POOL_ID);
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        // 外部池不扩容，区域本身占用一个段ID
+        if (m_config.m_memPoolEntries[poolIndex].m_external)
+        {
+            ExternalRegionDescriptor& region = m_externalRegions[poolIndex];
+            if (nextSegmentId < FIRST_GROWTH_POOL_ID + kMaxGrowthSegments)
+            {
+                region.m_segmentId = nextSegmentId++;
+            }
+            else
+            {
+                ZEROCP_LOG(Warn, "External pool " << poolIndex << " has no segment ID left (at most "
+                           << kMaxGrowthSegments << " growth/external segments in total)");
+            }
+            region.m_state.store(ExternalRegionState::VACANT, std::memory_order_release);
+            continue;
+        }
+        
+        const MemPool& pool = m_mempools[poolIndex];
+        const uint32_t growthSegments = pool.getCapacity() / pool.getSegmentChunks() - 1U;
+        if (growthSegments < m_config.m_memPoolEntries[poolIndex].m_maxGrowthSegments)
+        {
+            ZEROCP_LOG(Warn, "Pool " << poolIndex << " limited to " << growthSegments << " growth segment(s) (requested "
+                       << m_config.m_memPoolEntries[poolIndex].m_maxGrowthSegments << ", at most "
+                       << kMaxGrowthSegments << " in total)");
+        }
+        m_growthSegmentBase[poolIndex] = static_cast<uint8_t>(nextSegmentId);
+        nextSegmentId += growthSegments;
+    }
+}
+
+void* MemPoolManager::chunkAddressOf(uint32_t poolIndex, uint32_t chunkIndex) const noexcept
+{
+    const MemPool& pool = m_mempools[poolIndex];
+    const uint64_t actualChunkSize = pool.getChunkSetting().getChunkSize();
+    const uint32_t segmentChunks = pool.getSegmentChunks();
+    
+    // 热路径：初始段（外部池的区域在本进程第一次访问时映射）
+    if (chunkIndex < segmentChunks)
+    {
+        const pool_id_t segmentId = pool.getSegmentId();
+        if (segmentId != CHUNK_POOL_ID && PoolRegistry::instance().baseOf(segmentId) == 0U
+            && mapExternalRegion(poolIndex) == 0U)
+        {
+            return nullptr;
+        }
+        return static_cast<char*>(pool.getRawMemory()) + chunkIndex * actualChunkSize;
+    }
+    
+    // 扩容段：段ID -> 本进程基地址，本进程第一次遇到该段时才映射
+    const pool_id_t segmentId = m_growthSegmentBase[poolIndex] + chunkIndex / segmentChunks - 1U;
+    std::uintptr_t segmentBase = PoolRegistry::instance().baseOf(segmentId);
+    if (segmentBase == 0U)
+    {
+        segmentBase = mapGrowthSegment(segmentId);
+        if (segmentBase == 0U)
+        {
+            return nullptr;
+        }
+    }
+    return reinterpret_cast<char*>(segmentBase) + (chunkIndex % segmentChunks) * actualChunkSize;
+}
+
+std::uintptr_t MemPoolManager::mapGrowthSegment(pool_id_t segmentId) noexcept
+{
+    std::lock_guard<std::mutex> lock(s_growthMutex);
+    
+    // 等锁期间其他线程可能已经映射
+    const std::uintptr_t registeredBase = PoolRegistry::instance().baseOf(segmentId);
+    if (registeredBase != 0U || s_instance == nullptr)
+    {
+        return registeredBase;
+    }
+    
+    auto provider = std::make_unique<PosixShmProvider>(
+        growthSegmentName(segmentId),
+        0,  // 大小从已存在的共享内存中获取
+        AccessMode::ReadWrite,
+        OpenMode::OpenExisting,
+        Perms::OwnerAll
+    );
+    provider->setPoolId(segmentId);
+    provider->setHugePageMode(s_instance->m_chunkHugePageMode);
+    
+    auto result = provider->createMemory();
+    if (!result.has_value())
+    {
+        ZEROCP_LOG(Error, "Failed to open growth segment " << segmentId);
+        return 0U;
+    }
+    ZEROCP_LOG(Info, "Mapped growth segment " << segmentId << " at " << result.value());
+    s_growthProviders[segmentId - FIRST_GROWTH_POOL_ID] = std::move(provider);
+    return reinterpret_cast<std::uintptr_t>(result.value());
+}
+
+bool MemPoolManager::growPool(uint32_t poolIndex) noexcept
+{
+    if (!s_isOwner)
+    {
+        ZEROCP_LOG(Warn, "Only the creating process can grow pools");
+        return false;
+    }
+    if (poolIndex >= m_mempools.size())
+    {
+        ZEROCP_LOG(Error, "Invalid pool index for growth: " << poolIndex);
+        return false;
+    }
+    if (isExternalPool(poolIndex))
+    {
+        ZEROCP_LOG(Warn, "External pool " << poolIndex << " cannot grow");
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(s_growthMutex);
+    MemPool& pool = m_mempools[poolIndex];
+    const uint32_t activeChunks = pool.getTotalChunks();
+    if (pool.getCapacity() - activeChunks < pool.getSegmentChunks())
+    {
+        ZEROCP_LOG(Debug, "Pool " << poolIndex << " reached its growth ceiling (" << pool.getCapacity() << " chunks)");
+        return false;
+    }
+    
+    // 1. 创建扩容段（与初始数据区相同的页类型）；残留的同名段来自崩溃的上一个实例，直接清除
+    const pool_id_t segmentId = m_growthSegmentBase[poolIndex] + activeChunks / pool.getSegmentChunks() - 1U;
+    const uint64_t actualChunkSize = pool.getChunkSetting().getChunkSize();
+    const uint64_t segmentSize = actualChunkSize * pool.getSegmentChunks();
+    auto provider = std::make_unique<PosixShmProvider>(
+        growthSegmentName(segmentId),
+        segmentSize,
+        AccessMode::ReadWrite,
+        OpenMode::PurgeAndCreate,
+        Perms::OwnerAll
+    );
+    provider->setPoolId(segmentId);
+    provider->setHugePageMode(m_chunkHugePageMode);
+    
+    auto result = provider->createMemory();
+    if (!result.has_value())
+    {
+        ZEROCP_LOG(Error, "Failed to create growth segment " << segmentId << " for pool " << poolIndex);
+        return false;
+    }
+    
+    // 2. 与初始段一样绑定到池所属的 NUMA 节点（在首次访问之前）
+    if (m_numaNodeCount > 1U)
+    {
+        unsigned long nodeMask = 1UL << m_poolNumaNode[poolIndex];
+        if (syscall(SYS_mbind, result.value(), segmentSize, MPOL_BIND, &nodeMask, sizeof(nodeMask) * 8U, 0U) != 0)
+        {
+            ZEROCP_LOG(Warn, "mbind of growth segment " << segmentId << " to NUMA node "
+                       << static_cast<uint32_t>(m_poolNumaNode[poolIndex]) << " failed: " << strerror(errno));
+        }
+    }
+    s_growthProviders[segmentId - FIRST_GROWTH_POOL_ID] = std::move(provider);
+    
+    // 3. 段已可按名字打开，再让新索引进入空闲链表
+    pool.activateSegment();
+    notifyChunksReleased(poolIndex);
+    
+    ZEROCP_LOG(Info, "Pool " << poolIndex << " grew by " << pool.getSegmentChunks() << " chunks (segment "
+               << segmentId << ", " << pool.getTotalChunks() << "/" << pool.getCapacity() << ")");
+    return true;
+}
+
+uint32_t MemPoolManager::growPoolsBelowWatermark(uint32_t freePercent) noexcept
+{
+    uint32_t grownSegments = 0U;
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        const MemPool& pool = m_mempools[poolIndex];
+        const uint64_t totalChunks = pool.getTotalChunks();
+        if (totalChunks >= pool.getCapacity()
+            || static_cast<uint64_t>(pool.getFreeChunks()) * 100U >= totalChunks * freePercent)
+        {
+            continue;
+        }
+        if (growPool(poolIndex))
+        {
+            ++grownSegments;
+        }
+    }
+    return grownSegments;
+}
+
+bool MemPoolManager::growForRequest(uint64_t size, uint32_t alignment, uint32_t numaNode, uint32_t& poolIndex) noexcept
+{
+    // 从目标尺寸级别开始，找第一个还能扩容的候选池
+    uint32_t firstPosition = 0U;
+    uint32_t lastPosition = 0U;
+    if (!findCandidatePositions(size, alignment, numaNode, firstPosition, lastPosition))
+    {
+        return false;
+    }
+    for (uint32_t position = firstPosition; position <= lastPosition; ++position)
+    {
+        poolIndex = m_sizeOrderedPools[numaNode][position];
+        if (growPool(poolIndex))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t MemPoolManager::getPoolSegmentCount(uint32_t poolIndex) const noexcept
+{
+    if (poolIndex >= m_mempools.size())
+    {
+        return 0U;
+    }
+    const MemPool& pool = m_mempools[poolIndex];
+    return pool.getTotalChunks() / pool.getSegmentChunks();
+}
+
+// ==================== 外部区域 ====================
+
+bool MemPoolManager::isExternalPool(uint32_t poolIndex) const noexcept
+{
+    return poolIndex < m_mempools.size()
+        && m_externalRegions[poolIndex].m_state.load(std::memory_order_relaxed) != ExternalRegionState::NOT_EXTERNAL;
+}
+
+bool MemPoolManager::isExternalRegionRegistered(uint32_t poolIndex) const noexcept
+{
+    return poolIndex < m_mempools.size()
+        && m_externalRegions[poolIndex].m_state.load(std::memory_order_acquire) == ExternalRegionState::REGISTERED;
+}
+
+bool MemPoolManager::registerExternalRegion(uint32_t poolIndex, const char* shmName, uint64_t offset) noexcept
+{
+    if (shmName == nullptr || shmName[0] == '\0' || std::strlen(shmName) >= ExternalRegionDescriptor::kMaxNameLength)
+    {
+        ZEROCP_LOG(Error, "Invalid shared memory name for external pool " << poolIndex);
+        return false;
+    }
+    return registerRegion(poolIndex, shmName, -1, offset);
+}
+
+bool MemPoolManager::registerExternalRegion(uint32_t poolIndex, int fd, uint64_t offset) noexcept
+{
+    if (fd < 0)
+    {
+        ZEROCP_LOG(Error, "Invalid file descriptor for external pool " << poolIndex);
+        return false;
+    }
+    return registerRegion(poolIndex, nullptr, fd, offset);
+}
+
+bool MemPoolManager::registerRegion(uint32_t poolIndex, const char* shmName, int fd, uint64_t offset) noexcept
+{
+    if (!isExternalPool(poolIndex))
+    {
+        ZEROCP_LOG(Error, "Pool " << poolIndex << " is not an external pool");
+        return false;
+    }
+    ExternalRegionDescriptor& region = m_externalRegions[poolIndex];
+    MemPool& pool = m_mempools[poolIndex];
+    const ChunkSetting& chunkSetting = pool.getChunkSetting();
+    if (region.m_segmentId == 0U || offset % chunkSetting.getChunkAlignment() != 0U)
+    {
+        ZEROCP_LOG(Error, "Cannot register external pool " << poolIndex << ": "
+                   << ((region.m_segmentId == 0U) ? "no segment ID" : "offset not aligned to the chunk alignment"));
+        return false;
+    }
+    
+    // 1. 占用描述符：每个外部池只能登记一次
+    ExternalRegionState expected = ExternalRegionState::VACANT;
+    if (!region.m_state.compare_exchange_strong(expected, ExternalRegionState::REGISTERING, std::memory_order_acq_rel))
+    {
+        ZEROCP_LOG(Error, "External pool " << poolIndex << " already has a region");
+        return false;
+    }
+    
+    // 2. 区域必须容纳整个 chunk 数组
+    const uint64_t mappedSize = offset + chunkSetting.getChunkSize() * pool.getSegmentChunks();
+    const int regionFd = (shmName != nullptr) ? shm_open(shmName, O_RDWR, 0) : fd;
+    struct stat regionStat{};
+    void* base = MAP_FAILED;
+    const char* failure = nullptr;
+    if (regionFd < 0 || fstat(regionFd, &regionStat) != 0)
+    {
+        failure = strerror(errno);
+    }
+    else if (static_cast<uint64_t>(regionStat.st_size) < mappedSize)
+    {
+        failure = "region too small";
+    }
+    else if ((base = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, regionFd, 0)) == MAP_FAILED)
+    {
+        failure = strerror(errno);
+    }
+    if (shmName != nullptr && regionFd >= 0)
+    {
+        close(regionFd);
+    }
+    if (failure != nullptr)
+    {
+        ZEROCP_LOG(Error, "Cannot map external region for pool " << poolIndex << " (needs " << mappedSize
+                   << " bytes, region has " << regionStat.st_size << "): " << failure);
+        region.m_state.store(ExternalRegionState::VACANT, std::memory_order_release);
+        return false;
+    }
+    
+    // 3. 填写描述符，其他进程据此打开同一个区域
+    region.m_offset = offset;
+    region.m_mappedSize = mappedSize;
+    if (shmName != nullptr)
+    {
+        std::strncpy(region.m_shmName, shmName, ExternalRegionDescriptor::kMaxNameLength - 1U);
+        region.m_fd = -1;
+        region.m_ownerPid = 0U;
+    }
+    else
+    {
+        region.m_shmName[0] = '\0';
+        region.m_fd = fd;
+        region.m_ownerPid = static_cast<uint32_t>(getpid());
+    }
+    
+    // 4. 本进程注册映射，池的 chunk 数组指向区域（相对段ID保存，其他进程按自己的映射解析）
+    {
+        std::lock_guard<std::mutex> lock(s_growthMutex);
+        s_externalMappings[poolIndex] = ExternalMapping{base, mappedSize, region.m_segmentId};
+        PoolRegistry::instance().registerPool(region.m_segmentId, base);
+    }
+    pool.setRawMemory(static_cast<char*>(base) + offset, offset, region.m_segmentId);
+    
+    // 5. 先发布描述符，再让 chunk 可被分配：拿到 chunk 的进程一定能映射区域
+    region.m_state.store(ExternalRegionState::REGISTERED, std::memory_order_release);
+    pool.activateSegment();
+    notifyChunksReleased(poolIndex);
+    
+    ZEROCP_LOG(Info, "Registered external region for pool " << poolIndex << ": " << pool.getSegmentChunks()
+               << " chunk(s) of " << chunkSetting.getChunkSize() << " bytes at offset " << offset
+               << " (segment " << region.m_segmentId << ")");
+    return true;
+}
+
+std::uintptr_t MemPoolManager::mapExternalRegion(uint32_t poolIndex) const noexcept
+{
+    std::lock_guard<std::mutex> lock(s_growthMutex);
+    
+    // 等锁期间其他线程可能已经映射
+    const ExternalRegionDescriptor& region = m_externalRegions[poolIndex];
+    const std::uintptr_t registeredBase = PoolRegistry::instance().baseOf(region.m_segmentId);
+    if (registeredBase != 0U || region.m_state.load(std::memory_order_acquire) != ExternalRegionState::REGISTERED)
+    {
+        return registeredBase;
+    }
+    
+    // POSIX 共享内存按名字打开；memfd 通过登记进程的 /proc/<pid>/fd/<fd> 打开
+    const int regionFd = (region.m_shmName[0] != '\0')
+        ? shm_open(region.m_shmName, O_RDWR, 0)
+        : open(("/proc/" + std::to_string(region.m_ownerPid) + "/fd/" + std::to_string(region.m_fd)).c_str(), O_RDWR);
+    if (regionFd < 0)
+    {
+        ZEROCP_LOG(Error, "Failed to open external region of pool " << poolIndex << ": " << strerror(errno));
+        return 0U;
+    }
+    void* base = mmap(nullptr, region.m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, regionFd, 0);
+    close(regionFd);
+    if (base == MAP_FAILED)
+    {
+        ZEROCP_LOG(Error, "Failed to map external region of pool " << poolIndex << ": " << strerror(errno));
+        return 0U;
+    }
+    
+    s_externalMappings[poolIndex] = ExternalMapping{base, region.m_mappedSize, region.m_segmentId};
+    PoolRegistry::instance().registerPool(region.m_segmentId, base);
+    ZEROCP_LOG(Info, "Mapped external region of pool " << poolIndex << " at " << base);
+    return reinterpret_cast<std::uintptr_t>(base);
+}
+
+// ==================== 大块段（TLSF 堆） ====================
+
+bool MemPoolManager::initializeLargeChunkSegment(void* slotIndexMemory, void* arena) noexcept
+{
+    if (m_config.m_largeChunkSegmentSize == 0U)
+    {
+        return true;
+    }
+    if (slotIndexMemory == nullptr || arena == nullptr
+        || !m_largeChunkHeap.initialize(arena, CHUNK_POOL_ID, m_config.m_largeChunkSegmentSize))
+    {
+        ZEROCP_LOG(Error, "Failed to initialize large chunk segment");
+        return false;
+    }
+    
+    // 槽位 i 对应控制块 m_largeChunkControlBase + i；与池的空闲链表一样，初始化不写索引数组
+    auto* slotList = new (m_largeChunkSlotList)
+        Concurrent::MPMC_LockFree_List(static_cast<uint32_t*>(slotIndexMemory), m_config.m_largeChunkSlots);
+    slotList->Initialize();
+    
+    ZEROCP_LOG(Info, "Large chunk segment: " << m_config.m_largeChunkSegmentSize << " bytes, "
+               << m_config.m_largeChunkSlots << " slot(s) from control block " << m_largeChunkControlBase);
+    return true;
+}
+
+Concurrent::MPMC_LockFree_List& MemPoolManager::largeChunkSlots() noexcept
+{
+    return *std::launder(reinterpret_cast<Concurrent::MPMC_LockFree_List*>(m_largeChunkSlotList));
+}
+
+ChunkManager* MemPoolManager::allocateLargeChunk(uint64_t size, uint32_t alignment) noexcept
+{
+    // 1. 控制块槽位：同时存在的大块 chunk 数受槽位数限制
+    uint32_t slot = 0U;
+    if (!largeChunkSlots().pop(slot))
+    {
+        ZEROCP_LOG(Warn, "No free large chunk slot for size " << size << " (" << largeChunkSlots().getCapacity()
+                   << " large chunk(s) in use)");
+        return nullptr;
+    }
+    
+    // 2. 在堆中分配 ChunkHeader + 最坏情况的对齐填充 + 用户数据
+    uint64_t chunkOffset = 0U;
+    if (size > UINT64_MAX - sizeof(ChunkHeader) - alignment
+        || !m_largeChunkHeap.allocate(sizeof(ChunkHeader) + alignment + size, chunkOffset))
+    {
+        largeChunkSlots().push(slot);
+        ZEROCP_LOG(Warn, "Large chunk segment exhausted for size " << size << " ("
+                   << m_largeChunkHeap.getUsedBytes() << "/" << m_largeChunkHeap.getArenaSize() << " bytes used)");
+        return nullptr;
+    }
+    
+    // 3. 控制块：池索引为 kLargeChunkPool，chunk 索引为块在堆中的偏移（按粒度）
+    const uint32_t chunkManagerIndex = m_largeChunkControlBase + slot;
+    ChunkManager* chunkManager = static_cast<ChunkManager*>(m_chunkManagerPool[0].getRawMemory()) + chunkManagerIndex;
+    initializeControlBlock(*chunkManager, kLargeChunkPool,
+                           static_cast<uint32_t>(chunkOffset / TlsfHeap::kBlockAlignment), chunkManagerIndex, false);
+    
+    // 4. ChunkHeader：堆按页对齐，用户数据按堆内偏移对齐即在每个进程中都对齐
+    ChunkHeader* header = static_cast<ChunkHeader*>(m_largeChunkHeap.addressOf(chunkOffset));
+    header->m_userHeaderSize = 0U;
+    header->m_reserved = 0;
+    header->m_userHeaderOffset = static_cast<uint16_t>(sizeof(ChunkHeader));
+    header->m_originId = 0;
+    header->m_sequenceNumber = 0;
+    header->m_chunkSize = m_largeChunkHeap.usableSizeOf(chunkOffset);
+    header->m_userPayloadSize = size;
+    header->m_userPayloadAlignment = alignment;
+    header->m_userPayloadOffset = align(chunkOffset + sizeof(ChunkHeader), static_cast<uint64_t>(alignment)) - chunkOffset;
+    
+    ZEROCP_LOG(Debug, "Allocated large chunk: offset=" << chunkOffset
+               << ", chunkMgrIdx=" << chunkManagerIndex
+               << ", size=" << size << "/" << header->m_chunkSize);
+    return chunkManager;
+}
+
+bool MemPoolManager::recycleLargeChunk(const ChunkManager& chunkManager) noexcept
+{
+    const uint32_t slot = chunkManager.m_chunkManagerIndex - m_largeChunkControlBase;
+    if (!m_largeChunkHeap.isInitialized() || chunkManager.m_chunkManagerIndex < m_largeChunkControlBase
+        || slot >= largeChunkSlots().getCapacity())
+    {
+        ZEROCP_LOG(Error, "Invalid large chunk control block: " << chunkManager.m_chunkManagerIndex);
+        return false;
+    }
+    
+    // 先还内存再还槽位：拿到槽位的分配者不会看到仍在使用中的块
+    if (!m_largeChunkHeap.free(static_cast<uint64_t>(chunkManager.m_chunkIndex) * TlsfHeap::kBlockAlignment))
+    {
+        return false;
+    }
+    return largeChunkSlots().push(slot);
+}
+
+bool MemPoolManager::isLargeChunkSegmentEnabled() const noexcept
+{
+    return m_largeChunkHeap.isInitialized();
+}
+
+const TlsfHeap& MemPoolManager::getLargeChunkHeap() const noexcept
+{
+    return m_largeChunkHeap;
+}
+
+uint64_t MemPoolManager::getLargestFreeLargeChunk() noexcept
+{
+    return m_largeChunkHeap.getLargestFreeBlock();
+}
+
+// ==================== 空闲 chunk 物理页回收 ====================
+
+void MemPoolManager::sampleChunkUsage() noexcept
+{
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        m_peakUsedSinceReclaim[poolIndex] = std::max(m_peakUsedSinceReclaim[poolIndex],
+                                                     m_mempools[poolIndex].getUsedChunks());
+    }
+}
+
+uint64_t MemPoolManager::reclaimIdleChunks() noexcept
+{
+    sampleChunkUsage();
+    
+    uint64_t releasedBytes = 0U;
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        if (isExternalPool(poolIndex))
+        {
+            continue;  // 不在使用者的区域上打洞
+        }
+        // 上次回收以来最多有 (峰值 - 当前) 个归还的 chunk 被再次分配过，它们位于回收栈顶部；
+        // 再多保留一批，覆盖线程弹匣和采样间隔内的波动
+        const uint32_t usedChunks = m_mempools[poolIndex].getUsedChunks();
+        const uint32_t reuseDepth = m_peakUsedSinceReclaim[poolIndex] - std::min(m_peakUsedSinceReclaim[poolIndex], usedChunks);
+        releasedBytes += reclaimPool(poolIndex, reuseDepth + kMaxBatchSize);
+        m_peakUsedSinceReclaim[poolIndex] = usedChunks;
+    }
+    
+    if (releasedBytes > 0U)
+    {
+        m_reclaimedBytes.fetch_add(releasedBytes, std::memory_order_relaxed);
+        ZEROCP_LOG(Info, "Reclaimed " << (releasedBytes >> 10) << " KiB of idle chunk memory");
+    }
+    return releasedBytes;
+}
+
+uint64_t MemPoolManager::reclaimPool(uint32_t poolIndex, uint32_t hotDepth) noexcept
+{
+    MemPool& pool = m_mempools[poolIndex];
+    
+    // 1. 摘下回收栈中 hotDepth 之后的冷尾：热的部分随即放回，并发分配照常从栈顶取 chunk；
+    //    冷 chunk 在 madvise 期间不在链表中，不会被分配。从未使用过的 chunk 本来就没有物理页，不需要处理
+    std::vector<uint32_t> cold(pool.getCapacity());
+    cold.resize(pool.detachColdChunks(hotDepth, cold.data()));
+    if (cold.empty())
+    {
+        return 0U;
+    }
+    
+    // 2. 按地址顺序释放物理页，相邻 chunk 合并为一次 madvise
+    std::vector<uint32_t> sortedCold(cold);
+    std::sort(sortedCold.begin(), sortedCold.end());
+    const uint64_t releasedBytes = releaseChunkPages(poolIndex, sortedCold);
+    
+    // 3. 冷 chunk 放入冷链表（一次 CAS）：回收栈为空时才从冷链表分配，热 chunk 优先复用
+    pool.appendColdChunks(cold.data(), static_cast<uint32_t>(cold.size()));
+    notifyChunksReleased(poolIndex);
+    
+    ZEROCP_LOG(Debug, "Pool " << poolIndex << ": " << cold.size() << " cold free chunk(s), released "
+               << releasedBytes << " bytes");
+    return releasedBytes;
+}
+
+uint64_t MemPoolManager::releaseChunkPages(uint32_t poolIndex, std::span<const uint32_t> sortedChunkIndices) noexcept
+{
+    const MemPool& pool = m_mempools[poolIndex];
+    const uint64_t actualChunkSize = pool.getChunkSetting().getChunkSize();
+    const uint64_t pageSize = (m_chunkPageSize != 0U) ? m_chunkPageSize : static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    
+    uint64_t releasedBytes = 0U;
+    uint64_t runBegin = 0U;
+    uint64_t runEnd = 0U;
+    // 只释放完全落在一段地址连续的冷 chunk 内的页，相邻的已使用/热 chunk 不受影响
+    auto releaseRun = [&]() {
+        const uint64_t begin = align(runBegin, pageSize);
+        const uint64_t end = runEnd - runEnd % pageSize;
+        if (end <= begin)
+        {
+            return;
+        }
+        // 共享内存（tmpfs/hugetlbfs）上 MADV_DONTNEED/MADV_FREE 只解除本进程的映射，
+        // MADV_REMOVE 才会释放后备页
+        if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_REMOVE) == 0)
+        {
+            releasedBytes += end - begin;
+        }
+        else
+        {
+            ZEROCP_LOG(Warn, "madvise(MADV_REMOVE) on pool " << poolIndex << " failed: " << strerror(errno));
+        }
+    };
+    
+    for (const uint32_t chunkIndex : sortedChunkIndices)
+    {
+        const uint64_t address = reinterpret_cast<uint64_t>(chunkAddressOf(poolIndex, chunkIndex));
+        if (address == 0U)
+        {
+            continue;
+        }
+        if (address != runEnd)
+        {
+            releaseRun();
+            runBegin = address;
+        }
+        runEnd = address + actualChunkSize;
+    }
+    releaseRun();
+    return releasedBytes;
+}
+
+uint64_t MemPoolManager::getPoolResidentBytes(uint32_t poolIndex) const noexcept
+{
+    if (poolIndex >= m_mempools.size())
+    {
+        return 0U;
+    }
+    
+    const MemPool& pool = m_mempools[poolIndex];
+    const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    const uint64_t actualChunkSize = pool.getChunkSetting().getChunkSize();
+    const uint64_t segmentSize = actualChunkSize * pool.getSegmentChunks();
+    
+    uint64_t residentBytes = 0U;
+    std::vector<unsigned char> residency;
+    for (uint32_t segment = 0U; segment < getPoolSegmentCount(poolIndex); ++segment)
+    {
+        // 扩容段只统计本进程已经映射的
+        uint64_t segmentBase = (segment == 0U)
+            ? reinterpret_cast<uint64_t>(pool.getRawMemory())
+            : PoolRegistry::instance().baseOf(m_growthSegmentBase[poolIndex] + segment - 1U);
+        // 外部区域同样只统计本进程已经映射的
+        if (segment == 0U && pool.getSegmentId() != CHUNK_POOL_ID && PoolRegistry::instance().baseOf(pool.getSegmentId()) == 0U)
+        {
+            segmentBase = 0U;
+        }
+        if (segmentBase == 0U)
+        {
+            continue;
+        }
+        // 与相邻池共用的首尾页也计入
+        const uint64_t begin = segmentBase - segmentBase % pageSize;
+        const uint64_t end = align(segmentBase + segmentSize, pageSize);
+        residency.resize((end - begin) / pageSize);
+        if (mincore(reinterpret_cast<void*>(begin), end - begin, residency.data()) != 0)
+        {
+            continue;
+        }
+        for (const unsigned char page : residency)
+        {
+            residentBytes += (page & 1U) ? pageSize : 0U;
+        }
+    }
+    return residentBytes;
+}
+
+uint64_t MemPoolManager::getReclaimedBytes() const noexcept
+{
+    return m_reclaimedBytes.load(std::memory_order_relaxed);
+}
+
+void MemPoolManager::setFallbackPolicy(ChunkFallbackPolicy policy) noexcept
+{
+    m_fallbackPolicy.store(policy, std::memory_order_relaxed);
+}
+
+ChunkFallbackPolicy MemPoolManager::getFallbackPolicy() const noexcept
+{
+    return m_fallbackPolicy.load(std::memory_order_relaxed);
+}
+
+// ==================== 所有者账户：预留与配额 ====================
+
+void MemPoolManager::initializeOwnerAccounts() noexcept
+{
+    // 每个账户在每个池上一个预留链表，与池的空闲链表共用索引数组（chunk 同一时刻只在其中一个链表中）
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        m_defaultOwnerQuota[poolIndex] = m_config.m_memPoolEntries[poolIndex].m_ownerQuota;
+        for (uint32_t ownerSlot = 0U; ownerSlot < kMaxChunkOwners; ++ownerSlot)
+        {
+            auto* reservations = new (m_reservationLists[ownerSlot][poolIndex]) Concurrent::MPMC_LockFree_List(
+                m_mempools[poolIndex].getFreeListMemory(), m_mempools[poolIndex].getCapacity());
+            reservations->Initialize(0U);
+        }
+    }
+}
+
+void MemPoolManager::registerChunkOwner() noexcept
+{
+    const auto pid = static_cast<uint32_t>(getpid());
+    // 第一轮只找空闲槽位；第二轮回收进程已退出（kill 返回 ESRCH）但没有注销的槽位
+    for (uint32_t pass = 0U; pass < 2U; ++pass)
+    {
+        for (uint32_t ownerSlot = 0U; ownerSlot < kMaxChunkOwners; ++ownerSlot)
+        {
+            ChunkOwnerAccount& account = m_ownerAccounts[ownerSlot];
+            uint32_t previousPid = account.m_pid.load(std::memory_order_relaxed);
+            if (previousPid == kReclaimingPid
+                || (previousPid != 0U
+                    && (pass == 0U || isProcessAlive(previousPid))))
+            {
+                continue;
+            }
+            if (!account.m_pid.compare_exchange_strong(previousPid, pid, std::memory_order_acq_rel))
+            {
+                continue;
+            }
+            
+            // 新任期：上一任分配的 chunk 释放时不再记入本账户；上一任遗留的引用扣除，预留归还共享空闲链表
+            s_ownerEpoch = account.m_epoch.fetch_add(1U, std::memory_order_acq_rel) + 1U;
+            const uint64_t reclaimed = (previousPid != 0U) ? reclaimOwnerReferences(ownerSlot) : 0U;
+            const uint32_t drained = drainReservations(ownerSlot);
+            for (uint32_t poolIndex = 0U; poolIndex < ChunkOwnerAccount::kMaxPools; ++poolIndex)
+            {
+                account.m_heldChunks[poolIndex].store(0U, std::memory_order_relaxed);
+                account.m_reservedChunks[poolIndex].store(0U, std::memory_order_relaxed);
+                account.m_reservationDebt[poolIndex].store(0U, std::memory_order_relaxed);
+                account.m_quotaChunks[poolIndex].store(m_defaultOwnerQuota[poolIndex], std::memory_order_relaxed);
+            }
+            account.m_quotaRejections.store(0U, std::memory_order_relaxed);
+            s_ownerSlot = ownerSlot;
+            
+            ZEROCP_LOG(Info, "Registered chunk owner pid=" << pid << " in slot " << ownerSlot
+                       << ((previousPid != 0U) ? " (reclaimed from exited pid " : " (")
+                       << ((previousPid != 0U) ? std::to_string(previousPid) + ", " + std::to_string(reclaimed)
+                                                   + " chunk reference(s) reclaimed, " : std::string())
+                       << drained << " reserved chunk(s) returned)");
+            return;
+        }
+    }
+    s_ownerSlot = kNoChunkOwner;
+    ZEROCP_LOG(Warn, "Chunk owner table is full (" << kMaxChunkOwners << " slots), pid=" << pid
+               << " allocates without reservations or quotas");
+}
+
+void MemPoolManager::unregisterChunkOwner() noexcept
+{
+    if (s_ownerSlot == kNoChunkOwner)
+    {
+        return;
+    }
+    // 仍记在本进程账本上的引用已经泄漏（如未析构的 SharedChunk），注销前扣除，槽位交给下一任时账本干净
+    const uint64_t leaked = reclaimOwnerReferences(s_ownerSlot);
+    if (leaked > 0U)
+    {
+        ZEROCP_LOG(Warn, "Owner slot " << s_ownerSlot << " still held " << leaked
+                   << " chunk reference(s) at unregistration, reclaimed");
+    }
+    
+    // 先释放槽位：之后被释放的预留 chunk 直接回到共享空闲链表，再清空私有链表
+    ChunkOwnerAccount& account = m_ownerAccounts[s_ownerSlot];
+    account.m_pid.store(0U, std::memory_order_release);
+    const uint32_t drained = drainReservations(s_ownerSlot);
+    for (uint32_t poolIndex = 0U; poolIndex < ChunkOwnerAccount::kMaxPools; ++poolIndex)
+    {
+        account.m_reservedChunks[poolIndex].store(0U, std::memory_order_relaxed);
+    }
+    ZEROCP_LOG(Info, "Unregistered chunk owner slot " << s_ownerSlot << " (" << drained
+               << " reserved chunk(s) returned)");
+    s_ownerSlot = kNoChunkOwner;
+}
+
+uint32_t MemPoolManager::drainReservations(uint32_t ownerSlot) noexcept
+{
+    uint32_t chunkIndices[kMaxBatchSize];
+    uint32_t drained = 0U;
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        Concurrent::MPMC_LockFree_List& reservations = reservationListOf(ownerSlot, poolIndex);
+        uint32_t count = 0U;
+        while ((count = reservations.popBatch(chunkIndices, kMaxBatchSize)) > 0U)
+        {
+            m_mempools[poolIndex].freeChunks(chunkIndices, count);
+            m_mempools[poolIndex].decrementUsedCount(count);
+            notifyChunksReleased(poolIndex);
+            drained += count;
+        }
+    }
+    return drained;
+}
+
+Concurrent::MPMC_LockFree_List& MemPoolManager::reservationListOf(uint32_t ownerSlot, uint32_t poolIndex) noexcept
+{
+    return *std::launder(reinterpret_cast<Concurrent::MPMC_LockFree_List*>(m_reservationLists[ownerSlot][poolIndex]));
+}
+
+bool MemPoolManager::reserveChunks(uint64_t size, uint32_t count, uint32_t alignment) noexcept
+{
+    if (count == 0U)
+    {
+        return true;
+    }
+    if (!validateRequest(alignment))
+    {
+        return false;
+    }
+    if (s_ownerSlot == kNoChunkOwner)
+    {
+        ZEROCP_LOG(Warn, "Cannot reserve chunks: this process has no chunk owner slot");
+        return false;
+    }
+    
+    // 1. 预留放在 getChunk 第一个尝试的池：本地节点的目标尺寸级别
+    const uint32_t localNode = localNumaNode();
+    uint32_t firstPosition = 0U;
+    uint32_t lastPosition = 0U;
+    if (!findCandidatePositions(size, alignment, localNode, firstPosition, lastPosition))
+    {
+        ZEROCP_LOG(Error, "No suitable pool found for reservation of size: " << size);
+        return false;
+    }
+    const uint32_t poolIndex = m_sizeOrderedPools[localNode][firstPosition];
+    MemPool& pool = m_mempools[poolIndex];
+    ChunkOwnerAccount& account = m_ownerAccounts[s_ownerSlot];
+    
+    // 2. 配额：预留与从共享链表持有的 chunk 合计不超过配额
+    const uint32_t reserved = account.m_reservedChunks[poolIndex].fetch_add(count, std::memory_order_relaxed);
+    const uint32_t quota = account.m_quotaChunks[poolIndex].load(std::memory_order_relaxed);
+    const uint64_t charged = static_cast<uint64_t>(reserved) + count
+                           + account.m_heldChunks[poolIndex].load(std::memory_order_relaxed);
+    if (quota != 0U && charged > quota)
+    {
+        account.m_reservedChunks[poolIndex].fetch_sub(count, std::memory_order_relaxed);
+        account.m_quotaRejections.fetch_add(1U, std::memory_order_relaxed);
+        ZEROCP_LOG(Warn, "Reservation of " << count << " chunk(s) in pool " << poolIndex
+                   << " exceeds the owner quota of " << quota);
+        return false;
+    }
+    
+    // 3. 按批从共享空闲链表摘下 count 个 chunk（不经过线程弹匣）放入私有链表；
+    //    预留的 chunk 对其他进程不可用，计为已使用
+    Concurrent::MPMC_LockFree_List& reservations = reservationListOf(s_ownerSlot, poolIndex);
+    uint32_t chunkIndices[kMaxBatchSize];
+    uint32_t taken = 0U;
+    while (taken < count)
+    {
+        const uint32_t chunkCount = pool.allocateChunks(chunkIndices, std::min<uint32_t>(count - taken, kMaxBatchSize));
+        if (chunkCount == 0U)
+        {
+            break;
+        }
+        pool.incrementUsedCount(chunkCount);
+        reservations.pushBatch(chunkIndices, chunkCount);
+        taken += chunkCount;
+    }
+    
+    // 4. 不足时已经放入私有链表的部分全部放回
+    if (taken < count)
+    {
+        account.m_reservedChunks[poolIndex].fetch_sub(count, std::memory_order_relaxed);
+        returnReservedChunks(poolIndex, taken);
+        ZEROCP_LOG(Warn, "Cannot reserve " << count << " chunk(s) in pool " << poolIndex
+                   << ": only " << taken << " free");
+        return false;
+    }
+    
+    ZEROCP_LOG(Info, "Reserved " << count << " chunk(s) of size " << pool.getChunkSize()
+               << " in pool " << poolIndex << " for owner slot " << s_ownerSlot);
+    return true;
+}
+
+void MemPoolManager::cancelReservation(uint64_t size, uint32_t count, uint32_t alignment) noexcept
+{
+    const uint32_t localNode = localNumaNode();
+    uint32_t firstPosition = 0U;
+    uint32_t lastPosition = 0U;
+    if (count == 0U || s_ownerSlot == kNoChunkOwner || !validateRequest(alignment)
+        || !findCandidatePositions(size, alignment, localNode, firstPosition, lastPosition))
+    {
+        return;
+    }
+    const uint32_t poolIndex = m_sizeOrderedPools[localNode][firstPosition];
+    ChunkOwnerAccount& account = m_ownerAccounts[s_ownerSlot];
+    
+    // 1. 最多取消当前的预留数
+    uint32_t reserved = account.m_reservedChunks[poolIndex].load(std::memory_order_relaxed);
+    uint32_t cancelled = 0U;
+    do
+    {
+        cancelled = std::min(count, reserved);
+    } while (!account.m_reservedChunks[poolIndex].compare_exchange_weak(reserved, reserved - cancelled,
+                                                                         std::memory_order_relaxed));
+    
+    // 2. 私有链表中的 chunk 立即归还
+    returnReservedChunks(poolIndex, cancelled);
+}
+
+void MemPoolManager::returnReservedChunks(uint32_t poolIndex, uint32_t count) noexcept
+{
+    MemPool& pool = m_mempools[poolIndex];
+    Concurrent::MPMC_LockFree_List& reservations = reservationListOf(s_ownerSlot, poolIndex);
+    uint32_t chunkIndices[kMaxBatchSize];
+    uint32_t returned = 0U;
+    while (returned < count)
+    {
+        const uint32_t chunkCount = reservations.popBatch(chunkIndices, std::min<uint32_t>(count - returned, kMaxBatchSize));
+        if (chunkCount == 0U)
+        {
+            break;
+        }
+        pool.freeChunks(chunkIndices, chunkCount);
+        pool.decrementUsedCount(chunkCount);
+        notifyChunksReleased(poolIndex);
+        returned += chunkCount;
+    }
+    // 仍被借出的记为欠账，释放时回到共享空闲链表
+    if (returned < count)
+    {
+        m_ownerAccounts[s_ownerSlot].m_reservationDebt[poolIndex].fetch_add(count - returned, std::memory_order_relaxed);
+    }
+}
+
+bool MemPoolManager::setOwnerQuota(uint32_t ownerSlot, uint32_t poolIndex, uint32_t maxChunks) noexcept
+{
+    if (ownerSlot >= kMaxChunkOwners || poolIndex >= m_mempools.size())
+    {
+        ZEROCP_LOG(Error, "Invalid owner quota target: slot=" << ownerSlot << ", pool=" << poolIndex);
+        return false;
+    }
+    m_ownerAccounts[ownerSlot].m_quotaChunks[poolIndex].store(maxChunks, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t MemPoolManager::getOwnerSlot() noexcept
+{
+    return s_ownerSlot;
+}
+
+const ChunkOwnerAccount& MemPoolManager::getOwnerAccount(uint32_t ownerSlot) const noexcept
+{
+    return m_ownerAccounts[ownerSlot & (kMaxChunkOwners - 1U)];
+}
+
+uint32_t MemPoolManager::chargeOwner(uint32_t poolIndex, uint32_t count) noexcept
+{
+    if (s_ownerSlot == kNoChunkOwner)
+    {
+        return count;
+    }
+    ChunkOwnerAccount& account = m_ownerAccounts[s_ownerSlot];
+    const uint32_t held = account.m_heldChunks[poolIndex].fetch_add(count, std::memory_order_relaxed);
+    const uint32_t quota = account.m_quotaChunks[poolIndex].load(std::memory_order_relaxed);
+    if (quota == 0U)
+    {
+        return count;
+    }
+    
+    // 先记入再检查：并发的记入只会让彼此更保守，不会一起越过配额
+    const uint64_t charged = static_cast<uint64_t>(held) + account.m_reservedChunks[poolIndex].load(std::memory_order_relaxed);
+    const uint32_t granted = (charged >= quota) ? 0U : static_cast<uint32_t>(std::min<uint64_t>(count, quota - charged));
+    if (granted < count)
+    {
+        account.m_heldChunks[poolIndex].fetch_sub(count - granted, std::memory_order_relaxed);
+        account.m_quotaRejections.fetch_add(1U, std::memory_order_relaxed);
+    }
+    return granted;
+}
+
+void MemPoolManager::refundOwner(uint32_t poolIndex, uint32_t count) noexcept
+{
+    if (s_ownerSlot != kNoChunkOwner && count > 0U)
+    {
+        m_ownerAccounts[s_ownerSlot].m_heldChunks[poolIndex].fetch_sub(count, std::memory_order_relaxed);
+    }
+}
+
+bool MemPoolManager::acquireOwnedChunkIndex(uint32_t poolIndex, uint32_t& chunkIndex, bool& fromReservation) noexcept
+{
+    // 1. 本进程在该池有预留时先用预留（其他进程无法取走，不受共享池耗尽影响）
+    fromReservation = (s_ownerSlot != kNoChunkOwner)
+                      && m_ownerAccounts[s_ownerSlot].m_reservedChunks[poolIndex].load(std::memory_order_relaxed) != 0U
+                      && reservationListOf(s_ownerSlot, poolIndex).pop(chunkIndex);
+    if (fromReservation)
+    {
+        return true;
+    }
+    
+    // 2. 按配额从共享空闲链表获取
+    if (chargeOwner(poolIndex, 1U) == 0U)
+    {
+        return false;
+    }
+    if (acquireChunkIndex(poolIndex, chunkIndex))
+    {
+        return true;
+    }
+    refundOwner(poolIndex, 1U);
+    return false;
+}
+
+bool MemPoolManager::dischargeOwner(const ChunkManager& chunkManager) noexcept
+{
+    const uint32_t ownerSlot = chunkManager.m_ownerSlot;
+    if (ownerSlot >= kMaxChunkOwners)
+    {
+        return false;
+    }
+    
+    // 所有者已注销或槽位已被新进程登记：持有计数随账户重置，预留的 chunk 回到共享空闲链表
+    ChunkOwnerAccount& account = m_ownerAccounts[ownerSlot];
+    if (static_cast<uint16_t>(account.m_epoch.load(std::memory_order_acquire)) != chunkManager.m_ownerEpoch
+        || account.m_pid.load(std::memory_order_acquire) == 0U)
+    {
+        return false;
+    }
+    
+    const uint32_t poolIndex = chunkManager.m_mempoolIndex;
+    if (!chunkManager.m_fromReservation)
+    {
+        account.m_heldChunks[poolIndex].fetch_sub(1U, std::memory_order_relaxed);
+        return false;
+    }
+    
+    // 取消预留时仍被借出的 chunk 偿还欠账，回到共享空闲链表
+    uint32_t debt = account.m_reservationDebt[poolIndex].load(std::memory_order_relaxed);
+    while (debt > 0U)
+    {
+        if (account.m_reservationDebt[poolIndex].compare_exchange_weak(debt, debt - 1U, std::memory_order_relaxed))
+        {
+            return false;
+        }
+    }
+    reservationListOf(ownerSlot, poolIndex).push(chunkManager.m_chunkIndex);
+    // 所有者自己的线程可能正阻塞在该池上，预留的 chunk 对它可用
+    notifyChunksReleased(poolIndex);
+    return true;
+}
+
+// ==================== 引用持有账本 ====================
+
+void MemPoolManager::recordHolder(ChunkManager& chunkManager) noexcept
+{
+    if (s_ownerSlot == kNoChunkOwner)
+    {
+        return;
+    }
+    // 只有本进程写自己的列；饱和后不再记账（崩溃时少扣引用只会泄漏，不会提前释放）
+    std::atomic<uint8_t>& holderReferences = chunkManager.m_holderReferences[s_ownerSlot];
+    uint8_t count = holderReferences.load(std::memory_order_relaxed);
+    while (count != UINT8_MAX
+           && !holderReferences.compare_exchange_weak(count, static_cast<uint8_t>(count + 1U), std::memory_order_relaxed))
+    {
+    }
+}
+
+void MemPoolManager::eraseHolder(ChunkManager& chunkManager) noexcept
+{
+    if (s_ownerSlot == kNoChunkOwner)
+    {
+        return;
+    }
+    std::atomic<uint8_t>& holderReferences = chunkManager.m_holderReferences[s_ownerSlot];
+    uint8_t count = holderReferences.load(std::memory_order_relaxed);
+    while (count != 0U
+           && !holderReferences.compare_exchange_weak(count, static_cast<uint8_t>(count - 1U), std::memory_order_relaxed))
+    {
+    }
+}
+
+void MemPoolManager::retainChunk(ChunkManager* chunkManager) noexcept
+{
+    if (chunkManager == nullptr)
+    {
+        return;
+    }
+    // 先增加引用计数再记账：两步之间崩溃只会泄漏这个引用
+    chunkManager->m_refCount.fetch_add(1, std::memory_order_relaxed);
+    recordHolder(*chunkManager);
+}
+
+void MemPoolManager::adoptChunk(ChunkManager* chunkManager) noexcept
+{
+    if (chunkManager != nullptr)
+    {
+        recordHolder(*chunkManager);
+    }
+}
+
+uint64_t MemPoolManager::reclaimChunksOfProcess(uint32_t pid) noexcept
+{
+    if (pid == 0U || pid == kReclaimingPid)
+    {
+        return 0U;
+    }
+    if (isProcessAlive(pid))
+    {
+        // 仍在运行的进程可能还会访问这些 chunk，扣除它的引用会让 chunk 在使用中被复用
+        ZEROCP_LOG(Warn, "Not reclaiming chunks of pid=" << pid << ": process is still alive");
+        return 0U;
+    }
+    for (uint32_t ownerSlot = 0U; ownerSlot < kMaxChunkOwners; ++ownerSlot)
+    {
+        // 占住槽位，回收期间不会被新进程登记
+        ChunkOwnerAccount& account = m_ownerAccounts[ownerSlot];
+        uint32_t expectedPid = pid;
+        if (!account.m_pid.compare_exchange_strong(expectedPid, kReclaimingPid, std::memory_order_acq_rel))
+        {
+            continue;
+        }
+        
+        const uint64_t reclaimed = reclaimOwnerReferences(ownerSlot);
+        const uint32_t drained = drainReservations(ownerSlot);
+        for (uint32_t poolIndex = 0U; poolIndex < ChunkOwnerAccount::kMaxPools; ++poolIndex)
+        {
+            account.m_heldChunks[poolIndex].store(0U, std::memory_order_relaxed);
+            account.m_reservedChunks[poolIndex].store(0U, std::memory_order_relaxed);
+            account.m_reservationDebt[poolIndex].store(0U, std::memory_order_relaxed);
+        }
+        account.m_pid.store(0U, std::memory_order_release);
+        
+        ZEROCP_LOG(Info, "Reclaimed " << reclaimed << " chunk reference(s) and " << drained
+                   << " reserved chunk(s) of dead pid=" << pid << " (owner slot " << ownerSlot << ")");
+        return reclaimed;
+    }
+    return 0U;
+}
+
+bool MemPoolManager::isProcessAlive(uint32_t pid) noexcept
+{
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+}
+
+uint64_t MemPoolManager::reclaimOwnerReferences(uint32_t ownerSlot) noexcept
+{
+    uint64_t reclaimed = 0U;
+    auto reclaimControlBlock = [&](ChunkManager& chunkManager) {
+        std::atomic<uint8_t>& holderReferences = chunkManager.m_holderReferences[ownerSlot];
+        if (holderReferences.load(std::memory_order_relaxed) == 0U)
+        {
+            return;
+        }
+        const uint64_t held = holderReferences.exchange(0U, std::memory_order_acq_rel);
+        
+        // 账本不会多于实际引用；仍按引用计数封顶，空闲 chunk 上的残留计数不会造成重复释放
+        uint64_t refCount = chunkManager.m_refCount.load(std::memory_order_acquire);
+        uint64_t dropped = std::min(refCount, held);
+        while (dropped > 0U
+               && !chunkManager.m_refCount.compare_exchange_weak(refCount, refCount - dropped,
+                                                                std::memory_order_acq_rel))
+        {
+            dropped = std::min(refCount, held);
+        }
+        reclaimed += dropped;
+        if (dropped > 0U && refCount == dropped)
+        {
+            recycleChunk(chunkManager);
+        }
+    };
+    
+    for (uint32_t poolIndex = 0U; poolIndex < m_mempools.size(); ++poolIndex)
+    {
+        // 只有分配过的 chunk 的控制块被初始化过
+        const uint32_t touchedChunks = m_mempools[poolIndex].getTouchedChunks();
+        for (uint32_t chunkIndex = 0U; chunkIndex < touchedChunks; ++chunkIndex)
+        {
+            reclaimControlBlock(*controlBlockOf(poolIndex, chunkIndex));
+        }
+    }
+    
+    // 大块段的槽位同样只扫描用过的
+    if (m_largeChunkHeap.isInitialized())
+    {
+        ChunkManager* largeControlBlocks = static_cast<ChunkManager*>(m_chunkManagerPool[0].getRawMemory())
+                                           + m_largeChunkControlBase;
+        const uint32_t touchedSlots = largeChunkSlots().getTouchedCount();
+        for (uint32_t slot = 0U; slot < touchedSlots; ++slot)
+        {
+            reclaimControlBlock(largeControlBlocks[slot]);
+        }
+    }
+    return reclaimed;
+}
+
+// ==================== 索引获取/归还 ====================
+
+bool MemPoolManager::acquireChunkIndex(uint32_t poolIndex, uint32_t& chunkIndex) noexcept
+{
+    if (isThreadMagazinesEnabled() && poolIndex < ThreadMagazineCache::kMaxPools)
+    {
+        auto& magazine = ThreadMagazineCache::forThisThread().magazine(poolIndex, getGeneration());
+        return magazine.pop(chunkIndex) || (refillMagazine(poolIndex, magazine) && magazine.pop(chunkIndex));
+    }
+    
+    // 从目标池获取数据 chunk 索引
+    return m_mempools[poolIndex].allocateChunk(chunkIndex);
+}
+
+bool MemPoolManager::releaseChunkIndex(uint32_t poolIndex, uint32_t chunkIndex) noexcept
+{
+    if (isThreadMagazinesEnabled() && poolIndex < ThreadMagazineCache::kMaxPools)
+    {
+        auto& magazine = ThreadMagazineCache::forThisThread().magazine(poolIndex, getGeneration());
+        if (magazine.isFull())
+        {
+            flushMagazine(poolIndex, magazine, ChunkMagazine::kBatchSize);
+        }
+        const bool pushed = magazine.push(chunkIndex);
+        // 弹匣中的 chunk 只有本线程能用：该池有阻塞等待者时整个弹匣立即冲刷回空闲链表并唤醒它们。
+        // 与 notifyChunksReleased 相同，放入弹匣与读取等待者数量之间需要全屏障，否则可能读到过期的 0，
+        // chunk 留在弹匣中而等待者一直睡到超时
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_poolWaitQueues[poolIndex].m_waiterCount.load(std::memory_order_relaxed) != 0U)
+        {
+            flushMagazine(poolIndex, magazine, ChunkMagazine::kCapacity);
+        }
+        return pushed;
+    }
+    
+    // 将数据 chunk 索引归还到对应的数据池
+    if (!m_mempools[poolIndex].freeChunk(chunkIndex))
+    {
+        ZEROCP_LOG(Error, "Failed to free chunk index " << chunkIndex << " to data pool");
+        return false;
+    }
+    notifyChunksReleased(poolIndex);
+    return true;
+}
+
+bool MemPoolManager::refillMagazine(uint32_t poolIndex, ChunkMagazine& magazine) noexcept
+{
+    uint32_t chunkIndices[ChunkMagazine::kBatchSize];
+    
+    // 一次 CAS 取出一整批
+    const uint32_t chunkCount = m_mempools[poolIndex].allocateChunks(chunkIndices, ChunkMagazine::kBatchSize);
+    for (uint32_t i = 0U; i < chunkCount; ++i)
+    {
+        magazine.push(chunkIndices[i]);
+    }
+    return chunkCount > 0U;
+}
+
+void MemPoolManager::flushMagazine(uint32_t poolIndex, ChunkMagazine& magazine, uint32_t count) noexcept
+{
+    uint32_t chunkIndices[ChunkMagazine::kCapacity];
+    
+    const uint32_t taken = magazine.take(chunkIndices, (count < ChunkMagazine::kCapacity) ? count : ChunkMagazine::kCapacity);
+    if (taken == 0U || poolIndex >= m_mempools.size())
+    {
+        return;
+    }
+    m_mempools[poolIndex].freeChunks(chunkIndices, taken);
+    notifyChunksReleased(poolIndex);
+}
+
+void MemPoolManager::notifyChunksReleased(uint32_t poolIndex) noexcept
+{
+    // 与等待方的 登记 -> 读序号 -> 重试 配对：放回 chunk 与读取等待者数量之间需要全屏障
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_poolWaitQueues[poolIndex].m_waiterCount.load(std::memory_order_relaxed) == 0U)
+    {
+        return;
+    }
+    // futex 字为所有候选集合共用：只唤醒一部分时，被唤醒的可能是等待其他池的调用者，
+    // 真正能用上这些 chunk 的等待者会一直睡到超时，因此唤醒全部
+    m_releaseSequence.fetch_add(1U, std::memory_order_seq_cst);
+    syscall(SYS_futex, &m_releaseSequence, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void MemPoolManager::flushThreadMagazines() noexcept
+{
+    ThreadMagazineCache::forThisThread().flushAll(*this);
+}
+
+void MemPoolManager::setThreadMagazinesEnabled(bool enabled) noexcept
+{
+    if (!enabled && s_instance != nullptr)
+    {
+        s_instance->flushThreadMagazines();
+    }
+    s_threadMagazinesEnabled.store(enabled, std::memory_order_release);
+}
+
+bool MemPoolManager::isThreadMagazinesEnabled() noexcept
+{
+    return s_threadMagazinesEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t MemPoolManager::getGeneration() noexcept
+{
+    return s_generation.load(std::memory_order_acquire);
+}
+
+ChunkManager* MemPoolManager::getChunkManagerByIndex(uint32_t index) noexcept
+{
+    if (m_chunkManagerPool.empty() || s_managementBaseAddress == nullptr)
+    {
+        ZEROCP_LOG(Error, "ChunkManagerPool is not initialized");
+        return nullptr;
+    }
+    
+    MemPool& chunkMgrPool = m_chunkManagerPool[0];
+    if (index >= chunkMgrPool.getTotalChunks())
+    {
+        ZEROCP_LOG(Error, "ChunkManager index out of range: " << index);
+        return nullptr;
+    }
+    
+    // 控制块数组连续存放，每个控制块一个 cache line：数组起始地址 + 索引偏移
+    return static_cast<ChunkManager*>(chunkMgrPool.getRawMemory()) + index;
+}
+
+ChunkHeader* MemPoolManager::getChunkHeader(const ChunkManager* chunkManager) const noexcept
+{
+    if (chunkManager == nullptr || s_chunkBaseAddress == nullptr)
+    {
+        return nullptr;
+    }
+    
+    const uint32_t mempoolIndex = chunkManager->m_mempoolIndex;
+    if (mempoolIndex == kLargeChunkPool)
+    {
+        return static_cast<ChunkHeader*>(m_largeChunkHeap.addressOf(
+            static_cast<uint64_t>(chunkManager->m_chunkIndex) * TlsfHeap::kBlockAlignment));
+    }
+    if (mempoolIndex >= m_mempools.size())
+    {
+        ZEROCP_LOG(Error, "Invalid pool index in ChunkManager: " << mempoolIndex);
+        return nullptr;
+    }
+    
+    // 与 getChunk 相同的地址计算：段起始地址 + 段内索引偏移
+    return static_cast<ChunkHeader*>(chunkAddressOf(mempoolIndex, chunkManager->m_chunkIndex));
+}
+
+void MemPoolManager::printAllPoolStats() const noexcept
+{
+    std::cout << "==================== MemPoolManager Stats ====================" << std::endl;
+    
+    // 安全检查：先检查 m_config 是否有效
+    try {
+        std::cout << "Data Pools: " << m_mempools.size() << std::endl;
+        
+        if (!m_mempools.empty())
+        {
+            for (size_t i = 0; i < m_mempools.size(); ++i)
+            {
+                const MemPool& pool = m_mempools[i];
+                std::cout << "  Pool[" << i << "]: "
+                          << "ChunkSize=" << pool.getChunkSize() << " bytes, "
+                          << "Total=" << pool.getTotalChunks() << ", "
+                          << "Capacity=" << pool.getCapacity() << ", "
+                          << "Segments=" << getPoolSegmentCount(static_cast<uint32_t>(i)) << ", "
+                          << "Used=" << pool.getUsedChunks() << ", "
+                          << "Free=" << pool.getFreeChunks() << ", "
+                          << "Resident=" << (getPoolResidentBytes(static_cast<uint32_t>(i)) >> 10) << " KiB, "
+                          << "Node=" << static_cast<uint32_t>(m_poolNumaNode[i]) << std::endl;
+                const PoolTelemetry::Snapshot telemetry = pool.getTelemetry().snapshot();
+                std::cout << "           HighWater=" << pool.getHighWaterMark() << ", "
+                          << "Allocations=" << telemetry.m_allocations << ", "
+                          << "Frees=" << telemetry.m_frees << ", "
+                          << "Failures=" << telemetry.m_failedAllocations << ", "
+                          << "CasRetries=" << telemetry.m_casRetries << std::endl;
+            }
+        }
+        else
+        {
+            std::cout << "  (No data pools initialized)" << std::endl;
+        }
+
+        if (!m_chunkManagerPool.empty())
+        {
+            // 控制块与数据 chunk 一一对应，已使用数即所有数据池已使用数之和
+            const MemPool& mgmtPool = m_chunkManagerPool[0];
+            uint32_t usedControlBlocks = 0U;
+            for (size_t i = 0; i < m_mempools.size(); ++i)
+            {
+                usedControlBlocks += m_mempools[i].getUsedChunks();
+            }
+            usedControlBlocks += m_largeChunkHeap.getAllocatedBlocks();
+            std::cout << "ChunkManager Pool: "
+                      << "Total=" << mgmtPool.getTotalChunks() << ", "
+                      << "Used=" << usedControlBlocks << ", "
+                      << "Free=" << (mgmtPool.getTotalChunks() - usedControlBlocks) << std::endl;
+        }
+        else
+        {
+            std::cout << "ChunkManager Pool: (Not initialized)" << std::endl;
+        }
+        
+        static constexpr const char* kHugePageModeNames[] = {"NONE", "TRANSPARENT", "EXPLICIT_2M", "EXPLICIT_1G"};
+        std::cout << "Chunk Segment: Pages=" << kHugePageModeNames[static_cast<uint8_t>(m_chunkHugePageMode)]
+                  << ", PageSize=" << m_chunkPageSize << " bytes" << std::endl;
+        if (m_largeChunkHeap.isInitialized())
+        {
+            std::cout << "Large Chunk Segment: Arena=" << (m_largeChunkHeap.getArenaSize() >> 10) << " KiB, "
+                      << "Used=" << (m_largeChunkHeap.getUsedBytes() >> 10) << " KiB, "
+                      << "Chunks=" << m_largeChunkHeap.getAllocatedBlocks() << ", "
+                      << "Failures=" << m_largeChunkHeap.getFailedAllocations() << std::endl;
+        }
+        std::cout << "Reclaimed: " << (m_reclaimedBytes.load(std::memory_order_relaxed) >> 10) << " KiB" << std::endl;
+        std::cout << "NUMA: Nodes=" << static_cast<uint32_t>(m_numaNodeCount)
+                  << ", RemoteAllocations=" << m_numaRemoteAllocations.load(std::memory_order_relaxed) << std::endl;
+        
+        // 已登记的所有者：每个池的 持有/预留/配额，只列出有用量或配额的池
+        for (uint32_t ownerSlot = 0U; ownerSlot < kMaxChunkOwners; ++ownerSlot)
+        {
+            const ChunkOwnerAccount& account = m_ownerAccounts[ownerSlot];
+            const uint32_t pid = account.m_pid.load(std::memory_order_relaxed);
+            if (pid == 0U)
+            {
+                continue;
+            }
+            std::cout << "Owner[" << ownerSlot << "] pid=" << pid
+                      << " QuotaRejections=" << account.m_quotaRejections.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < m_mempools.size(); ++i)
+            {
+                const uint32_t held = account.m_heldChunks[i].load(std::memory_order_relaxed);
+                const uint32_t reserved = account.m_reservedChunks[i].load(std::memory_order_relaxed);
+                const uint32_t quota = account.m_quotaChunks[i].load(std::memory_order_relaxed);
+                if (held != 0U || reserved != 0U || quota != 0U)
+                {
+                    std::cout << " | Pool[" << i << "] Held=" << held << ", Reserved=" << reserved
+                              << ", Quota=" << quota;
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+    catch (...)
+    {
+        std::cout << "ERROR: Exception occurred while printing stats" << std::endl;
+    }
+    
+    std::cout << "===============================================================" << std::endl;
+}
+
+HugePageMode MemPoolManager::getChunkHugePageMode() const noexcept
+{
+    return m_chunkHugePageMode;
+}
+
+uint64_t MemPoolManager::getChunkPageSize() const noexcept
+{
+    return m_chunkPageSize;
+}
 
 vector<MemPool, 16>& MemPoolManager::getMemPools() noexcept
 {
     return m_mempools;
 }
 
+const vector<MemPool, 16>& MemPoolManager::getMemPools() const noexcept
+{
+    return m_mempools;
+}
+
 vector<MemPool, 1>& MemPoolManager::getChunkManagerPool() noexcept
 {
     return m_chunkManagerPool;
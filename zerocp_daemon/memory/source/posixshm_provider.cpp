@@ -7,8 +7,8 @@ namespace ZeroCP
 namespace Memory
 {
 
-// 生成唯一的池ID
-static std::atomic<uint64_t> g_nextPoolId{1};
+// 生成唯一的池ID（进程本地，从固定ID区间之后开始；需要跨进程一致时用 setPoolId 指定固定ID）
+static std::atomic<uint64_t> g_nextPoolId{PoolRegistry::FIRST_DYNAMIC_POOL_ID};
 
 PosixShmProvider::PosixShmProvider(const Name_t& name, const uint64_t memorySize, const AccessMode accessMode, const OpenMode openMode, const Perms permissions) noexcept
     : m_name(name), m_memorySize(memorySize), m_accessMode(accessMode), m_openMode(openMode), m_permissions(permissions)
@@ -21,25 +21,79 @@ PosixShmProvider::~PosixShmProvider()
     destroyMemory();
 }
 
-std::expected<void*, PosixSharedMemoryObjectError> PosixShmProvider::createMemory() noexcept
+void PosixShmProvider::setPoolId(pool_id_t poolId) noexcept
+{
+    m_poolId = poolId;
+}
+
+void PosixShmProvider::setHugePageMode(HugePageMode mode) noexcept
+{
+    m_hugePageMode = mode;
+}
+
+const char* PosixShmProvider::hugetlbfsMountPoint(HugePageMode mode) noexcept
 {
-    // 直接创建共享内存对象
-    auto result = Details::PosixSharedMemoryObjectBuilder()
+    switch (mode)
+    {
+    case HugePageMode::EXPLICIT_2M:
+        return "/dev/hugepages";
+    case HugePageMode::EXPLICIT_1G:
+        return "/dev/hugepages1G";
+    default:
+        return "";
+    }
+}
+
+std::expected<PosixSharedMemoryObject, PosixSharedMemoryObjectError>
+PosixShmProvider::createSharedMemoryObject(const char* hugetlbfsDirectory, bool transparentHugePages) noexcept
+{
+    return Details::PosixSharedMemoryObjectBuilder()
         .name(m_name)
         .memorySize(m_memorySize)
         .accessMode(m_accessMode)
         .openMode(m_openMode)
         .permissions(m_permissions)
+        .hugetlbfsDirectory(hugetlbfsDirectory)
+        .transparentHugePages(transparentHugePages)
         .create();
-   
-    if(!result.has_value())
+}
+
+std::expected<void*, PosixSharedMemoryObjectError> PosixShmProvider::createMemory() noexcept
+{
+    // 1. 显式大页：hugetlbfs 未挂载或大页不足时回退到透明大页
+    if (m_hugePageMode == HugePageMode::EXPLICIT_2M || m_hugePageMode == HugePageMode::EXPLICIT_1G)
     {
-        ZEROCP_LOG(Error, "Failed to create shared memory object");
-        return std::unexpected(result.error());
+        const uint64_t expectedPageSize = (m_hugePageMode == HugePageMode::EXPLICIT_2M) ? (2ULL << 20) : (1ULL << 30);
+        auto result = createSharedMemoryObject(hugetlbfsMountPoint(m_hugePageMode), false);
+        if (result.has_value() && result->getPageSize() == expectedPageSize)
+        {
+            m_sharedMemoryObject = std::move(result.value());
+        }
+        else
+        {
+            ZEROCP_LOG(Warn, "Explicit huge pages (" << (expectedPageSize >> 20) << " MiB) unavailable at "
+                       << hugetlbfsMountPoint(m_hugePageMode) << ", falling back to transparent huge pages");
+            m_hugePageMode = HugePageMode::TRANSPARENT;
+        }
     }
     
-    // 移动共享内存对象
-    m_sharedMemoryObject = std::move(result.value());
+    // 2. POSIX 共享内存（TRANSPARENT 模式额外请求透明大页）
+    if (!m_sharedMemoryObject.has_value())
+    {
+        auto result = createSharedMemoryObject("", m_hugePageMode == HugePageMode::TRANSPARENT);
+        if(!result.has_value())
+        {
+            ZEROCP_LOG(Error, "Failed to create shared memory object");
+            return std::unexpected(result.error());
+        }
+        
+        // 移动共享内存对象
+        m_sharedMemoryObject = std::move(result.value());
+        if (m_hugePageMode == HugePageMode::TRANSPARENT && !m_sharedMemoryObject->isTransparentHugePagesAdvised())
+        {
+            m_hugePageMode = HugePageMode::NONE;
+        }
+    }
     
     // 获取基地址
     m_baseAddress = m_sharedMemoryObject->getBaseAddress();
@@ -50,10 +104,13 @@ std::expected<void*, PosixSharedMemoryObjectError> PosixShmProvider::createMemor
     }
     
     // 注册到全局池注册表，用于 RelativePointer
-    // TODO: 需要实现 PoolRegistry 类
-    // PoolRegistry::instance().registerPool(m_poolId, m_baseAddress);
+    if (!PoolRegistry::instance().registerPool(m_poolId, m_baseAddress))
+    {
+        ZEROCP_LOG(Warn, "Pool ID " << m_poolId << " not registered, RelativePointer into this segment is unavailable");
+    }
     
-    ZEROCP_LOG(Info, "Shared memory created - Pool ID: " << m_poolId << ", Base Address: " << m_baseAddress);
+    ZEROCP_LOG(Info, "Shared memory created - Pool ID: " << m_poolId << ", Base Address: " << m_baseAddress
+               << ", Page Size: " << getPageSize() << (m_hugePageMode == HugePageMode::TRANSPARENT ? " (THP advised)" : ""));
     
     return m_baseAddress;
 }
@@ -62,9 +119,8 @@ std::expected<void, PosixSharedMemoryObjectError> PosixShmProvider::destroyMemor
 {
     if(m_sharedMemoryObject.has_value())
     {
-        // 取消注册池
-        // TODO: 需要实现 PoolRegistry 类
-        // PoolRegistry::instance().unregisterPool(m_poolId);
+        // 取消注册池（同一ID已被本进程的另一个映射覆盖时保留新映射）
+        PoolRegistry::instance().unregisterPool(m_poolId, m_baseAddress);
         ZEROCP_LOG(Info, "Unregistered pool ID: " << m_poolId);
         
         // 重置共享内存对象
@@ -90,6 +146,16 @@ void* PosixShmProvider::getBaseAddress() const noexcept
     return m_baseAddress;
 }
 
+HugePageMode PosixShmProvider::getHugePageMode() const noexcept
+{
+    return m_hugePageMode;
+}
+
+uint64_t PosixShmProvider::getPageSize() const noexcept
+{
+    return m_sharedMemoryObject.has_value() ? m_sharedMemoryObject->getPageSize() : 0U;
+}
+
 void PosixShmProvider::announceMemoryAvailable() noexcept
 {
     m_memoryAvailableAnnounced = true;
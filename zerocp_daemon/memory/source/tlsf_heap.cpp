@@ -0,0 +1,420 @@
+#include "tlsf_heap.hpp"
+#include "logging.hpp"
+#include <bit>
+#include <cerrno>
+#include <cstring>
+
+namespace ZeroCP
+{
+namespace Memory
+{
+
+TlsfHeap::~TlsfHeap() noexcept
+{
+    if (isInitialized())
+    {
+        pthread_mutex_destroy(&m_mutex);
+    }
+}
+
+bool TlsfHeap::initialize(void* arena, pool_id_t segmentId, uint64_t arenaSize) noexcept
+{
+    arenaSize &= ~(kBlockAlignment - 1U);
+    if (arena == nullptr || (reinterpret_cast<std::uintptr_t>(arena) & (kBlockAlignment - 1U)) != 0U
+        || arenaSize < kMinBlockSize || arenaSize > kMaxArenaSize)
+    {
+        ZEROCP_LOG(Error, "Invalid TLSF arena: address=" << arena << ", size=" << arenaSize);
+        return false;
+    }
+
+    // 健壮锁：持锁进程崩溃后下一个加锁者得到 EOWNERDEAD 而不是永远阻塞
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    const int result = pthread_mutex_init(&m_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    if (result != 0)
+    {
+        ZEROCP_LOG(Error, "Failed to initialize TLSF heap mutex: " << strerror(result));
+        return false;
+    }
+
+    m_arena = RelativePointer<void>(arena, segmentId);
+    m_firstLevelBitmap = 0U;
+    for (uint32_t firstLevel = 0U; firstLevel < kFirstLevelCount; ++firstLevel)
+    {
+        m_secondLevelBitmaps[firstLevel] = 0U;
+        for (uint64_t& head : m_freeLists[firstLevel])
+        {
+            head = kNullOffset;
+        }
+    }
+    m_arenaSize = arenaSize;
+
+    // 整个区域是一个空闲块
+    BlockHeader* block = blockAt(0U);
+    block->m_previousPhysical = kNullOffset;
+    block->m_sizeAndFlags = arenaSize | kFreeFlag;
+    insertFreeBlock(0U);
+
+    ZEROCP_LOG(Info, "TLSF heap initialized: " << arenaSize << " bytes, " << kFirstLevelCount << "x"
+               << kSecondLevelCount << " free lists");
+    return true;
+}
+
+// ==================== 分配/释放 ====================
+
+bool TlsfHeap::allocate(uint64_t size, uint64_t& offset) noexcept
+{
+    if (!isInitialized() || size > m_arenaSize)
+    {
+        m_failedAllocations.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+    uint64_t blockSize = (size + kBlockHeaderSize + kBlockAlignment - 1U) & ~(kBlockAlignment - 1U);
+    blockSize = (blockSize < kMinBlockSize) ? kMinBlockSize : blockSize;
+
+    uint32_t firstLevel = 0U;
+    uint32_t secondLevel = 0U;
+    if (!mappingSearch(blockSize, firstLevel, secondLevel))
+    {
+        m_failedAllocations.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (!lock())
+    {
+        m_failedAllocations.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+    if (!findFreeList(firstLevel, secondLevel))
+    {
+        unlock();
+        m_failedAllocations.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 1. 取链表头：按子级上取整查找，链表中的块一定放得下
+    const uint64_t blockOffset = m_freeLists[firstLevel][secondLevel];
+    removeFreeBlock(blockOffset);
+    BlockHeader* block = blockAt(blockOffset);
+    const uint64_t freeSize = sizeOf(block);
+
+    // 2. 剩余部分足够成为一个块时切下来放回空闲链表
+    if (freeSize - blockSize >= kMinBlockSize)
+    {
+        const uint64_t remainderOffset = blockOffset + blockSize;
+        BlockHeader* remainder = blockAt(remainderOffset);
+        remainder->m_previousPhysical = blockOffset;
+        remainder->m_sizeAndFlags = (freeSize - blockSize) | kFreeFlag;
+        linkNextPhysical(remainderOffset);
+        insertFreeBlock(remainderOffset);
+    }
+    else
+    {
+        blockSize = freeSize;
+    }
+    block->m_sizeAndFlags = blockSize;
+    // 计数在锁内更新：持锁者死亡后重建出的计数与其他进程的后续更新不会重复
+    m_usedBytes.fetch_add(blockSize, std::memory_order_relaxed);
+    m_allocatedBlocks.fetch_add(1U, std::memory_order_relaxed);
+    unlock();
+
+    offset = blockOffset + kBlockHeaderSize;
+    return true;
+}
+
+bool TlsfHeap::free(uint64_t offset) noexcept
+{
+    if (!isInitialized() || offset < kBlockHeaderSize || offset >= m_arenaSize
+        || (offset & (kBlockAlignment - 1U)) != 0U)
+    {
+        ZEROCP_LOG(Error, "Invalid TLSF offset: " << offset);
+        return false;
+    }
+
+    uint64_t blockOffset = offset - kBlockHeaderSize;
+    if (!lock())
+    {
+        ZEROCP_LOG(Error, "Cannot free TLSF block at offset " << blockOffset << ": heap lock unavailable");
+        return false;
+    }
+    BlockHeader* block = blockAt(blockOffset);
+    if (isFree(block))
+    {
+        unlock();
+        ZEROCP_LOG(Error, "Double free of TLSF block at offset " << blockOffset);
+        return false;
+    }
+    const uint64_t blockSize = sizeOf(block);
+    uint64_t mergedSize = blockSize;
+
+    // 1. 与后一个物理块合并
+    const uint64_t nextOffset = blockOffset + blockSize;
+    if (nextOffset < m_arenaSize && isFree(blockAt(nextOffset)))
+    {
+        removeFreeBlock(nextOffset);
+        mergedSize += sizeOf(blockAt(nextOffset));
+    }
+
+    // 2. 与前一个物理块合并：合并后的块从前一个块开始
+    const uint64_t previousOffset = block->m_previousPhysical;
+    if (previousOffset != kNullOffset && isFree(blockAt(previousOffset)))
+    {
+        removeFreeBlock(previousOffset);
+        mergedSize += sizeOf(blockAt(previousOffset));
+        blockOffset = previousOffset;
+        block = blockAt(blockOffset);
+    }
+
+    block->m_sizeAndFlags = mergedSize | kFreeFlag;
+    linkNextPhysical(blockOffset);
+    insertFreeBlock(blockOffset);
+    m_usedBytes.fetch_sub(blockSize, std::memory_order_relaxed);
+    m_allocatedBlocks.fetch_sub(1U, std::memory_order_relaxed);
+    unlock();
+    return true;
+}
+
+uint64_t TlsfHeap::usableSizeOf(uint64_t offset) const noexcept
+{
+    if (!isInitialized() || offset < kBlockHeaderSize || offset >= m_arenaSize)
+    {
+        return 0U;
+    }
+    // 已分配块的大小只在分配时写入，读取不需要加锁
+    return sizeOf(blockAt(offset - kBlockHeaderSize)) - kBlockHeaderSize;
+}
+
+uint64_t TlsfHeap::getLargestFreeBlock() noexcept
+{
+    if (!isInitialized() || !lock())
+    {
+        return 0U;
+    }
+    uint64_t largest = 0U;
+    if (m_firstLevelBitmap != 0U)
+    {
+        // 最高的非空链表中的块最大，但链表内部不按大小排序
+        const uint32_t firstLevel = static_cast<uint32_t>(std::bit_width(m_firstLevelBitmap)) - 1U;
+        const uint32_t secondLevel = static_cast<uint32_t>(std::bit_width(m_secondLevelBitmaps[firstLevel])) - 1U;
+        for (uint64_t blockOffset = m_freeLists[firstLevel][secondLevel]; blockOffset != kNullOffset;
+             blockOffset = blockAt(blockOffset)->m_nextFree)
+        {
+            const uint64_t size = sizeOf(blockAt(blockOffset));
+            largest = (size > largest) ? size : largest;
+        }
+    }
+    unlock();
+    return (largest > kBlockHeaderSize) ? largest - kBlockHeaderSize : 0U;
+}
+
+// ==================== 两级索引 ====================
+
+void TlsfHeap::mapping(uint64_t blockSize, uint32_t& firstLevel, uint32_t& secondLevel) noexcept
+{
+    if (blockSize < (uint64_t{1} << kFirstLevelShift))
+    {
+        // 小块：一级 0 按粒度线性划分
+        firstLevel = 0U;
+        secondLevel = static_cast<uint32_t>(blockSize / ((uint64_t{1} << kFirstLevelShift) / kSecondLevelCount));
+        return;
+    }
+    const uint32_t log2Size = static_cast<uint32_t>(std::bit_width(blockSize)) - 1U;
+    secondLevel = static_cast<uint32_t>(blockSize >> (log2Size - kSecondLevelLog2)) ^ kSecondLevelCount;
+    firstLevel = log2Size - (kFirstLevelShift - 1U);
+}
+
+bool TlsfHeap::mappingSearch(uint64_t blockSize, uint32_t& firstLevel, uint32_t& secondLevel) noexcept
+{
+    if (blockSize >= (uint64_t{1} << kFirstLevelShift))
+    {
+        const uint32_t log2Size = static_cast<uint32_t>(std::bit_width(blockSize)) - 1U;
+        blockSize += (uint64_t{1} << (log2Size - kSecondLevelLog2)) - 1U;
+    }
+    mapping(blockSize, firstLevel, secondLevel);
+    return firstLevel < kFirstLevelCount;
+}
+
+bool TlsfHeap::findFreeList(uint32_t& firstLevel, uint32_t& secondLevel) const noexcept
+{
+    // 同一级中不小于 secondLevel 的子级，否则取更高一级中最小的非空子级
+    uint32_t secondLevelMap = m_secondLevelBitmaps[firstLevel] & (~0U << secondLevel);
+    if (secondLevelMap == 0U)
+    {
+        const uint32_t firstLevelMap = m_firstLevelBitmap & (~0U << (firstLevel + 1U));
+        if (firstLevelMap == 0U)
+        {
+            return false;
+        }
+        firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+        secondLevelMap = m_secondLevelBitmaps[firstLevel];
+    }
+    secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMap));
+    return true;
+}
+
+void TlsfHeap::insertFreeBlock(uint64_t blockOffset) noexcept
+{
+    BlockHeader* block = blockAt(blockOffset);
+    uint32_t firstLevel = 0U;
+    uint32_t secondLevel = 0U;
+    mapping(sizeOf(block), firstLevel, secondLevel);
+
+    const uint64_t head = m_freeLists[firstLevel][secondLevel];
+    block->m_nextFree = head;
+    block->m_previousFree = kNullOffset;
+    if (head != kNullOffset)
+    {
+        blockAt(head)->m_previousFree = blockOffset;
+    }
+    m_freeLists[firstLevel][secondLevel] = blockOffset;
+    m_firstLevelBitmap |= 1U << firstLevel;
+    m_secondLevelBitmaps[firstLevel] |= 1U << secondLevel;
+}
+
+void TlsfHeap::removeFreeBlock(uint64_t blockOffset) noexcept
+{
+    BlockHeader* block = blockAt(blockOffset);
+    uint32_t firstLevel = 0U;
+    uint32_t secondLevel = 0U;
+    mapping(sizeOf(block), firstLevel, secondLevel);
+
+    if (block->m_nextFree != kNullOffset)
+    {
+        blockAt(block->m_nextFree)->m_previousFree = block->m_previousFree;
+    }
+    if (block->m_previousFree != kNullOffset)
+    {
+        blockAt(block->m_previousFree)->m_nextFree = block->m_nextFree;
+        return;
+    }
+
+    // 块是链表头：链表变空时清除位图
+    m_freeLists[firstLevel][secondLevel] = block->m_nextFree;
+    if (block->m_nextFree == kNullOffset)
+    {
+        m_secondLevelBitmaps[firstLevel] &= ~(1U << secondLevel);
+        if (m_secondLevelBitmaps[firstLevel] == 0U)
+        {
+            m_firstLevelBitmap &= ~(1U << firstLevel);
+        }
+    }
+}
+
+void TlsfHeap::linkNextPhysical(uint64_t blockOffset) noexcept
+{
+    const uint64_t nextOffset = blockOffset + sizeOf(blockAt(blockOffset));
+    if (nextOffset < m_arenaSize)
+    {
+        blockAt(nextOffset)->m_previousPhysical = blockOffset;
+    }
+}
+
+TlsfHeap::BlockHeader* TlsfHeap::blockAt(uint64_t blockOffset) const noexcept
+{
+    return static_cast<BlockHeader*>(addressOf(blockOffset));
+}
+
+// ==================== 锁 ====================
+
+bool TlsfHeap::rebuildFreeLists() noexcept
+{
+    // 1. 先完整校验物理块链，校验失败时不修改任何内容
+    for (uint64_t blockOffset = 0U; blockOffset < m_arenaSize; blockOffset += sizeOf(blockAt(blockOffset)))
+    {
+        const uint64_t blockSize = sizeOf(blockAt(blockOffset));
+        if (blockSize < kMinBlockSize || (blockSize & (kBlockAlignment - 1U)) != 0U
+            || blockSize > m_arenaSize - blockOffset)
+        {
+            ZEROCP_LOG(Error, "TLSF block at offset " << blockOffset << " has invalid size " << blockSize);
+            return false;
+        }
+    }
+
+    // 2. 清空索引，按物理顺序重新插入空闲块（相邻空闲块先合并）
+    m_firstLevelBitmap = 0U;
+    for (uint32_t firstLevel = 0U; firstLevel < kFirstLevelCount; ++firstLevel)
+    {
+        m_secondLevelBitmaps[firstLevel] = 0U;
+        for (uint64_t& head : m_freeLists[firstLevel])
+        {
+            head = kNullOffset;
+        }
+    }
+    uint64_t usedBytes = 0U;
+    uint32_t allocatedBlocks = 0U;
+    uint64_t previousOffset = kNullOffset;
+    uint64_t blockOffset = 0U;
+    while (blockOffset < m_arenaSize)
+    {
+        BlockHeader* block = blockAt(blockOffset);
+        uint64_t blockSize = sizeOf(block);
+        if (isFree(block))
+        {
+            while (blockOffset + blockSize < m_arenaSize && isFree(blockAt(blockOffset + blockSize)))
+            {
+                blockSize += sizeOf(blockAt(blockOffset + blockSize));
+            }
+            block->m_sizeAndFlags = blockSize | kFreeFlag;
+        }
+        else
+        {
+            usedBytes += blockSize;
+            ++allocatedBlocks;
+        }
+        block->m_previousPhysical = previousOffset;
+        if (isFree(block))
+        {
+            insertFreeBlock(blockOffset);
+        }
+        previousOffset = blockOffset;
+        blockOffset += blockSize;
+    }
+    m_usedBytes.store(usedBytes, std::memory_order_relaxed);
+    m_allocatedBlocks.store(allocatedBlocks, std::memory_order_relaxed);
+    return true;
+}
+
+bool TlsfHeap::lock() noexcept
+{
+    const int result = pthread_mutex_lock(&m_mutex);
+    if (result == 0)
+    {
+        return true;
+    }
+    if (result == EOWNERDEAD)
+    {
+        // 死亡的持锁者可能停在拆分/合并中途：重建成功后才把锁标记为一致
+        ZEROCP_LOG(Warn, "Previous TLSF heap lock holder died, rebuilding free lists");
+        if (rebuildFreeLists() && pthread_mutex_consistent(&m_mutex) == 0)
+        {
+            m_lockRecoveries.fetch_add(1U, std::memory_order_relaxed);
+            ZEROCP_LOG(Warn, "TLSF heap recovered: " << m_allocatedBlocks.load(std::memory_order_relaxed)
+                       << " block(s) allocated, " << m_usedBytes.load(std::memory_order_relaxed) << " bytes used");
+            return true;
+        }
+        // 不调用 pthread_mutex_consistent 直接解锁：锁变为 ENOTRECOVERABLE，之后所有加锁都失败
+        m_corrupted.store(true, std::memory_order_release);
+        pthread_mutex_unlock(&m_mutex);
+        ZEROCP_LOG(Error, "TLSF heap is corrupted, large chunk allocation disabled");
+        return false;
+    }
+    if (result == ENOTRECOVERABLE)
+    {
+        m_corrupted.store(true, std::memory_order_release);
+        ZEROCP_LOG(Debug, "TLSF heap lock is not recoverable");
+        return false;
+    }
+    ZEROCP_LOG(Error, "Failed to lock TLSF heap: " << strerror(result));
+    return false;
+}
+
+void TlsfHeap::unlock() noexcept
+{
+    pthread_mutex_unlock(&m_mutex);
+}
+
+} // namespace Memory
+} // namespace ZeroCP
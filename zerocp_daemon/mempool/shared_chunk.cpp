@@ -1,7 +1,7 @@
 #include "shared_chunk.hpp"
 #include "zerocp_daemon/memory/include/mempool_manager.hpp"
 #include "zerocp_daemon/memory/include/chunk_header.hpp"
-#include "zerocp_log/zerocp_log.hpp"
+#include "zerocp_foundationLib/report/include/logging.hpp"
 
 namespace ZeroCP
 {
@@ -95,15 +95,20 @@ uint64_t SharedChunk::useCount() const noexcept
     return m_chunkManager->m_refCount.load(std::memory_order_acquire);
 }
 
-void* SharedChunk::getData() const noexcept
+ChunkHeader* SharedChunk::getChunkheader() const noexcept
 {
-    if (m_chunkManager == nullptr)
+    if (m_chunkManager == nullptr || m_memPoolManager == nullptr)
     {
         return nullptr;
     }
     
-    // 通过 RelativePointer 获取 ChunkHeader
-    ChunkHeader* header = m_chunkManager->m_chunkHeader.get();
+    // 按池索引和 chunk 索引计算地址，不依赖创建进程的映射地址
+    return m_memPoolManager->getChunkHeader(m_chunkManager);
+}
+
+void* SharedChunk::getUserPayload() const noexcept
+{
+    ChunkHeader* header = getChunkheader();
     if (header == nullptr)
     {
         return nullptr;
@@ -114,15 +119,21 @@ void* SharedChunk::getData() const noexcept
     return headerAddr + header->m_userPayloadOffset;
 }
 
-uint64_t SharedChunk::getSize() const noexcept
+void* SharedChunk::getUserHeader() const noexcept
 {
-    if (m_chunkManager == nullptr)
+    ChunkHeader* header = getChunkheader();
+    if (header == nullptr || header->m_userHeaderSize == 0U)
     {
-        return 0;
+        return nullptr;
     }
     
-    // 通过 RelativePointer 获取 ChunkHeader
-    ChunkHeader* header = m_chunkManager->m_chunkHeader.get();
+    // 用户头位于 ChunkHeader 与用户数据之间，偏移由池的布局决定
+    return reinterpret_cast<char*>(header) + header->m_userHeaderOffset;
+}
+
+uint64_t SharedChunk::getSize() const noexcept
+{
+    ChunkHeader* header = getChunkheader();
     if (header == nullptr)
     {
         return 0;
@@ -132,6 +143,42 @@ uint64_t SharedChunk::getSize() const noexcept
     return header->m_userPayloadSize;
 }
 
+bool SharedChunk::isChained() const noexcept
+{
+    return m_chunkManager != nullptr && m_chunkManager->m_nextChunkIndex != ChunkManager::kNoNextChunk;
+}
+
+uint32_t SharedChunk::getSegments(std::span<iovec> segments) const noexcept
+{
+    if (m_chunkManager == nullptr || m_memPoolManager == nullptr)
+    {
+        return 0U;
+    }
+    return m_memPoolManager->getChunkSegments(m_chunkManager, segments);
+}
+
+uint64_t SharedChunk::getTotalSize() const noexcept
+{
+    if (m_chunkManager == nullptr || m_memPoolManager == nullptr)
+    {
+        return 0;
+    }
+    
+    // 沿链累加各段的用户数据大小（持有链头引用期间链不会被修改）
+    uint64_t totalSize = 0U;
+    for (const ChunkManager* segment = m_chunkManager; segment != nullptr;
+         segment = m_memPoolManager->getNextChunk(segment))
+    {
+        ChunkHeader* header = m_memPoolManager->getChunkHeader(segment);
+        if (header == nullptr)
+        {
+            break;
+        }
+        totalSize += header->m_userPayloadSize;
+    }
+    return totalSize;
+}
+
 uint32_t SharedChunk::getChunkManagerIndex() const noexcept
 {
     if (m_chunkManager == nullptr)
@@ -161,6 +208,17 @@ uint32_t SharedChunk::prepareForTransfer() noexcept
     return m_chunkManager->m_chunkManagerIndex;
 }
 
+void SharedChunk::cancelTransfer() noexcept
+{
+    if (m_chunkManager == nullptr)
+    {
+        return;
+    }
+    
+    // 归还 prepareForTransfer() 预先增加的引用
+    m_chunkManager->m_refCount.fetch_sub(1, std::memory_order_acq_rel);
+}
+
 SharedChunk SharedChunk::fromIndex(uint32_t index, MemPoolManager* memPoolManager) noexcept
 {
     if (memPoolManager == nullptr)
@@ -180,7 +238,9 @@ SharedChunk SharedChunk::fromIndex(uint32_t index, MemPoolManager* memPoolManage
     ZEROCP_LOG(Debug, "SharedChunk::fromIndex() - Reconstructed ChunkManager[" << index 
                << "] with refCount=" << chunkManager->m_refCount.load(std::memory_order_acquire));
     
-    // 创建 SharedChunk（不增加引用计数，因为发送端已经增加过了）
+    // 创建 SharedChunk（不增加引用计数，因为发送端已经增加过了）；
+    // 在途引用从此记在本进程的账本上，本进程崩溃时由守护进程回收
+    memPoolManager->adoptChunk(chunkManager);
     return SharedChunk(chunkManager, memPoolManager);
 }
 
@@ -205,14 +265,14 @@ void SharedChunk::reset(ChunkManager* chunkManager, MemPoolManager* memPoolManag
 
 void SharedChunk::addRef() noexcept
 {
-    if (m_chunkManager != nullptr)
+    if (m_chunkManager != nullptr && m_memPoolManager != nullptr)
     {
-        // 原子性地增加引用计数
-        uint64_t oldCount = m_chunkManager->m_refCount.fetch_add(1, std::memory_order_acq_rel);
+        // 增加引用计数并记在本进程的账本上
+        m_memPoolManager->retainChunk(m_chunkManager);
         
         ZEROCP_LOG(Debug, "SharedChunk::addRef() - ChunkManager[" 
                    << m_chunkManager->m_chunkManagerIndex 
-                   << "] refCount: " << oldCount << " -> " << (oldCount + 1));
+                   << "] refCount -> " << m_chunkManager->m_refCount.load(std::memory_order_relaxed));
     }
 }
 
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include <atomic>
+#include <span>
+#include <sys/uio.h>
 #include "zerocp_daemon/memory/include/chunk_manager.hpp"
 
 namespace ZeroCP
@@ -11,6 +13,7 @@ namespace Memory
 {
 
 class MemPoolManager;
+struct ChunkHeader;
 
 /// @brief SharedChunk - ChunkManager 的 RAII 包装器
 /// @details 管理 ChunkManager 的引用计数，类似于 shared_ptr 的语义
@@ -60,13 +63,28 @@ public:
     /// @brief 获取当前引用计数
     uint64_t useCount() const noexcept;
     
-    /// @brief 获取 chunk 数据的指针（通过 ChunkHeader）
-    void* getChunkheader() const noexcept;
+    /// @brief 获取 chunk 头的指针
+    ChunkHeader* getChunkheader() const noexcept;
     
     /// @brief 获取 chunk 的大小
     uint64_t getSize() const noexcept;
+    
+    /// @brief 获取用户数据的指针（位于 ChunkHeader 之后的偏移位置）
     void* getUserPayload() const noexcept;
     
+    /// @brief 获取用户头的指针（池配置了用户头时有效，否则返回 nullptr）
+    void* getUserHeader() const noexcept;
+    
+    /// @brief 是否为链式消息（见 MemPoolManager::getChunkChain）
+    bool isChained() const noexcept;
+    
+    /// @brief 以 iovec 列出各段用户数据（普通 chunk 只有一段）
+    /// @return 总段数（大于 segments.size() 时只填了前 segments.size() 段）
+    uint32_t getSegments(std::span<iovec> segments) const noexcept;
+    
+    /// @brief 链式消息所有段的用户数据总大小（普通 chunk 等于 getSize()）
+    uint64_t getTotalSize() const noexcept;
+    
     /// @brief 获取 ChunkManager 的索引（用于跨进程传输）
     /// @return ChunkManager 在 ChunkManagerPool 中的索引
     /// @note 这个索引可以安全地通过 IPC 传输到其他进程
@@ -74,15 +92,21 @@ public:
     
     /// @brief 准备跨进程传输：增加引用计数并返回索引
     /// @return ChunkManager 的索引，可以通过 IPC 传输
-    /// @note 调用此方法后，目标进程应该使用 fromIndex() 重建 SharedChunk
-    /// @warning 如果目标进程最终没有接收，会导致内存泄漏！
+    /// @note 调用此方法后，目标进程应该使用 fromIndex() 重建 SharedChunk。
+    ///       该引用在被接管前是在途引用，不记在任何进程的账本上：它应当已经放进接收队列，
+    ///       接收进程死亡时守护进程清空其队列（见 MemPoolManager::reclaimChunksOfProcess）
+    /// @warning 既没有入队也没有 cancelTransfer() 的引用会导致内存泄漏！
     uint32_t prepareForTransfer() noexcept;
     
+    /// @brief 撤销一次 prepareForTransfer()（目标没有接收时调用，例如接收队列已满）
+    /// @note 调用者自身仍持有一个引用，因此这里的减计数不会触发释放
+    void cancelTransfer() noexcept;
+    
     /// @brief 从索引重建 SharedChunk（接收端使用）
     /// @param index ChunkManager 的索引（从 prepareForTransfer 获取）
     /// @param memPoolManager MemPoolManager 实例
     /// @return 重建的 SharedChunk（不增加引用计数）
-    /// @note 假设发送端已经调用了 prepareForTransfer() 增加引用计数
+    /// @note 假设发送端已经调用了 prepareForTransfer() 增加引用计数；该引用记入本进程的账本
     static SharedChunk fromIndex(uint32_t index, MemPoolManager* memPoolManager) noexcept;
     
     /// @brief 释放当前持有的 ChunkManager（减少引用计数）
@@ -101,6 +125,9 @@ private:
 private:
     /// @brief 指向共享内存中的 ChunkManager
     ChunkManager* m_chunkManager{nullptr};
+    
+    /// @brief 用于释放资源的 MemPoolManager（进程本地指针）
+    MemPoolManager* m_memPoolManager{nullptr};
 };
 
 } // namespace Memory
@@ -0,0 +1,86 @@
+#ifndef ZEROCP_MPMCBOUNDEDQUEUE_HPP
+#define ZEROCP_MPMCBOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace ZeroCP
+{
+namespace Concurrent
+{
+
+/// @brief 有界多生产者多消费者无锁队列（MPMC Bounded Queue）
+/// @tparam T 元素类型（必须可平凡拷贝，保证可以直接放在共享内存中）
+/// @tparam Capacity 队列容量（必须是2的幂）
+/// @details 每个槽位带一个序列号（Vyukov 算法）：
+///   - 生产者通过 CAS 抢占写位置，写完数据后再发布序列号
+///   - 消费者只有看到已发布的序列号才会读取数据
+///   因此不会出现"先发布索引、后写数据"的竞争问题。
+/// @note 对象内部不含任何指针，所有状态都内联存储，
+///       可以直接 placement new 到共享内存中，被不同进程映射到不同地址后依然可用
+template<typename T, uint64_t Capacity>
+class MPMC_BoundedQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable to live in shared memory");
+    static_assert(Capacity >= 2U, "Capacity must be at least 2");
+    static_assert((Capacity & (Capacity - 1U)) == 0U, "Capacity must be a power of 2");
+
+public:
+    MPMC_BoundedQueue() noexcept;
+    ~MPMC_BoundedQueue() noexcept = default;
+
+    // 禁止拷贝和移动（对象位置固定在共享内存中）
+    MPMC_BoundedQueue(const MPMC_BoundedQueue&) = delete;
+    MPMC_BoundedQueue(MPMC_BoundedQueue&&) = delete;
+    MPMC_BoundedQueue& operator=(const MPMC_BoundedQueue&) = delete;
+    MPMC_BoundedQueue& operator=(MPMC_BoundedQueue&&) = delete;
+
+    /// @brief 尝试将元素推入队列
+    /// @param item 要推入的元素
+    /// @return 成功返回 true，队列满返回 false
+    bool tryPush(const T& item) noexcept;
+
+    /// @brief 尝试从队列中弹出元素
+    /// @param item 用于接收弹出元素的引用
+    /// @return 成功返回 true，队列空返回 false
+    bool tryPop(T& item) noexcept;
+
+    /// @brief 批量弹出元素：一次 CAS 认领一段连续的已发布槽位
+    /// @param items 用于接收元素的数组
+    /// @param maxCount 最多弹出的元素数量
+    /// @return 实际弹出的元素数量，队列空返回 0
+    /// @note 与逐个 tryPop 相比，读位置上的 CAS 由 N 次降为 1 次
+    uint64_t tryPopBatch(T* items, uint64_t maxCount) noexcept;
+
+    /// @brief 获取队列中的元素数量（并发下为近似值）
+    uint64_t size() const noexcept;
+
+    /// @brief 检查队列是否为空（并发下为近似值）
+    bool empty() const noexcept;
+
+    /// @brief 获取队列容量
+    static constexpr uint64_t capacity() noexcept { return Capacity; }
+
+private:
+    /// @brief 队列槽位：序列号 + 数据
+    struct Cell
+    {
+        std::atomic<uint64_t> m_sequence{0};
+        T m_data{};
+    };
+
+    static constexpr uint64_t INDEX_MASK = Capacity - 1U;
+
+    // 读写位置分别独占一个 cache line，避免生产者和消费者之间的伪共享
+    alignas(64) std::atomic<uint64_t> m_enqueuePosition{0};
+    alignas(64) std::atomic<uint64_t> m_dequeuePosition{0};
+    alignas(64) Cell m_cells[Capacity];
+};
+
+} // namespace Concurrent
+} // namespace ZeroCP
+
+#include "mpmcboundedqueue.inl"
+
+#endif // ZEROCP_MPMCBOUNDEDQUEUE_HPP
@@ -0,0 +1,166 @@
+// mpmcboundedqueue.inl - MPMC_BoundedQueue 模板类实现
+// 此文件由 mpmcboundedqueue.hpp 包含
+
+namespace ZeroCP
+{
+namespace Concurrent
+{
+
+// ========== 构造函数 ==========
+template<typename T, uint64_t Capacity>
+MPMC_BoundedQueue<T, Capacity>::MPMC_BoundedQueue() noexcept
+{
+    // 槽位 i 的初始序列号为 i，表示"第 i 次写入可以使用该槽位"
+    for (uint64_t i = 0; i < Capacity; ++i)
+    {
+        m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+// ========== tryPush 实现 ==========
+template<typename T, uint64_t Capacity>
+bool MPMC_BoundedQueue<T, Capacity>::tryPush(const T& item) noexcept
+{
+    uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Cell& cell = m_cells[position & INDEX_MASK];
+        const uint64_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+
+        if (diff == 0)
+        {
+            // 槽位空闲，尝试抢占写位置
+            if (m_enqueuePosition.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+            {
+                cell.m_data = item;
+                // 发布数据：序列号 = position + 1 表示该槽位可被读取
+                cell.m_sequence.store(position + 1U, std::memory_order_release);
+                return true;
+            }
+            // CAS 失败，position 已被更新为最新值，重试
+        }
+        else if (diff < 0)
+        {
+            // 槽位仍被上一轮的数据占用：队列满
+            return false;
+        }
+        else
+        {
+            // 其他生产者已经抢先，重新读取写位置
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// ========== tryPop 实现 ==========
+template<typename T, uint64_t Capacity>
+bool MPMC_BoundedQueue<T, Capacity>::tryPop(T& item) noexcept
+{
+    uint64_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Cell& cell = m_cells[position & INDEX_MASK];
+        const uint64_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1U);
+
+        if (diff == 0)
+        {
+            // 槽位已发布数据，尝试抢占读位置
+            if (m_dequeuePosition.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+            {
+                item = cell.m_data;
+                // 归还槽位：序列号推进一整圈，供下一轮写入使用
+                cell.m_sequence.store(position + Capacity, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // 槽位尚未写入：队列空
+            return false;
+        }
+        else
+        {
+            // 其他消费者已经抢先，重新读取读位置
+            position = m_dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// ========== tryPopBatch 实现 ==========
+template<typename T, uint64_t Capacity>
+uint64_t MPMC_BoundedQueue<T, Capacity>::tryPopBatch(T* items, uint64_t maxCount) noexcept
+{
+    if (items == nullptr || maxCount == 0U)
+    {
+        return 0U;
+    }
+    if (maxCount > Capacity)
+    {
+        maxCount = Capacity;
+    }
+
+    uint64_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        // 统计从 position 开始连续已发布的槽位数量
+        uint64_t count = 0U;
+        while (count < maxCount)
+        {
+            const uint64_t sequence = m_cells[(position + count) & INDEX_MASK].m_sequence.load(std::memory_order_acquire);
+            if (sequence != position + count + 1U)
+            {
+                break;
+            }
+            ++count;
+        }
+
+        if (count == 0U)
+        {
+            const uint64_t sequence = m_cells[position & INDEX_MASK].m_sequence.load(std::memory_order_acquire);
+            if (static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1U) < 0)
+            {
+                // 槽位尚未写入：队列空
+                return 0U;
+            }
+            // 其他消费者已经抢先，重新读取读位置
+            position = m_dequeuePosition.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // 一次 CAS 认领 [position, position + count)：认领后这些槽位只属于当前消费者
+        if (m_dequeuePosition.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+        {
+            for (uint64_t i = 0U; i < count; ++i)
+            {
+                Cell& cell = m_cells[(position + i) & INDEX_MASK];
+                items[i] = cell.m_data;
+                cell.m_sequence.store(position + i + Capacity, std::memory_order_release);
+            }
+            return count;
+        }
+        // CAS 失败，position 已被更新为最新值，重试
+    }
+}
+
+// ========== 状态查询 ==========
+template<typename T, uint64_t Capacity>
+uint64_t MPMC_BoundedQueue<T, Capacity>::size() const noexcept
+{
+    const uint64_t dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+    const uint64_t enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+    return (enqueuePosition > dequeuePosition) ? (enqueuePosition - dequeuePosition) : 0U;
+}
+
+template<typename T, uint64_t Capacity>
+bool MPMC_BoundedQueue<T, Capacity>::empty() const noexcept
+{
+    return size() == 0U;
+}
+
+} // namespace Concurrent
+} // namespace ZeroCP
@@ -7,7 +7,11 @@ namespace Concurrent
 {
 //静态链表
 // 多生产者多消费者无锁链表（MPMC Lock-Free List）
-class MPMC_LockFree_List
+// 空闲索引 = 回收栈（归还过的索引，LIFO 复用）+ 从未分配过的区间 [水位, 上限)。
+// 初始化只设置水位和上限，不写索引数组：启动开销与容量无关，索引数组的页在第一次归还时才被访问。
+// 出栈优先使用回收栈，栈空时再推进水位。
+// 每个链表独占一个 cache line：相邻链表（如 vector<MemPool> 中相邻的池）的栈顶互不失效。
+class alignas(64) MPMC_LockFree_List
 {
     using Index_t = uint32_t;
 public:
@@ -22,9 +26,14 @@ public:
     MPMC_LockFree_List(uint32_t* freeIndicesHeader, uint32_t capacity) noexcept;
     // 析构函数：无操作，noexcept保证异常安全
     ~MPMC_LockFree_List() noexcept = default;
-    // 初始化链表
+    // 初始化链表（O(1)，不写索引数组）
     void Initialize();
-    static uint64_t requiredIndexMemorySize(const uint32_t capacity) noexcept;
+    // 初始化链表，只让前 initialCount 个节点可用（其余节点稍后用 extend 加入）
+    void Initialize(uint32_t initialCount);
+    static constexpr uint64_t requiredIndexMemorySize(const uint32_t capacity) noexcept
+    {
+        return (static_cast<uint64_t>(capacity) + 1U) * sizeof(uint32_t);
+    }
     // 获取节点大小
     uint64_t getNodeSize() const noexcept;
 
@@ -32,10 +41,45 @@ public:
     bool push(const uint32_t nodeIndex) noexcept;
     // 出栈操作，将链表栈顶节点弹出
     bool pop(uint32_t& nodeIndex) noexcept;
+
+    // 批量入栈：先把 nodeIndices 串成一条链，再用一次 CAS 接到栈顶
+    bool pushBatch(const uint32_t* nodeIndices, uint32_t count) noexcept;
+    // 把上限之后的 count 个从未使用的节点变为可用（用于扩容，O(1)）
+    bool extend(uint32_t count) noexcept;
+    // 批量出栈：沿链表走最多 maxCount 个节点，再用一次 CAS 摘下整段，返回实际弹出的数量
+    uint32_t popBatch(uint32_t* nodeIndices, uint32_t maxCount) noexcept;
+    // 只从回收栈批量出栈（不取从未使用的节点），按栈顶到栈底的顺序输出
+    uint32_t popRecycledBatch(uint32_t* nodeIndices, uint32_t maxCount) noexcept;
+    // 摘下回收栈中栈顶 keepCount 个节点之后的整段尾部，按栈顶到栈底的顺序写入 nodeIndices
+    // （容量至少为 getCapacity()），返回摘下的数量。栈深不超过 keepCount 时返回 0。
+    // 一次 CAS 摘下整个栈，再一次 CAS 把栈顶部分放回：两次 CAS 之间回收栈暂时变短，其他操作不等待
+    uint32_t detachTail(uint32_t keepCount, uint32_t* nodeIndices) noexcept;
+
+    // 索引数组（本进程地址）。多个链表可以共用同一个索引数组，只要同一个索引同一时刻只在其中一个链表中
+    uint32_t* getIndexMemory() const noexcept { return m_freeIndicesHeader.get(); }
+    // 链表容量（共用索引数组的链表必须使用相同的容量）
+    uint32_t getCapacity() const noexcept { return m_capacity; }
+    // 水位：[0, 返回值) 内的索引至少被取出过一次，其余从未离开过链表
+    uint32_t getTouchedCount() const noexcept { return m_neverUsedIndex.load(std::memory_order_acquire); }
+    // 回收栈中的节点数：沿链表计数，计数前后栈顶（含 ABA 计数）不变才算一致，否则重试；
+    // O(栈深)，只用于监控，不在分配路径上调用
+    uint32_t getRecycledCount() const noexcept;
+
+    // 当前线程在所有链表上累计的 CAS 失败次数（进程本地，用于评估竞争程度）
+    // 内联读取：调用者可以在一次操作前后各读一次，把差值记到具体的链表/池上
+    static uint64_t casRetriesOfThisThread() noexcept { return s_casRetries; }
     
 private:
+    // 仅在 CAS 失败的路径上累加，不影响无竞争时的开销
+    static inline thread_local uint64_t s_casRetries{0};
+
+    // 从未使用的区间中取最多 maxCount 个连续索引，返回实际数量，首个索引写入 firstIndex
+    uint32_t takeNeverUsed(uint32_t maxCount, uint32_t& firstIndex) noexcept;
 
-    std::atomic<Node> m_headIndex; // 头节点索引（含ABA防护计数），使用原子类型以支持无锁并发
+    // 栈顶、水位和上限在同一个 cache line：一次出栈只访问这一行（加上索引数组）
+    std::atomic<Node> m_headIndex; // 回收栈头节点索引（含ABA防护计数），使用原子类型以支持无锁并发
+    std::atomic<uint32_t> m_neverUsedIndex{0}; // 水位：第一个从未分配过的索引
+    std::atomic<uint32_t> m_activeLimit{0};    // 可用索引上限（扩容时增大，不超过容量）
     uint32_t m_invalidNodeIndex{0}; // 无效节点索引标记
     ZeroCP::RelativePointer<uint32_t> m_freeIndicesHeader; // 空闲节点索引头指针（使用相对指针）
     uint32_t m_capacity{0}; // 链表容量
@@ -13,19 +13,61 @@ MPMC_LockFree_List::MPMC_LockFree_List(uint32_t* freeIndicesHeader, uint32_t cap
 {
 }
 
-// 初始化链表，将所有节点串成空闲链表，并设置无效节点索引
+// 初始化链表：所有节点都可用
 void MPMC_LockFree_List::Initialize()
+{
+    Initialize(m_capacity);
+}
+
+// 初始化链表：回收栈为空，前 initialCount 个节点处于“从未使用”区间，不写索引数组
+void MPMC_LockFree_List::Initialize(uint32_t initialCount)
 {
     m_invalidNodeIndex = m_capacity; // 无效节点索引，通常设置为容量（capacity）
-    uint32_t* header = m_freeIndicesHeader.get();  // 获取原生指针
-    for(uint32_t i = 0; i < m_capacity; ++i)
+    m_headIndex.store(Node{m_invalidNodeIndex, 1U}, std::memory_order_relaxed);
+    m_neverUsedIndex.store(0U, std::memory_order_relaxed);
+    m_activeLimit.store((initialCount < m_capacity) ? initialCount : m_capacity, std::memory_order_release);
+}
+
+// 扩大可用上限：新节点进入“从未使用”区间
+bool MPMC_LockFree_List::extend(uint32_t count) noexcept
+{
+    uint32_t limit = m_activeLimit.load(std::memory_order_relaxed);
+    do
     {
-        header[i] = i + 1; // 下一个节点索引
+        if(count > m_capacity - limit)
+        {
+            return false; // 超出容量
+        }
+    } while(!m_activeLimit.compare_exchange_weak(limit, limit + count,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    return true;
+}
+
+// 推进水位，取出一段从未使用过的连续索引
+uint32_t MPMC_LockFree_List::takeNeverUsed(uint32_t maxCount, uint32_t& firstIndex) noexcept
+{
+    uint32_t current = m_neverUsedIndex.load(std::memory_order_relaxed);
+    while(true)
+    {
+        const uint32_t limit = m_activeLimit.load(std::memory_order_acquire);
+        if(current >= limit)
+        {
+            return 0; // 从未使用的区间也已耗尽
+        }
+        const uint32_t count = (limit - current < maxCount) ? (limit - current) : maxCount;
+        if(m_neverUsedIndex.compare_exchange_weak(current, current + count,
+                                                  std::memory_order_relaxed,
+                                                  std::memory_order_relaxed))
+        {
+            firstIndex = current;
+            return count;
+        }
+        ++s_casRetries;
     }
-    header[m_capacity - 1] = m_invalidNodeIndex; // 最后一个节点指向无效索引
 }
 
-// 出栈操作，弹出链表头节点
+// 出栈操作：优先弹出回收栈栈顶，栈空时取一个从未使用的节点
 bool MPMC_LockFree_List::pop(uint32_t& nodeIndex) noexcept
 {
     Node headNode = m_headIndex.load(std::memory_order_acquire);
@@ -33,11 +75,11 @@ bool MPMC_LockFree_List::pop(uint32_t& nodeIndex) noexcept
     
     while(true)
     {
-        // 检查链表是否为空
-    if(headNode.nextNodeIndex == m_invalidNodeIndex)
-    {
-        return false; // 链表为空
-    }
+        // 回收栈为空
+        if(headNode.nextNodeIndex == m_invalidNodeIndex)
+        {
+            return takeNeverUsed(1U, nodeIndex) == 1U;
+        }
         
         // 获取下一个节点的索引
         uint32_t nextNodeIndex = header[headNode.nextNodeIndex];
@@ -50,9 +92,10 @@ bool MPMC_LockFree_List::pop(uint32_t& nodeIndex) noexcept
                                              std::memory_order_acquire))
         {
             nodeIndex = headNode.nextNodeIndex; // 返回弹出的节点索引
-        return true;
+            return true;
         }
         // CAS 失败，重新加载头节点继续尝试
+        ++s_casRetries;
     }
 }
 
@@ -83,12 +126,205 @@ bool MPMC_LockFree_List::push(const uint32_t nodeIndex) noexcept
             return true;
         }
         // CAS 失败，重新加载头节点继续尝试
+        ++s_casRetries;
+    }
+}
+
+// 批量入栈：nodeIndices[0] -> nodeIndices[1] -> ... -> nodeIndices[count-1] -> 原栈顶
+bool MPMC_LockFree_List::pushBatch(const uint32_t* nodeIndices, uint32_t count) noexcept
+{
+    if(nodeIndices == nullptr || count == 0)
+    {
+        return true;
+    }
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        if(nodeIndices[i] >= m_capacity)
+        {
+            return false; // 节点索引越界
+        }
+    }
+
+    uint32_t* header = m_freeIndicesHeader.get();  // 获取原生指针
+
+    // 链内部的链接在入栈前就已确定，只有尾节点需要随栈顶变化
+    for(uint32_t i = 0; i + 1 < count; ++i)
+    {
+        header[nodeIndices[i]] = nodeIndices[i + 1];
+    }
+    const uint32_t tailIndex = nodeIndices[count - 1];
+
+    Node headNode = m_headIndex.load(std::memory_order_acquire);
+    while(true)
+    {
+        header[tailIndex] = headNode.nextNodeIndex;
+
+        Node newHead{nodeIndices[0], headNode.abaCounts + 1};
+        if(m_headIndex.compare_exchange_weak(headNode, newHead,
+                                             std::memory_order_release,
+                                             std::memory_order_acquire))
+        {
+            return true;
+        }
+        ++s_casRetries;
     }
 }
 
-uint64_t MPMC_LockFree_List::requiredIndexMemorySize(const uint32_t capacity) noexcept
+// 批量出栈：回收栈为空时一次 CAS 从从未使用的区间取一段连续索引
+uint32_t MPMC_LockFree_List::popBatch(uint32_t* nodeIndices, uint32_t maxCount) noexcept
 {
-    return (capacity + 1) * sizeof(uint32_t);
+    const uint32_t count = popRecycledBatch(nodeIndices, maxCount);
+    if(count > 0 || nodeIndices == nullptr || maxCount == 0)
+    {
+        return count;
+    }
+
+    uint32_t firstIndex = 0;
+    const uint32_t neverUsedCount = takeNeverUsed(maxCount, firstIndex);
+    for(uint32_t i = 0; i < neverUsedCount; ++i)
+    {
+        nodeIndices[i] = firstIndex + i;
+    }
+    return neverUsedCount;
+}
+
+// 回收栈批量出栈：ABA 计数保证 CAS 成功时栈顶之后的这段链没有被其他线程改动过
+uint32_t MPMC_LockFree_List::popRecycledBatch(uint32_t* nodeIndices, uint32_t maxCount) noexcept
+{
+    if(nodeIndices == nullptr || maxCount == 0)
+    {
+        return 0;
+    }
+
+    Node headNode = m_headIndex.load(std::memory_order_acquire);
+    uint32_t* header = m_freeIndicesHeader.get();  // 获取原生指针
+
+    while(true)
+    {
+        uint32_t count = 0;
+        uint32_t current = headNode.nextNodeIndex;
+        while(count < maxCount && current < m_capacity)
+        {
+            nodeIndices[count++] = current;
+            current = header[current];
+        }
+
+        if(count == 0)
+        {
+            return 0; // 回收栈为空
+        }
+
+        Node newHead{current, headNode.abaCounts + 1};
+        if(m_headIndex.compare_exchange_weak(headNode, newHead,
+                                             std::memory_order_release,
+                                             std::memory_order_acquire))
+        {
+            return count;
+        }
+        ++s_casRetries;
+    }
+}
+
+uint32_t MPMC_LockFree_List::getRecycledCount() const noexcept
+{
+    constexpr uint32_t kMaxAttempts = 8U;
+    const uint32_t* header = m_freeIndicesHeader.get();
+    uint32_t count = 0;
+    for(uint32_t attempt = 0; attempt < kMaxAttempts; ++attempt)
+    {
+        const Node headNode = m_headIndex.load(std::memory_order_acquire);
+        count = 0;
+        uint32_t current = headNode.nextNodeIndex;
+        // 并发修改可能让遍历走到已出栈节点的旧链接上，按容量限制步数
+        while(current < m_capacity && count < m_capacity)
+        {
+            ++count;
+            current = header[current];
+        }
+        // 每次入栈/出栈都递增 ABA 计数：栈顶不变说明遍历期间链表没有被修改
+        const Node checkNode = m_headIndex.load(std::memory_order_acquire);
+        if(checkNode.nextNodeIndex == headNode.nextNodeIndex && checkNode.abaCounts == headNode.abaCounts)
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+// 摘下冷尾：先走到第 keepCount 个节点，再用一次带 ABA 计数的 CAS 把整个回收栈摘下；
+// 栈顶部分内部的链接保持不变，随后只需把最后一个热节点接到当前栈顶上，再用一次 CAS 放回。
+// 没有任何操作需要等待本线程：两次 CAS 之间并发的 pop 看到的只是回收栈暂时变短
+uint32_t MPMC_LockFree_List::detachTail(uint32_t keepCount, uint32_t* nodeIndices) noexcept
+{
+    if(nodeIndices == nullptr)
+    {
+        return 0;
+    }
+    if(keepCount == 0)
+    {
+        return popRecycledBatch(nodeIndices, m_capacity);
+    }
+
+    uint32_t* header = m_freeIndicesHeader.get();  // 获取原生指针
+    Node headNode = m_headIndex.load(std::memory_order_acquire);
+    while(true)
+    {
+        uint32_t lastKept = headNode.nextNodeIndex;
+        uint32_t tailIndex = m_invalidNodeIndex;
+        if(lastKept < m_capacity)
+        {
+            // 并发修改可能让遍历走到已出栈节点的旧链接上：步数受 keepCount 限制，CAS 时再校验
+            for(uint32_t depth = 1; depth < keepCount && header[lastKept] < m_capacity; ++depth)
+            {
+                lastKept = header[lastKept];
+            }
+            tailIndex = header[lastKept];
+        }
+
+        if(tailIndex >= m_capacity)
+        {
+            const Node checkNode = m_headIndex.load(std::memory_order_acquire);
+            if(checkNode.nextNodeIndex == headNode.nextNodeIndex && checkNode.abaCounts == headNode.abaCounts)
+            {
+                return 0; // 栈深不超过 keepCount，没有冷尾
+            }
+            headNode = checkNode;
+            continue;
+        }
+
+        // 每次修改都递增 ABA 计数：CAS 成功说明读取 headNode 之后走过的链接仍然有效，整个栈归本线程所有
+        if(!m_headIndex.compare_exchange_weak(headNode, Node{m_invalidNodeIndex, headNode.abaCounts + 1U},
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire))
+        {
+            ++s_casRetries;
+            continue;
+        }
+
+        // 把栈顶部分接回：期间其他线程可能已经压入新节点，把它们接在最后一个热节点之后
+        Node topNode = m_headIndex.load(std::memory_order_acquire);
+        while(true)
+        {
+            header[lastKept] = topNode.nextNodeIndex;
+            if(m_headIndex.compare_exchange_weak(topNode, Node{headNode.nextNodeIndex, topNode.abaCounts + 1U},
+                                                 std::memory_order_release,
+                                                 std::memory_order_acquire))
+            {
+                break;
+            }
+            ++s_casRetries;
+        }
+
+        // 摘下的尾部已不在栈中，只有本线程能访问
+        uint32_t count = 0;
+        uint32_t current = tailIndex;
+        while(current < m_capacity && count < m_capacity)
+        {
+            nodeIndices[count++] = current;
+            current = header[current];
+        }
+        return count;
+    }
 }
 
 uint64_t MPMC_LockFree_List::getNodeSize() const noexcept
@@ -7,42 +7,95 @@
 namespace ZeroCP
 {
 
+// ==================== PoolRegistry 实现 ====================
+
+// 常量初始化的静态对象：没有构造顺序问题，instance() 也不需要局部静态变量的初始化检查
+constinit inline PoolRegistry PoolRegistry::s_instance;
+
+inline PoolRegistry& PoolRegistry::instance() noexcept
+{
+    return s_instance;
+}
+
+inline bool PoolRegistry::registerPool(pool_id_t poolId, void* baseAddress) noexcept
+{
+    if (poolId >= NULL_POOL_ID)
+    {
+        ZEROCP_LOG(Error, "PoolRegistry: pool id " << poolId << " out of range [0, " << NULL_POOL_ID << ")");
+        return false;
+    }
+    m_baseAddresses[poolId].store(reinterpret_cast<std::uintptr_t>(baseAddress), std::memory_order_relaxed);
+    return true;
+}
+
+inline void PoolRegistry::unregisterPool(pool_id_t poolId, void* baseAddress) noexcept
+{
+    if (poolId >= NULL_POOL_ID)
+    {
+        return;
+    }
+    if (baseAddress == nullptr)
+    {
+        m_baseAddresses[poolId].store(0U, std::memory_order_relaxed);
+        return;
+    }
+    std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(baseAddress);
+    m_baseAddresses[poolId].compare_exchange_strong(expected, 0U, std::memory_order_relaxed);
+}
+
+inline void* PoolRegistry::getBaseAddress(pool_id_t poolId) const noexcept
+{
+    return (poolId < NULL_POOL_ID) ? reinterpret_cast<void*>(baseOf(poolId)) : nullptr;
+}
 
 // ==================== RelativePointer 实现 ====================
 template<typename T>
 RelativePointer<T>::RelativePointer(ptr_t baseAddress, ptr_t const ptr, uint64_t pool_id) noexcept
-    : m_pool_id(pool_id)
-    , m_offset(reinterpret_cast<offset_t>(ptr) - reinterpret_cast<offset_t>(baseAddress))
+    : m_pool_id((ptr == nullptr) ? PoolRegistry::NULL_POOL_ID : pool_id)
+    , m_offset((ptr == nullptr) ? 0U : reinterpret_cast<offset_t>(ptr) - reinterpret_cast<offset_t>(baseAddress))
 {
 }
 
 template<typename T>
 RelativePointer<T>::RelativePointer(ptr_t ptr, uint64_t pool_id) noexcept
-    : m_pool_id(pool_id)
-    , m_offset(reinterpret_cast<offset_t>(ptr))
+    : m_pool_id((ptr == nullptr) ? PoolRegistry::NULL_POOL_ID : pool_id)
+    , m_offset((ptr == nullptr) ? 0U : getOffset(pool_id, ptr))
 {
-    // 简化构造函数：假设 baseAddress 为 nullptr，直接存储绝对地址作为偏移量
-    // 这适用于管理区内存，其中所有进程都映射到相同的虚拟地址
+    // 池必须已在本进程注册，否则偏移相对于 0 计算，只在本进程有效
+    assert(ptr == nullptr || PoolRegistry::instance().getBaseAddress(pool_id) != nullptr);
 }
 
 template<typename T>
 RelativePointer<T>::RelativePointer(RelativePointer&& other) noexcept
-    : m_offset(other.m_offset)
-    , m_pool_id(other.m_pool_id)
+    : m_pool_id(other.m_pool_id)
+    , m_offset(other.m_offset)
 {
+    other.m_pool_id = PoolRegistry::NULL_POOL_ID;
     other.m_offset = 0;
-    other.m_pool_id = 0;
+}
+
+template<typename T>
+RelativePointer<T> RelativePointer<T>::fromOffset(offset_t offset, pool_id_t pool_id) noexcept
+{
+    RelativePointer pointer;
+    pointer.m_pool_id = pool_id;
+    pointer.m_offset = offset;
+    return pointer;
 }
 
 template<typename T>
 typename RelativePointer<T>::ptr_t RelativePointer<T>::get() const noexcept
 {
-    // 简化版本：直接将偏移量作为绝对地址返回
-    // 这适用于使用简化构造函数创建的 RelativePointer
-    return reinterpret_cast<ptr_t>(m_offset);
+    // 空指针的池ID槽位恒为 0 且偏移为 0，结果自然是 nullptr
+    return reinterpret_cast<ptr_t>(PoolRegistry::instance().baseOf(m_pool_id) + m_offset);
+}
+
+template<typename T>
+typename RelativePointer<T>::offset_t RelativePointer<T>::getOffset(const pool_id_t pool_id, ptr_t const ptr) noexcept
+{
+    return reinterpret_cast<offset_t>(ptr) - PoolRegistry::instance().baseOf(pool_id);
 }
 
 } // namespace ZeroCP
 
 #endif // ZEROCP_RELATIVE_POINTER_INL
-
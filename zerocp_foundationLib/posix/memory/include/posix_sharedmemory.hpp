@@ -20,6 +20,7 @@ enum class PosixSharedMemoryError : uint8_t
     INSUFFICIENT_PERMISSIONS,           // 权限不足
     DOES_EXIST,                         // 已存在
     INCOMPATIBLE_OPEN_AND_ACCESS_MODE,  // 打开模式和访问模式不兼容
+    HUGETLBFS_UNAVAILABLE,              // 指定目录不是 hugetlbfs 挂载点
     UNKNOWN_ERROR
 };
 
@@ -43,14 +44,25 @@ public:
     // 获取共享内存大小
     uint64_t getMemorySize() const noexcept;
 
+    /// @brief 获取底层对象的页大小（hugetlbfs 文件为大页大小，否则为系统页大小）
+    uint64_t getPageSize() const noexcept;
+
+    /// @brief 是否为 hugetlbfs 上的文件（而不是 /dev/shm 中的 POSIX 共享内存）
+    bool isHugetlbfsBacked() const noexcept;
+
     friend class PosixSharedMemoryBuilder;
     
 private:
-    PosixSharedMemory(const Name_t& name, const shm_handle_t handle, const bool hasOwnership) noexcept;
+    PosixSharedMemory(const Name_t& name, const shm_handle_t handle, const bool hasOwnership,
+                      const std::string& filePath) noexcept;
+    
+    /// @brief 删除底层对象：hugetlbfs 文件用 unlink，POSIX 共享内存用 shm_unlink
+    void unlinkBackingObject() noexcept;
     
     Name_t m_name;
     shm_handle_t m_handle{INVALID_HANDLE}; // 文件句柄
     bool m_hasOwnership{false}; // 是否拥有所有权
+    std::string m_filePath;     // hugetlbfs 文件路径（为空表示 POSIX 共享内存）
 };
 
 class PosixSharedMemoryBuilder
@@ -67,6 +79,9 @@ class PosixSharedMemoryBuilder
     ZeroCP_Builder_Implementation(OpenMode, openMode, OpenMode::OpenExisting);
     /// 共享内存的文件权限设置
     ZeroCP_Builder_Implementation(Perms, filePermissions, Perms::OwnerAll);
+    /// hugetlbfs 挂载目录（如 /dev/hugepages）；非空时在该目录下创建文件代替 shm_open，
+    /// 大小向上取整到大页大小
+    ZeroCP_Builder_Implementation(std::string, hugetlbfsDirectory, "");
 
 public:
     std::expected<PosixSharedMemory, PosixSharedMemoryError> create() noexcept;
@@ -26,6 +26,7 @@ enum class PosixSharedMemoryObjectError
     SHM_OPEN_FAILED,
     UNABLE_TO_VERIFY_MEMORY_SIZE,
     REQUESTED_SIZE_EXCEEDS_ACTUAL_SIZE,
+    HUGETLBFS_UNAVAILABLE,         // hugetlbfs 不可用（未挂载或大页不足）
     UNKNOWN_ERROR
 };
 
@@ -52,14 +53,25 @@ public:
     // 检查是否拥有共享内存的所有权
     bool hasOwnership() const noexcept;
     
+    /// @brief 获取映射使用的页大小（hugetlbfs 为大页大小，否则为系统页大小）
+    uint64_t getPageSize() const noexcept;
+    
+    /// @brief 是否由 hugetlbfs 上的显式大页提供
+    bool isHugetlbfsBacked() const noexcept;
+    
+    /// @brief 是否已通过 madvise(MADV_HUGEPAGE) 请求透明大页
+    bool isTransparentHugePagesAdvised() const noexcept;
+    
     friend class PosixSharedMemoryObjectBuilder;
 
 private:
     PosixSharedMemoryObject(Details::PosixSharedMemory&& sharedMemory,
-                           Details::PosixMemoryMap&& memoryMap) noexcept;
+                           Details::PosixMemoryMap&& memoryMap,
+                           bool transparentHugePagesAdvised) noexcept;
     
     Details::PosixSharedMemory m_sharedMemory;
     Details::PosixMemoryMap m_memoryMap;
+    bool m_transparentHugePagesAdvised{false};
 };
 
 /*
@@ -83,6 +95,10 @@ class PosixSharedMemoryObjectBuilder
     ZeroCP_Builder_Implementation(Perms, permissions, Perms::None);
     /// 内存映射的基地址提示
     ZeroCP_Builder_Implementation(std::optional<void*>, baseAddressHint, std::nullopt);
+    /// hugetlbfs 挂载目录；非空时由该目录下的文件提供显式大页
+    ZeroCP_Builder_Implementation(std::string, hugetlbfsDirectory, "");
+    /// 映射后对整个区域 madvise(MADV_HUGEPAGE)，请求透明大页（失败只记录日志）
+    ZeroCP_Builder_Implementation(bool, transparentHugePages, false);
 
 public:
     std::expected<PosixSharedMemoryObject, PosixSharedMemoryObjectError> create() noexcept;
@@ -1,9 +1,9 @@
 #ifndef ZEROCP_POOL_REGISTRY_HPP
 #define ZEROCP_POOL_REGISTRY_HPP
 
+#include <atomic>
 #include <cstdint>
-#include <unordered_map>
-#include <mutex>
+#include <type_traits>
 
 namespace ZeroCP
 {
@@ -11,14 +11,57 @@ namespace ZeroCP
 // 池ID类型定义
 using pool_id_t = std::uint64_t;
 
-// 特殊池ID常量
+// 特殊池ID常量（所有进程约定一致，跨进程的 RelativePointer 只能使用这些固定ID）
 constexpr pool_id_t MANAGEMENT_POOL_ID = 0;  // 管理区内存池ID
+constexpr pool_id_t CHUNK_POOL_ID = 1;       // 数据区（chunk 段）内存池ID
+constexpr pool_id_t FIRST_GROWTH_POOL_ID = 2; // 运行时扩容的 chunk 段从此ID开始，布局时按池顺序确定
 
 // 共享内存池注册表：存储每个pool_id对应的基地址
+/// @brief 进程本地的 池ID -> 本进程映射基地址 表
+/// @details 每个进程映射同一段共享内存的虚拟地址可以不同，RelativePointer 只保存
+///          (池ID, 偏移)，解引用时查本表得到本进程的基地址。
+///          表是定长数组：查找是一次带掩码的数组读取，没有分支也没有锁。
+///          各槽位是 relaxed 原子量，注册/注销可以与其他线程的查找并发进行。
 class PoolRegistry
 {
+public:
+    static constexpr pool_id_t MAX_POOLS = 64U;                    ///< 表容量（2 的幂）
+    static constexpr pool_id_t POOL_ID_MASK = MAX_POOLS - 1U;
+    static constexpr pool_id_t NULL_POOL_ID = MAX_POOLS - 1U;       ///< 空指针使用的池ID，永远不会注册
+    static constexpr pool_id_t FIRST_DYNAMIC_POOL_ID = 48U;         ///< [0, 48) 保留给固定ID（含扩容段），之后自动分配
+
+    /// @brief 获取注册表实例（进程本地）
+    static PoolRegistry& instance() noexcept;
+
+    /// @brief 注册池ID对应的本进程基地址
+    /// @return poolId 超出范围或为 NULL_POOL_ID 时返回 false
+    bool registerPool(pool_id_t poolId, void* baseAddress) noexcept;
+
+    /// @brief 取消注册
+    /// @param baseAddress 非空时只在当前注册的基地址与之相同时才取消（避免误删同ID的新映射）
+    void unregisterPool(pool_id_t poolId, void* baseAddress = nullptr) noexcept;
+
+    /// @brief 获取池在本进程中的基地址（未注册返回 nullptr）
+    void* getBaseAddress(pool_id_t poolId) const noexcept;
+
+    /// @brief 热路径使用的基地址查找：无分支，越界ID按掩码折回表内
+    std::uintptr_t baseOf(pool_id_t poolId) const noexcept
+    {
+        return m_baseAddresses[poolId & POOL_ID_MASK].load(std::memory_order_relaxed);
+    }
+
+private:
+    PoolRegistry() noexcept = default;
+
+    std::atomic<std::uintptr_t> m_baseAddresses[MAX_POOLS]{};
+
+    static PoolRegistry s_instance;
 };
 
+/// @brief 共享内存中的相对指针：存储 (池ID, 相对该池基地址的偏移)
+/// @details get() = 注册表[池ID] + 偏移，任意进程、任意映射地址下都得到本进程中的正确地址。
+///          空指针表示为 (NULL_POOL_ID, 0)，该槽位恒为 0，因此 get() 不需要判断空指针。
+/// @note 对象本身可以平凡拷贝，可以直接放在共享内存中
 template<typename T>
 class RelativePointer
 {
@@ -26,23 +69,36 @@ public:
         using ptr_t = T*;
         using offset_t = std::uint64_t;
 
+        /// @brief 默认构造为空指针
         RelativePointer() noexcept = default;
         ~RelativePointer() noexcept = default;
+        /// @brief 由显式基地址计算偏移（布局阶段池尚未注册时使用）
         RelativePointer(ptr_t baseAddress, ptr_t const ptr, uint64_t pool_id) noexcept;
-        RelativePointer(ptr_t ptr, uint64_t pool_id) noexcept;  // 简化构造函数，假设 baseAddress 为 nullptr
+        /// @brief 由已注册的池计算偏移；ptr 为 nullptr 时构造空指针
+        RelativePointer(ptr_t ptr, uint64_t pool_id) noexcept;
         RelativePointer(const RelativePointer& other) noexcept = default;
         RelativePointer(RelativePointer&& other) noexcept;
         RelativePointer& operator=(const RelativePointer& other) noexcept = default;
         RelativePointer& operator=(RelativePointer&& other) noexcept = default;
-        
-        /// @brief 获取原生指针（假设基地址为 nullptr，直接返回偏移量作为绝对地址）
+
+        /// @brief 由已知偏移构造（例如从共享内存中读出的偏移）
+        static RelativePointer fromOffset(offset_t offset, pool_id_t pool_id) noexcept;
+
+        /// @brief 获取本进程中的原生指针（一次数组读取 + 一次加法，无分支）
         ptr_t get() const noexcept;
-        
+
+        std::add_lvalue_reference_t<T> operator*() const noexcept { return *get(); }
+        ptr_t operator->() const noexcept { return get(); }
+        explicit operator bool() const noexcept { return m_pool_id != PoolRegistry::NULL_POOL_ID; }
+
+        pool_id_t get_pool_id() const noexcept { return m_pool_id; }
+        offset_t get_offset() const noexcept { return m_offset; }
+
         /// @brief 计算ptr对base的偏移
         static offset_t getOffset(const pool_id_t pool_id, ptr_t const ptr) noexcept;
-        
+
 private:
-    pool_id_t m_pool_id{0};
+    pool_id_t m_pool_id{PoolRegistry::NULL_POOL_ID};
     offset_t m_offset{0};
 };
 
@@ -51,4 +107,4 @@ private:
 
 #include "../deital/relative_pointer.inl"
 
-#endif
\ No newline at end of file
+#endif
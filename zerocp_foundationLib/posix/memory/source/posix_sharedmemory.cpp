@@ -3,6 +3,8 @@
 #include "logging.hpp"
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/vfs.h>
+#include <linux/magic.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <cstring>
@@ -61,6 +63,28 @@ std::string addLeadingSlash(const PosixSharedMemory::Name_t& name) noexcept
     return nameWithLeadingSlash;
 }
 
+// open 是变参函数，包一层固定签名以便交给 ZeroCp_PosixCall
+int openFile(const char* path, int oflag, mode_t mode) noexcept
+{
+    return open(path, oflag, mode);
+}
+
+// 打开底层对象：hugetlbfs 文件用 open，否则用 shm_open
+auto openBackingObject(const std::string& path, bool useHugetlbfs, int oflag, mode_t mode) noexcept
+{
+    return useHugetlbfs
+        ? ZeroCp_PosixCall(openFile)(path.c_str(), oflag, mode).failureReturnValue(-1).evaluate()
+        : ZeroCp_PosixCall(shm_open)(path.c_str(), oflag, mode).failureReturnValue(-1).evaluate();
+}
+
+// 删除底层对象：hugetlbfs 文件用 unlink，否则用 shm_unlink
+auto unlinkBackingObject(const std::string& path, bool useHugetlbfs) noexcept
+{
+    return useHugetlbfs
+        ? ZeroCp_PosixCall(unlink)(path.c_str()).failureReturnValue(-1).evaluate()
+        : ZeroCp_PosixCall(shm_unlink)(path.c_str()).failureReturnValue(-1).evaluate();
+}
+
 std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilder::create() noexcept
 {
     if (m_name.empty())
@@ -71,6 +95,22 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
     
     auto nameWithLeadingSlash = addLeadingSlash(m_name);
     ZEROCP_LOG(Info, "Creating shared memory with name: " << nameWithLeadingSlash << ", size: " << m_memorySize);
+
+    // hugetlbfs 模式：在挂载目录下创建同名文件，文件大小必须是大页大小的整数倍
+    const bool useHugetlbfs = !m_hugetlbfsDirectory.empty();
+    const std::string objectPath = useHugetlbfs ? (m_hugetlbfsDirectory + nameWithLeadingSlash) : nameWithLeadingSlash;
+    uint64_t memorySize = m_memorySize;
+    if (useHugetlbfs)
+    {
+        struct statfs fsInfo;
+        if (statfs(m_hugetlbfsDirectory.c_str(), &fsInfo) != 0 || fsInfo.f_type != HUGETLBFS_MAGIC)
+        {
+            ZEROCP_LOG(Warn, "\"" << m_hugetlbfsDirectory << "\" is not a hugetlbfs mount");
+            return std::unexpected(PosixSharedMemoryError::HUGETLBFS_UNAVAILABLE);
+        }
+        const uint64_t hugePageSize = static_cast<uint64_t>(fsInfo.f_bsize);
+        memorySize = (memorySize + hugePageSize - 1U) / hugePageSize * hugePageSize;
+    }
     bool hasOwnership = ((m_openMode == OpenMode::ExclusiveCreate) || (m_openMode == OpenMode::PurgeAndCreate)
                          || m_openMode == OpenMode::OpenOrCreate);
 
@@ -85,9 +125,7 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
     // 如果是 PurgeAndCreate 模式，先删除已存在的共享内存
     if (m_openMode == OpenMode::PurgeAndCreate)
     {
-        auto unlinkResult = ZeroCp_PosixCall(shm_unlink)(nameWithLeadingSlash.c_str())
-            .failureReturnValue(-1)
-            .evaluate();
+        auto unlinkResult = unlinkBackingObject(objectPath, useHugetlbfs);
         
         // 忽略删除失败的错误，因为可能共享内存不存在
         if (!unlinkResult.has_value() && unlinkResult.error().errnum != ENOENT)
@@ -99,14 +137,13 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
     shm_handle_t sharedMemoryFileHandle = PosixSharedMemory::INVALID_HANDLE;
     
     // 尝试打开或创建共享内存对象
-    auto result = ZeroCp_PosixCall(shm_open)(
-        nameWithLeadingSlash.c_str(),
+    auto result = openBackingObject(
+        objectPath,
+        useHugetlbfs,
         convertToOflags(m_accessMode,
                         // 如果是OpenOrCreate模式，先尝试独占创建
                         (m_openMode == OpenMode::OpenOrCreate) ? OpenMode::ExclusiveCreate : m_openMode),
-        to_mode(m_filePermissions))
-        .failureReturnValue(PosixSharedMemory::INVALID_HANDLE)
-        .evaluate();
+        to_mode(m_filePermissions));
     
     if (!result.has_value())
     {
@@ -114,11 +151,10 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
         if (m_openMode == OpenMode::OpenOrCreate && result.error().errnum == EEXIST)
         {
             hasOwnership = false;  // 文件已存在，我们不拥有所有权
-            auto retryResult = ZeroCp_PosixCall(shm_open)(nameWithLeadingSlash.c_str(),
-                                                          convertToOflags(m_accessMode, OpenMode::OpenExisting),
-                                                          to_mode(m_filePermissions))
-                                 .failureReturnValue(PosixSharedMemory::INVALID_HANDLE)
-                                 .evaluate();
+            auto retryResult = openBackingObject(objectPath,
+                                                 useHugetlbfs,
+                                                 convertToOflags(m_accessMode, OpenMode::OpenExisting),
+                                                 to_mode(m_filePermissions));
             
             if (retryResult.has_value())
             {
@@ -157,7 +193,7 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
     if (hasOwnership)
     {
         // 使用ftruncate设置共享内存对象的大小
-        auto ftruncateResult = ZeroCp_PosixCall(ftruncate)(sharedMemoryFileHandle, static_cast<off_t>(m_memorySize))
+        auto ftruncateResult = ZeroCp_PosixCall(ftruncate)(sharedMemoryFileHandle, static_cast<off_t>(memorySize))
                                   .failureReturnValue(-1)
                                   .evaluate();
         
@@ -178,9 +214,7 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
             }
 
             // 删除已创建的共享内存对象
-            auto unlinkResult = ZeroCp_PosixCall(shm_unlink)(nameWithLeadingSlash.c_str())
-                .failureReturnValue(-1)
-                .evaluate();
+            auto unlinkResult = unlinkBackingObject(objectPath, useHugetlbfs);
             
             if (!unlinkResult.has_value())
             {
@@ -193,7 +227,8 @@ std::expected<PosixSharedMemory, PosixSharedMemoryError> PosixSharedMemoryBuilde
     }
     
     // 创建共享内存对象
-    return std::expected<PosixSharedMemory, PosixSharedMemoryError>(PosixSharedMemory(m_name, sharedMemoryFileHandle, hasOwnership));
+    return std::expected<PosixSharedMemory, PosixSharedMemoryError>(PosixSharedMemory(m_name, sharedMemoryFileHandle, hasOwnership,
+                                                                                      useHugetlbfs ? objectPath : std::string()));
 }
 
 
@@ -212,6 +247,35 @@ uint64_t PosixSharedMemory::getMemorySize() const noexcept
     return 0;
 }
 
+uint64_t PosixSharedMemory::getPageSize() const noexcept
+{
+    if (!m_filePath.empty())
+    {
+        struct statfs fsInfo;
+        if (fstatfs(m_handle, &fsInfo) == 0)
+        {
+            return static_cast<uint64_t>(fsInfo.f_bsize);
+        }
+        ZEROCP_LOG(Error, "fstatfs failed for handle " << m_handle << ": " << strerror(errno));
+    }
+    return static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+bool PosixSharedMemory::isHugetlbfsBacked() const noexcept
+{
+    return !m_filePath.empty();
+}
+
+void PosixSharedMemory::unlinkBackingObject() noexcept
+{
+    const bool useHugetlbfs = !m_filePath.empty();
+    auto unlinkResult = Details::unlinkBackingObject(useHugetlbfs ? m_filePath : addLeadingSlash(m_name), useHugetlbfs);
+    if (!unlinkResult.has_value())
+    {
+        ZEROCP_LOG(Error, "Failed to unlink shared memory: " << strerror(unlinkResult.error().errnum));
+    }
+}
+
 shm_handle_t PosixSharedMemory::getHandle() const
 {
     return m_handle;
@@ -238,25 +302,19 @@ PosixSharedMemory::~PosixSharedMemory()
         // 如果拥有所有权，需要删除共享内存对象
         if (m_hasOwnership && !m_name.empty())
         {
-            auto nameWithSlash = addLeadingSlash(m_name);
-            auto unlinkResult = ZeroCp_PosixCall(shm_unlink)(nameWithSlash.c_str())
-                .failureReturnValue(-1)
-                .evaluate();
-            
-            if (!unlinkResult.has_value())
-            {
-                ZEROCP_LOG(Error, "Failed to unlink shared memory: " << strerror(unlinkResult.error().errnum));
-            }
+            unlinkBackingObject();
         }
     }
 }
 
 PosixSharedMemory::PosixSharedMemory(const Name_t& name, 
     const shm_handle_t handle, 
-    const bool hasOwnership) noexcept
+    const bool hasOwnership,
+    const std::string& filePath) noexcept
 : m_name{name}          // 共享内存名称
 , m_handle{handle}      // 文件句柄
 , m_hasOwnership{hasOwnership}  // 是否拥有所有权
+, m_filePath{filePath}  // hugetlbfs 文件路径
 {
 }
 
@@ -264,6 +322,7 @@ PosixSharedMemory::PosixSharedMemory(PosixSharedMemory&& other) noexcept
 : m_name{std::move(other.m_name)}
 , m_handle{other.m_handle}
 , m_hasOwnership{other.m_hasOwnership}
+, m_filePath{std::move(other.m_filePath)}
 {
     // 将源对象的句柄设置为无效，避免重复关闭
     other.m_handle = INVALID_HANDLE;
@@ -281,8 +340,7 @@ PosixSharedMemory& PosixSharedMemory::operator=(PosixSharedMemory&& other) noexc
             
             if (m_hasOwnership && !m_name.empty())
             {
-                auto nameWithSlash = addLeadingSlash(m_name);
-                shm_unlink(nameWithSlash.c_str());
+                unlinkBackingObject();
             }
         }
         
@@ -290,6 +348,7 @@ PosixSharedMemory& PosixSharedMemory::operator=(PosixSharedMemory&& other) noexc
         m_name = std::move(other.m_name);
         m_handle = other.m_handle;
         m_hasOwnership = other.m_hasOwnership;
+        m_filePath = std::move(other.m_filePath);
         
         // 将源对象的句柄设置为无效
         other.m_handle = INVALID_HANDLE;
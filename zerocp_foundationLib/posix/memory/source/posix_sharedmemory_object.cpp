@@ -1,5 +1,7 @@
 #include "posix_sharedmemory_object.hpp"
+#include "posix_call.hpp"
 #include "logging.hpp"
+#include <cstring>
 
 // 用户代码
 //    │
@@ -50,10 +52,15 @@ std::expected<PosixSharedMemoryObject, PosixSharedMemoryObjectError> PosixShared
                             .accessMode(m_accessMode)
                             .openMode(m_openMode)
                             .filePermissions(m_permissions)
+                            .hugetlbfsDirectory(m_hugetlbfsDirectory)
                             .create();
     
     if (!SharedMemory)
     {
+        if (SharedMemory.error() == PosixSharedMemoryError::HUGETLBFS_UNAVAILABLE)
+        {
+            return std::unexpected(PosixSharedMemoryObjectError::HUGETLBFS_UNAVAILABLE);
+        }
         ZEROCP_LOG(Error, "Failed to create shared memory object");
         return std::unexpected(PosixSharedMemoryObjectError::UNKNOWN_ERROR);
     }
@@ -88,17 +95,35 @@ std::expected<PosixSharedMemoryObject, PosixSharedMemoryObjectError> PosixShared
     if (!memoryMap)
     {
         ZEROCP_LOG(Error, "Failed to create memory map");
-        return std::unexpected(PosixSharedMemoryObjectError::UNKNOWN_ERROR);
+        // hugetlbfs 在 mmap 时预留大页，大页不足表现为映射失败
+        return std::unexpected(SharedMemory->isHugetlbfsBacked() ? PosixSharedMemoryObjectError::HUGETLBFS_UNAVAILABLE
+                                                                 : PosixSharedMemoryObjectError::UNKNOWN_ERROR);
+    }
+    
+    // 透明大页只是建议：内核未开启 shmem THP 时 madvise 失败或不生效，都不影响映射本身
+    bool transparentHugePagesAdvised = false;
+    if (m_transparentHugePages && !SharedMemory->isHugetlbfsBacked())
+    {
+        auto adviseResult = ZeroCp_PosixCall(madvise)(memoryMap->getBaseAddress(), static_cast<size_t>(realSize), MADV_HUGEPAGE)
+                                .failureReturnValue(-1)
+                                .evaluate();
+        transparentHugePagesAdvised = adviseResult.has_value();
+        if (!transparentHugePagesAdvised)
+        {
+            ZEROCP_LOG(Warn, "madvise(MADV_HUGEPAGE) failed: " << strerror(adviseResult.error().errnum));
+        }
     }
     
     return std::expected<PosixSharedMemoryObject, PosixSharedMemoryObjectError>(
-        PosixSharedMemoryObject(std::move(*SharedMemory), std::move(*memoryMap)));
+        PosixSharedMemoryObject(std::move(*SharedMemory), std::move(*memoryMap), transparentHugePagesAdvised));
 }
 
 PosixSharedMemoryObject::PosixSharedMemoryObject(Details::PosixSharedMemory&& sharedMemory,
-    Details::PosixMemoryMap&& memoryMap) noexcept
+    Details::PosixMemoryMap&& memoryMap,
+    bool transparentHugePagesAdvised) noexcept
 : m_sharedMemory(std::move(sharedMemory))
 , m_memoryMap(std::move(memoryMap))
+, m_transparentHugePagesAdvised(transparentHugePagesAdvised)
 {
 }
 
@@ -126,6 +151,24 @@ bool PosixSharedMemoryObject::hasOwnership() const noexcept
     return m_sharedMemory.hasOwnership();
 }
 
+// 获取映射使用的页大小
+uint64_t PosixSharedMemoryObject::getPageSize() const noexcept
+{
+    return m_sharedMemory.getPageSize();
+}
+
+// 是否由 hugetlbfs 显式大页提供
+bool PosixSharedMemoryObject::isHugetlbfsBacked() const noexcept
+{
+    return m_sharedMemory.isHugetlbfsBacked();
+}
+
+// 是否已请求透明大页
+bool PosixSharedMemoryObject::isTransparentHugePagesAdvised() const noexcept
+{
+    return m_transparentHugePagesAdvised;
+}
+
 } // namespace Details
 } // namespace ZeroCP
 
@@ -205,6 +205,17 @@ inline bool string<Capacity>::empty() const noexcept
     return m_strSize == 0U;
 }
 
+template<uint64_t Capacity>
+template<uint64_t N>
+inline bool string<Capacity>::operator==(const string<N>& rhs) const noexcept
+{
+    if (m_strSize != rhs.size())
+    {
+        return false;
+    }
+    return std::memcmp(m_string, rhs.c_str(), static_cast<size_t>(m_strSize)) == 0;
+}
+
 template<uint64_t Capacity>
 inline void string<Capacity>::clear() noexcept
 {
@@ -41,6 +41,10 @@ public:
     
     bool empty() const noexcept;
 
+    // 比较两个固定容量字符串的内容（容量可以不同）
+    template<uint64_t N>
+    bool operator==(const string<N>& rhs) const noexcept;
+
     void clear() noexcept;
 private:
 